@@ -0,0 +1,232 @@
+/// @file chip8_bench.cpp
+/// @brief microbenchmarks for the hot paths of the Chip8 class
+/// @author Abhay Manoj
+/// @date Oct 14 2026
+
+#include "core/chip8.hpp"
+#include "core/chip8_batch.hpp"
+#include <benchmark/benchmark.h>
+#include <cstdint>
+#include <fstream>
+#include <initializer_list>
+#include <memory>
+#include <string>
+#include <vector>
+
+using Memory = std::array<uint8_t, Chip8::MEMORY_SIZE>;
+
+static constexpr uint64_t CYCLES_PER_ITERATION = 1000;
+static constexpr uint64_t FRAMES_PER_ITERATION = 60;
+static constexpr uint16_t LOOP = Chip8::START + 0x10; // loops start here
+static constexpr int LOOP_REPEATS = 7; // copies of the op in one loop
+
+/// @brief writes instructions into memory
+/// @param memory the memory to write to
+/// @param address the address of the first instruction
+/// @param instructions the instructions to write
+/// @return the address after the last instruction
+static uint16_t write(Memory &memory, uint16_t address,
+                      std::initializer_list<uint16_t> instructions) {
+  for (uint16_t instruction : instructions) {
+    memory[address++] = instruction >> 8;
+    memory[address++] = instruction & 0xFF;
+  }
+  return address;
+}
+
+/// @brief builds a program that sets up registers, then loops over copies of
+/// one instruction
+/// @param setup the instructions run once before the loop
+/// @param op the instruction to repeat
+/// @return the memory holding the program
+static std::unique_ptr<Memory> make_loop(std::initializer_list<uint16_t> setup,
+                                         uint16_t op) {
+  auto memory = std::make_unique<Memory>();
+  uint16_t address = write(*memory, Chip8::START, setup);
+  write(*memory, address, {static_cast<uint16_t>(0x1000 | LOOP)});
+
+  address = LOOP;
+  for (int i = 0; i < LOOP_REPEATS; i++) {
+    address = write(*memory, address, {op});
+  }
+  write(*memory, address, {static_cast<uint16_t>(0x1000 | LOOP)});
+  return memory;
+}
+
+/// @brief reports the executed cycles as instructions/sec and time per cycle
+/// @param state the benchmark state
+/// @param cpu the machine that ran
+static void report(benchmark::State &state, const Chip8 &cpu) {
+  state.SetItemsProcessed(cpu.get_cycle_count());
+  state.counters["time_per_cycle"] = benchmark::Counter(
+      cpu.get_cycle_count(),
+      benchmark::Counter::kIsRate | benchmark::Counter::kInvert);
+}
+
+/// @brief runs a program for a fixed number of cycles per iteration
+/// @param state the benchmark state, range 0 is the engine
+/// @param memory the program to run
+static void run_program(benchmark::State &state, const Memory &memory) {
+  Chip8 cpu(memory);
+  cpu.set_engine(static_cast<Chip8::Engine>(state.range(0)));
+  cpu.set_idle_skipping(false); // most loops would be skipped otherwise
+  for (auto _ : state) {
+    cpu.run(CYCLES_PER_ITERATION);
+  }
+  benchmark::DoNotOptimize(cpu.get_registers());
+  report(state, cpu);
+}
+
+/// @brief benchmarks an opcode family
+/// @param state the benchmark state, range 0 is the engine
+/// @param setup the instructions run once before the loop
+/// @param op the instruction to repeat
+static void BM_Opcode(benchmark::State &state,
+                      std::initializer_list<uint16_t> setup, uint16_t op) {
+  run_program(state, *make_loop(setup, op));
+}
+
+// runs a benchmark once per Chip8::Engine
+#define ENGINES ->Arg(0)->Arg(1)->Arg(2)
+
+BENCHMARK_CAPTURE(BM_Opcode, load_byte, {}, 0x6012) ENGINES;
+BENCHMARK_CAPTURE(BM_Opcode, add_byte, {}, 0x7001) ENGINES;
+BENCHMARK_CAPTURE(BM_Opcode, load_register, {0x6112}, 0x8010) ENGINES;
+BENCHMARK_CAPTURE(BM_Opcode, bitwise_xor, {0x6112}, 0x8013) ENGINES;
+BENCHMARK_CAPTURE(BM_Opcode, add_carry, {0x61F3}, 0x8014) ENGINES;
+BENCHMARK_CAPTURE(BM_Opcode, subtract, {0x6103}, 0x8015) ENGINES;
+BENCHMARK_CAPTURE(BM_Opcode, shift_right, {0x60AD}, 0x8006) ENGINES;
+BENCHMARK_CAPTURE(BM_Opcode, skip_not_taken, {0x6001}, 0x3000) ENGINES;
+BENCHMARK_CAPTURE(BM_Opcode, load_I, {}, 0xA300) ENGINES;
+BENCHMARK_CAPTURE(BM_Opcode, add_I, {0xA300, 0x6000}, 0xF01E) ENGINES;
+BENCHMARK_CAPTURE(BM_Opcode, rand, {}, 0xC0FF) ENGINES;
+BENCHMARK_CAPTURE(BM_Opcode, skip_if_pressed, {}, 0xE09E) ENGINES;
+BENCHMARK_CAPTURE(BM_Opcode, delay_timer, {}, 0xF007) ENGINES;
+BENCHMARK_CAPTURE(BM_Opcode, load_sprite, {0x6007}, 0xF029) ENGINES;
+BENCHMARK_CAPTURE(BM_Opcode, bcd, {0xAF00, 0x60FF}, 0xF033) ENGINES;
+BENCHMARK_CAPTURE(BM_Opcode, store_registers, {0xAF00}, 0xF755) ENGINES;
+BENCHMARK_CAPTURE(BM_Opcode, load_registers, {0xAF00}, 0xF765) ENGINES;
+
+/// @brief benchmarks a call and return pair
+/// @param state the benchmark state, range 0 is the engine
+static void BM_CallReturn(benchmark::State &state) {
+  auto memory = std::make_unique<Memory>();
+  write(*memory, Chip8::START, {0x2300, 0x1200});
+  write(*memory, 0x300, {0x00EE});
+  run_program(state, *memory);
+}
+BENCHMARK(BM_CallReturn) ENGINES;
+
+/// @brief benchmarks DXYN at a position and height
+/// @param state the benchmark state, ranges are the height, x and y
+static void BM_Draw(benchmark::State &state) {
+  uint16_t height = state.range(0);
+  uint16_t x = state.range(1);
+  uint16_t y = state.range(2);
+
+  auto memory = std::make_unique<Memory>();
+  write(*memory, Chip8::START,
+        {static_cast<uint16_t>(0x6000 | x), static_cast<uint16_t>(0x6100 | y),
+         0xA000, static_cast<uint16_t>(0xD010 | height), 0x1206});
+
+  Chip8 cpu(*memory);
+  for (auto _ : state) {
+    cpu.run(CYCLES_PER_ITERATION);
+  }
+  benchmark::DoNotOptimize(cpu.get_display_rows());
+  report(state, cpu);
+}
+BENCHMARK(BM_Draw)
+    ->ArgNames({"height", "x", "y"})
+    ->ArgsProduct({{1, 5, 15}, {0, 60}, {0, 28}});
+
+/// @brief reads a bundled rom into a memory image
+/// @param name the file name of the rom in the roms directory
+/// @return the memory image, nullptr if the rom could not be read
+static std::unique_ptr<Memory> load_rom(const char *name) {
+  std::ifstream file(std::string(CHIP8_ROM_DIR) + "/" + name,
+                     std::ios::binary);
+  if (!file) {
+    return nullptr;
+  }
+  auto memory = std::make_unique<Memory>();
+  file.read(reinterpret_cast<char *>(memory->data() + Chip8::START),
+            memory->size() - Chip8::START);
+  return memory;
+}
+
+/// @brief runs a bundled rom for whole frames
+/// @param state the benchmark state, range 0 is the engine
+/// @param name the file name of the rom in the roms directory
+static void BM_Rom(benchmark::State &state, const char *name) {
+  auto memory = load_rom(name);
+  if (!memory) {
+    state.SkipWithError("could not open rom");
+    return;
+  }
+
+  Chip8 cpu(*memory);
+  cpu.set_engine(static_cast<Chip8::Engine>(state.range(0)));
+  for (auto _ : state) {
+    cpu.run_frames(FRAMES_PER_ITERATION);
+  }
+  benchmark::DoNotOptimize(cpu.get_display_rows());
+  report(state, cpu);
+}
+
+BENCHMARK_CAPTURE(BM_Rom, ibm, "ibm.ch8") ENGINES;
+BENCHMARK_CAPTURE(BM_Rom, breakout, "breakout.ch8") ENGINES;
+BENCHMARK_CAPTURE(BM_Rom, flight_runner, "flight-runner.ch8") ENGINES;
+BENCHMARK_CAPTURE(BM_Rom, pong, "pong.ch8") ENGINES;
+BENCHMARK_CAPTURE(BM_Rom, tetris, "tetris.ch8") ENGINES;
+
+/// @brief runs many copies of a rom as separate Chip8 instances, the
+/// baseline for BM_RomBatch
+/// @param state the benchmark state, range 0 is the number of copies
+/// @param name the file name of the rom in the roms directory
+static void BM_RomSeparate(benchmark::State &state, const char *name) {
+  auto memory = load_rom(name);
+  if (!memory) {
+    state.SkipWithError("could not open rom");
+    return;
+  }
+
+  std::vector<Chip8> machines(state.range(0), Chip8(*memory));
+  for (size_t i = 0; i < machines.size(); i++) {
+    machines[i].set_seed(i);
+  }
+  for (auto _ : state) {
+    for (Chip8 &cpu : machines) {
+      cpu.run_frames(FRAMES_PER_ITERATION);
+    }
+  }
+  state.SetItemsProcessed(machines.size() * machines[0].get_cycle_count());
+}
+
+/// @brief runs many copies of a rom in one Chip8Batch
+/// @param state the benchmark state, range 0 is the number of lanes
+/// @param name the file name of the rom in the roms directory
+static void BM_RomBatch(benchmark::State &state, const char *name) {
+  auto memory = load_rom(name);
+  if (!memory) {
+    state.SkipWithError("could not open rom");
+    return;
+  }
+
+  Chip8Batch batch(state.range(0), *memory);
+  for (size_t i = 0; i < batch.size(); i++) {
+    batch.set_seed(i, i);
+  }
+  for (auto _ : state) {
+    batch.run_frames(FRAMES_PER_ITERATION);
+  }
+  state.SetItemsProcessed(batch.size() * batch.get_cycle_count());
+}
+
+// copies of one rom run side by side
+#define LANES ->Arg(16)->Arg(256)
+
+BENCHMARK_CAPTURE(BM_RomSeparate, breakout, "breakout.ch8") LANES;
+BENCHMARK_CAPTURE(BM_RomBatch, breakout, "breakout.ch8") LANES;
+BENCHMARK_CAPTURE(BM_RomSeparate, tetris, "tetris.ch8") LANES;
+BENCHMARK_CAPTURE(BM_RomBatch, tetris, "tetris.ch8") LANES;
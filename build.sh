@@ -1,13 +1,9 @@
 #!/bin/bash
+# builds the web frontend into web/ with one of the wasm presets:
+# release (the default, -O3), size (-Oz) or debug (-O0)
 
-mkdir -p web
+set -e
+profile=${1:-release}
 
-emcc src/main.cpp src/core/chip8.cpp \
-  -Isrc/core \
-  -o web/index.js \
-  -sUSE_SDL=3 \
-  --embed-file roms/ \
-  -sALLOW_MEMORY_GROWTH=1 \
-  -std=c++20 \
-  -O0 \
-  -DSDL_MAIN_USE_CALLBACKS=1
+cmake --preset "wasm-$profile"
+cmake --build --preset "wasm-$profile"
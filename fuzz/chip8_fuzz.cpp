@@ -0,0 +1,73 @@
+/// @file chip8_fuzz.cpp
+/// @brief differential fuzz target, runs made up programs through every
+/// execution engine and stops on the first disagreement
+/// @author Abhay Manoj
+/// @date Oct 14 2026
+
+#include "core/engine_check.hpp"
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <span>
+
+/// @brief runs one input, the first byte picks the quirks and the rest is
+/// decoded by parse_check_case. aborts on a mismatch so the fuzzer keeps
+/// the input
+/// @param data the input
+/// @param size the bytes of input
+/// @return 0, inputs are never rejected
+extern "C" int LLVMFuzzerTestOneInput(const uint8_t *data, size_t size) {
+  if (size == 0) {
+    return 0;
+  }
+  EngineCheckCase test = parse_check_case(std::span(data + 1, size - 1));
+  EngineMismatch mismatch;
+  bool matched = true;
+  switch (data[0] % 5) {
+  case 0:
+    matched = check_engines<DefaultQuirks>(test, mismatch);
+    break;
+  case 1:
+    matched = check_engines<CosmacVipQuirks>(test, mismatch);
+    break;
+  case 2:
+    matched = check_engines<Chip48Quirks>(test, mismatch);
+    break;
+  case 3:
+    matched = check_engines<SuperChipQuirks>(test, mismatch);
+    break;
+  default:
+    matched = check_engines<XoChipQuirks>(test, mismatch);
+    break;
+  }
+
+  if (!matched) {
+    std::fprintf(stderr, "%s differs from the interpreter in %s after step %u\n",
+                 mismatch.engine.c_str(), mismatch.field.c_str(),
+                 mismatch.step);
+    std::abort();
+  }
+  return 0;
+}
+
+#ifndef CHIP8_LIBFUZZER
+/// @brief runs every file given, or stdin without any, for AFL and for
+/// replaying crashes without libFuzzer
+int main(int argc, char **argv) {
+  static uint8_t input[1 << 17];
+  for (int i = 1; i < argc || i == 1; i++) {
+    std::FILE *file = argc > 1 ? std::fopen(argv[i], "rb") : stdin;
+    if (!file) {
+      std::fprintf(stderr, "could not open %s\n", argv[i]);
+      return 1;
+    }
+    size_t size = std::fread(input, 1, sizeof(input), file);
+    if (file != stdin) {
+      std::fclose(file);
+    }
+    LLVMFuzzerTestOneInput(input, size);
+  }
+  return 0;
+}
+#endif
@@ -0,0 +1,240 @@
+/// @file chip8_c.cpp
+/// @brief implementation of the C interface in chip8_c.h
+/// @author Abhay Manoj
+/// @date Oct 14 2026
+#include "chip8_c.h"
+#include "core/chip8.hpp"
+#include "core/quirks.hpp"
+#include "core/thread_pool.hpp"
+#include <algorithm>
+#include <cstring>
+#include <span>
+#include <type_traits>
+#include <variant>
+#include <vector>
+
+struct chip8_machine {
+  template <typename Machine>
+  explicit chip8_machine(std::in_place_type_t<Machine> type) : cpu(type) {}
+
+  std::variant<BasicChip8<DefaultQuirks>, BasicChip8<CosmacVipQuirks>,
+               BasicChip8<Chip48Quirks>, BasicChip8<SuperChipQuirks>,
+               BasicChip8<XoChipQuirks>>
+      cpu;
+  std::vector<uint8_t> framebuffer; // the last chip8_framebuffer
+};
+
+struct chip8_pool {
+  ThreadPool threads;
+};
+
+/// @brief checks that a snapshot holds values the machine relies on, so a
+/// damaged one can't index past its arrays
+/// @param state the state
+/// @return true if it can be restored
+static bool valid_state(const Chip8Context &state) {
+  return state.SP <= Chip8Context::STACK_SIZE &&
+         state.target_register < Chip8Context::REGISTER_COUNT &&
+         state.fault <= static_cast<uint8_t>(Chip8Fault::STACK_UNDERFLOW) &&
+         state.dirty_rows.end <= Chip8Context::HIRES_HEIGHT &&
+         state.rng_state != 0;
+}
+
+extern "C" {
+
+uint32_t chip8_api_version(void) { return CHIP8_C_API_VERSION; }
+
+chip8_machine *chip8_create(int quirks) {
+  switch (quirks) {
+  case CHIP8_QUIRKS_DEFAULT:
+    return new chip8_machine(std::in_place_type<BasicChip8<DefaultQuirks>>);
+  case CHIP8_QUIRKS_VIP:
+    return new chip8_machine(
+        std::in_place_type<BasicChip8<CosmacVipQuirks>>);
+  case CHIP8_QUIRKS_CHIP48:
+    return new chip8_machine(std::in_place_type<BasicChip8<Chip48Quirks>>);
+  case CHIP8_QUIRKS_SCHIP:
+    return new chip8_machine(
+        std::in_place_type<BasicChip8<SuperChipQuirks>>);
+  case CHIP8_QUIRKS_XOCHIP:
+    return new chip8_machine(std::in_place_type<BasicChip8<XoChipQuirks>>);
+  default:
+    return nullptr;
+  }
+}
+
+void chip8_destroy(chip8_machine *machine) { delete machine; }
+
+bool chip8_load(chip8_machine *machine, const uint8_t *rom, size_t size) {
+  return std::visit(
+      [&](auto &cpu) {
+        using Machine = std::decay_t<decltype(cpu)>;
+        if (size > Machine::MEMORY_SIZE - Machine::START) {
+          return false;
+        }
+        cpu.reset();
+        cpu.load_memory_image(
+            Machine::make_memory_image(std::span(rom, size)));
+        return true;
+      },
+      machine->cpu);
+}
+
+void chip8_reset(chip8_machine *machine) {
+  std::visit([](auto &cpu) { cpu.reset(); }, machine->cpu);
+}
+
+bool chip8_set_engine(chip8_machine *machine, int engine) {
+  if (engine < CHIP8_ENGINE_INTERPRETER || engine > CHIP8_ENGINE_RECOMPILER) {
+    return false;
+  }
+  std::visit(
+      [&](auto &cpu) { cpu.set_engine(static_cast<Chip8Engine>(engine)); },
+      machine->cpu);
+  return true;
+}
+
+void chip8_set_seed(chip8_machine *machine, uint64_t seed) {
+  std::visit([&](auto &cpu) { cpu.set_seed(seed); }, machine->cpu);
+}
+
+void chip8_set_instruction_rate(chip8_machine *machine, uint32_t rate) {
+  std::visit([&](auto &cpu) { cpu.set_instruction_rate(rate); },
+             machine->cpu);
+}
+
+void chip8_set_key(chip8_machine *machine, uint8_t key, bool pressed) {
+  std::visit([&](auto &cpu) { cpu.set_keypad(key & 0xF, pressed); },
+             machine->cpu);
+}
+
+void chip8_step_cycles(chip8_machine *machine, uint64_t cycles) {
+  std::visit([&](auto &cpu) { cpu.run(cycles); }, machine->cpu);
+}
+
+void chip8_step_frames(chip8_machine *machine, uint64_t frames) {
+  std::visit([&](auto &cpu) { cpu.run_frames(frames); }, machine->cpu);
+}
+
+chip8_pool *chip8_pool_create(size_t threads) {
+  return new chip8_pool{ThreadPool(threads)};
+}
+
+void chip8_pool_destroy(chip8_pool *pool) { delete pool; }
+
+void chip8_step_many(chip8_pool *pool, chip8_machine *const *machines,
+                     size_t count, uint64_t frames) {
+  if (pool == nullptr || count < 2) {
+    for (size_t i = 0; i < count; i++) {
+      chip8_step_frames(machines[i], frames);
+    }
+    return;
+  }
+
+  // one contiguous run of machines a thread, a task per machine would cost
+  // more to queue than a frame costs to run
+  size_t tasks = std::min(count, pool->threads.size());
+  for (size_t task = 0; task < tasks; task++) {
+    size_t first = count * task / tasks;
+    size_t end = count * (task + 1) / tasks;
+    pool->threads.submit([machines, first, end, frames] {
+      for (size_t i = first; i < end; i++) {
+        chip8_step_frames(machines[i], frames);
+      }
+    });
+  }
+  pool->threads.wait();
+}
+
+const uint8_t *chip8_framebuffer(chip8_machine *machine, int *width,
+                                 int *height) {
+  std::visit(
+      [&](auto &cpu) {
+        // kept across calls, so only a larger resolution allocates
+        machine->framebuffer.resize(cpu.get_display_width() *
+                                    cpu.get_display_height());
+        cpu.get_display_buffer(machine->framebuffer);
+        if (width) {
+          *width = cpu.get_display_width();
+        }
+        if (height) {
+          *height = cpu.get_display_height();
+        }
+      },
+      machine->cpu);
+  return machine->framebuffer.data();
+}
+
+const uint64_t *chip8_display_rows(const chip8_machine *machine, int plane) {
+  if (plane < 0 || plane >= Chip8Context::PLANE_COUNT) {
+    return nullptr;
+  }
+  return std::visit(
+      [&](const auto &cpu) { return cpu.get_display_rows(plane).data(); },
+      machine->cpu);
+}
+
+uint64_t chip8_display_generation(const chip8_machine *machine) {
+  return std::visit(
+      [](const auto &cpu) { return cpu.get_display_generation(); },
+      machine->cpu);
+}
+
+uint64_t chip8_cycle_count(const chip8_machine *machine) {
+  return std::visit([](const auto &cpu) { return cpu.get_cycle_count(); },
+                    machine->cpu);
+}
+
+int chip8_fault(const chip8_machine *machine) {
+  return std::visit(
+      [](const auto &cpu) { return static_cast<int>(cpu.get_fault()); },
+      machine->cpu);
+}
+
+const uint8_t *chip8_registers(const chip8_machine *machine) {
+  return std::visit(
+      [](const auto &cpu) { return cpu.get_registers().data(); },
+      machine->cpu);
+}
+
+size_t chip8_snapshot_size(const chip8_machine *machine) {
+  return std::visit(
+      [](const auto &cpu) {
+        return sizeof(typename std::decay_t<decltype(cpu)>::Snapshot);
+      },
+      machine->cpu);
+}
+
+bool chip8_snapshot(const chip8_machine *machine, void *buffer, size_t size) {
+  return std::visit(
+      [&](const auto &cpu) {
+        using Snapshot = typename std::decay_t<decltype(cpu)>::Snapshot;
+        if (size < sizeof(Snapshot)) {
+          return false;
+        }
+        // through a copy, the buffer need not be aligned
+        Snapshot snapshot = cpu.snapshot();
+        std::memcpy(buffer, &snapshot, sizeof(snapshot));
+        return true;
+      },
+      machine->cpu);
+}
+
+bool chip8_restore(chip8_machine *machine, const void *buffer, size_t size) {
+  return std::visit(
+      [&](auto &cpu) {
+        using Snapshot = typename std::decay_t<decltype(cpu)>::Snapshot;
+        if (size != sizeof(Snapshot)) {
+          return false;
+        }
+        Snapshot snapshot;
+        std::memcpy(&snapshot, buffer, sizeof(snapshot));
+        if (!valid_state(snapshot)) {
+          return false;
+        }
+        cpu.restore(snapshot);
+        return true;
+      },
+      machine->cpu);
+}
+}
@@ -0,0 +1,201 @@
+/// @file chip8_c.h
+/// @brief C interface to the emulator core for hosting it from other
+/// languages, built as the shared library chip8_c
+/// @author Abhay Manoj
+/// @date Oct 14 2026
+#pragma once
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#if defined(_WIN32) && defined(CHIP8_C_BUILD)
+#define CHIP8_API __declspec(dllexport)
+#elif defined(_WIN32)
+#define CHIP8_API __declspec(dllimport)
+#else
+#define CHIP8_API __attribute__((visibility("default")))
+#endif
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// bumped when a function changes, added functions keep the version
+#define CHIP8_C_API_VERSION 1
+
+/// @brief a machine, only ever used through a pointer
+typedef struct chip8_machine chip8_machine;
+
+/// @brief a pool of worker threads for chip8_step_many
+typedef struct chip8_pool chip8_pool;
+
+/// @brief the quirk profiles a machine can follow
+enum chip8_quirks {
+  CHIP8_QUIRKS_DEFAULT = 0,
+  CHIP8_QUIRKS_VIP = 1,
+  CHIP8_QUIRKS_CHIP48 = 2,
+  CHIP8_QUIRKS_SCHIP = 3,
+  CHIP8_QUIRKS_XOCHIP = 4,
+};
+
+/// @brief the execution engines, they give the same results at different
+/// speeds
+enum chip8_engine {
+  CHIP8_ENGINE_INTERPRETER = 0,
+  CHIP8_ENGINE_DECODE_CACHE = 1,
+  CHIP8_ENGINE_RECOMPILER = 2,
+};
+
+/// @brief the ways a program can stop the machine
+enum chip8_fault {
+  CHIP8_FAULT_NONE = 0,
+  CHIP8_FAULT_STACK_OVERFLOW = 1,
+  CHIP8_FAULT_STACK_UNDERFLOW = 2,
+};
+
+/// @brief returns the version of the library, to check against
+/// CHIP8_C_API_VERSION
+/// @return the version
+CHIP8_API uint32_t chip8_api_version(void);
+
+/// @brief creates a machine holding no program
+/// @param quirks a chip8_quirks
+/// @return the machine, NULL for an unknown profile
+CHIP8_API chip8_machine *chip8_create(int quirks);
+
+/// @brief destroys a machine, NULL is ignored
+/// @param machine the machine
+CHIP8_API void chip8_destroy(chip8_machine *machine);
+
+/// @brief resets the machine and loads a program at 0x200, the seed,
+/// instruction rate and engine are kept
+/// @param machine the machine
+/// @param rom the program
+/// @param size the bytes of the program
+/// @return false if it does not fit in memory
+CHIP8_API bool chip8_load(chip8_machine *machine, const uint8_t *rom,
+                          size_t size);
+
+/// @brief resets the machine to the start of its program
+/// @param machine the machine
+CHIP8_API void chip8_reset(chip8_machine *machine);
+
+/// @brief picks the execution engine
+/// @param machine the machine
+/// @param engine a chip8_engine
+/// @return false for an unknown engine
+CHIP8_API bool chip8_set_engine(chip8_machine *machine, int engine);
+
+/// @brief reseeds the random number generator, and on every reset after
+/// @param machine the machine
+/// @param seed the seed
+CHIP8_API void chip8_set_seed(chip8_machine *machine, uint64_t seed);
+
+/// @brief sets the instructions executed in an emulated second
+/// @param machine the machine
+/// @param rate the instructions a second
+CHIP8_API void chip8_set_instruction_rate(chip8_machine *machine,
+                                          uint32_t rate);
+
+/// @brief presses or releases a key
+/// @param machine the machine
+/// @param key the key, 0 - F
+/// @param pressed true if the key is down
+CHIP8_API void chip8_set_key(chip8_machine *machine, uint8_t key,
+                             bool pressed);
+
+/// @brief executes instructions, ticking the timers as emulated time passes
+/// @param machine the machine
+/// @param cycles the instructions to execute
+CHIP8_API void chip8_step_cycles(chip8_machine *machine, uint64_t cycles);
+
+/// @brief runs whole frames of 1/60 of an emulated second
+/// @param machine the machine
+/// @param frames the frames to run
+CHIP8_API void chip8_step_frames(chip8_machine *machine, uint64_t frames);
+
+/// @brief creates worker threads for chip8_step_many
+/// @param threads the number of threads, 0 for one per core
+/// @return the pool
+CHIP8_API chip8_pool *chip8_pool_create(size_t threads);
+
+/// @brief waits for the pool's work and stops its threads, NULL is ignored
+/// @param pool the pool
+CHIP8_API void chip8_pool_destroy(chip8_pool *pool);
+
+/// @brief runs the same number of frames on many machines in one call. with
+/// a pool the machines are split across its threads, else they run in turn
+/// on the calling thread. returns once every machine is done
+/// @param pool the threads to run on, may be NULL
+/// @param machines the machines, each listed once
+/// @param count the number of machines
+/// @param frames the frames each machine runs
+CHIP8_API void chip8_step_many(chip8_pool *pool,
+                               chip8_machine *const *machines, size_t count,
+                               uint64_t frames);
+
+/// @brief returns the display as one byte a pixel, bit n set where plane n
+/// is lit, row by row
+/// @param machine the machine
+/// @param width filled with the width of the display, may be NULL
+/// @param height filled with the height of the display, may be NULL
+/// @return the pixels, valid until the next call on the machine
+CHIP8_API const uint8_t *chip8_framebuffer(chip8_machine *machine,
+                                           int *width, int *height);
+
+/// @brief returns the display rows of a plane in place, 64 pixels a word
+/// with the leftmost in the top bit and 2 words a row in high resolution
+/// @param machine the machine
+/// @param plane the plane, 0 or 1
+/// @return the rows, valid until the machine runs again
+CHIP8_API const uint64_t *chip8_display_rows(const chip8_machine *machine,
+                                             int plane);
+
+/// @brief returns how many times the display was drawn to, it changes only
+/// when the display may have
+/// @param machine the machine
+/// @return the count
+CHIP8_API uint64_t chip8_display_generation(const chip8_machine *machine);
+
+/// @brief returns the instructions executed since reset
+/// @param machine the machine
+/// @return the count
+CHIP8_API uint64_t chip8_cycle_count(const chip8_machine *machine);
+
+/// @brief returns the fault the program stopped on
+/// @param machine the machine
+/// @return a chip8_fault
+CHIP8_API int chip8_fault(const chip8_machine *machine);
+
+/// @brief returns V0 - VF in place
+/// @param machine the machine
+/// @return the 16 registers
+CHIP8_API const uint8_t *chip8_registers(const chip8_machine *machine);
+
+/// @brief returns the size of a snapshot of the machine
+/// @param machine the machine
+/// @return the bytes chip8_snapshot writes
+CHIP8_API size_t chip8_snapshot_size(const chip8_machine *machine);
+
+/// @brief copies the whole state of the machine out. the bytes only restore
+/// into a machine of the same profile and library version
+/// @param machine the machine
+/// @param buffer the buffer to write to
+/// @param size the size of buffer
+/// @return false if buffer is smaller than chip8_snapshot_size
+CHIP8_API bool chip8_snapshot(const chip8_machine *machine, void *buffer,
+                              size_t size);
+
+/// @brief restores a state written by chip8_snapshot
+/// @param machine the machine
+/// @param buffer the snapshot
+/// @param size the size of the snapshot
+/// @return false, leaving the machine untouched, if the size is wrong or the
+/// state is not one a machine can be in
+CHIP8_API bool chip8_restore(chip8_machine *machine, const void *buffer,
+                             size_t size);
+
+#ifdef __cplusplus
+}
+#endif
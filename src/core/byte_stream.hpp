@@ -0,0 +1,37 @@
+/// @file byte_stream.hpp
+/// @brief little endian integer helpers for the binary file formats
+/// @author Abhay Manoj
+/// @date Oct 14 2026
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <istream>
+#include <ostream>
+
+/// @brief writes an unsigned value as little endian bytes
+/// @param out the stream to write to
+/// @param value the value to write
+/// @param size the number of bytes to write
+inline void put_le(std::ostream &out, uint64_t value, size_t size) {
+  for (size_t i = 0; i < size; i++) {
+    out.put(static_cast<char>(value >> (8 * i)));
+  }
+}
+
+/// @brief reads an unsigned little endian value
+/// @param in the stream to read from
+/// @param size the number of bytes to read
+/// @param value filled with the value
+/// @return true if every byte was read
+inline bool get_le(std::istream &in, size_t size, uint64_t &value) {
+  value = 0;
+  for (size_t i = 0; i < size; i++) {
+    int byte = in.get();
+    if (byte == std::char_traits<char>::eof()) {
+      return false;
+    }
+    value |= static_cast<uint64_t>(byte) << (8 * i);
+  }
+  return true;
+}
@@ -1,50 +1,621 @@
 /// @file chip8.hpp
-/// @brief implementation of the Chip8 class
+/// @brief implementation of the BasicChip8 class template
 /// @author Abhay Manoj
 /// @date Feb 21 2026
 #include "chip8.hpp"
+#include "rom_analysis.hpp"
+#include "tone_generator.hpp"
 #include <algorithm>
-#include <cassert>
+#include <bit>
 #include <cstdint>
-#include <random>
+#include <cstdlib>
+#include <utility>
+
+static constexpr uint64_t NANOSECONDS_PER_SECOND = 1'000'000'000;
+
+/// @brief spreads a seed over the whole generator state, splitmix64
+/// @param seed the seed
+/// @return a non zero xorshift64* state
+static uint64_t mix_seed(uint64_t seed) {
+  uint64_t z = seed + 0x9E3779B97F4A7C15ull;
+  z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ull;
+  z = (z ^ (z >> 27)) * 0x94D049BB133111EBull;
+  z ^= z >> 31;
+  return z != 0 ? z : 1;
+}
+
+/// @brief returns the image of a machine without a program, shared by every
+/// machine of the same type after reset
+/// @tparam Machine the type of the machine
+/// @return the image holding only the font data
+template <typename Machine>
+static const std::shared_ptr<const typename Machine::MemoryImage> &
+font_image() {
+  static const std::shared_ptr<const typename Machine::MemoryImage> image =
+      Machine::make_memory_image();
+  return image;
+}
 
-/// @brief generates a random uint8_t, 0 - 255.
-/// @return the randomly generated uint8
-static uint8_t generate_random_uint8() {
-  static std::random_device rd;
-  static std::mt19937 gen(rd());
-  std::uniform_int_distribution<> dist(0, 0xFF);
-  return dist(gen);
+/// @brief xors sprite rows onto display rows
+/// @param display the first display row to draw to
+/// @param sprite the first sprite row to draw
+/// @param count the number of rows
+/// @return the pixels that were on in both, non zero on a collision
+static uint64_t xor_rows(uint64_t *display, const uint64_t *sprite,
+                         uint8_t count) {
+  // plain loop over contiguous rows so the compiler can vectorize it
+  uint64_t collision = 0;
+  for (uint8_t i = 0; i < count; i++) {
+    collision |= display[i] & sprite[i];
+    display[i] ^= sprite[i];
+  }
+  return collision;
 }
 
-Chip8::Chip8() { reset(); }
+const char *fault_name(Chip8Fault fault) {
+  switch (fault) {
+  case Chip8Fault::STACK_OVERFLOW:
+    return "stack_overflow";
+  case Chip8Fault::STACK_UNDERFLOW:
+    return "stack_underflow";
+  default:
+    return "none";
+  }
+}
 
-Chip8::Chip8(const std::array<uint8_t, MEMORY_SIZE> &memory) {
+template <Chip8Quirks Quirks>
+BasicChip8<Quirks>::BasicChip8() { reset(); }
+
+template <Chip8Quirks Quirks>
+BasicChip8<Quirks>::BasicChip8(const std::array<uint8_t, MEMORY_SIZE> &memory) {
   reset();
   load_into_memory(memory);
-  load_font_data();
 }
 
-void Chip8::load_into_memory(const std::array<uint8_t, MEMORY_SIZE> &memory) {
-  std::copy(memory.begin(), memory.end() - START, this->memory.begin() + START);
+template <Chip8Quirks Quirks>
+BasicChip8<Quirks>::BasicChip8(std::shared_ptr<const MemoryImage> image) {
+  reset();
+  load_memory_image(std::move(image));
 }
 
-void Chip8::cycle() {
+template <Chip8Quirks Quirks>
+std::shared_ptr<typename BasicChip8<Quirks>::MemoryImage>
+BasicChip8<Quirks>::make_memory_image() {
+  auto image = std::make_shared<MemoryImage>();
+  load_font_data(*image);
+  return image;
+}
+
+template <Chip8Quirks Quirks>
+std::shared_ptr<typename BasicChip8<Quirks>::MemoryImage>
+BasicChip8<Quirks>::make_memory_image(std::span<const uint8_t> program) {
+  auto image = make_memory_image();
+  size_t size = std::min<size_t>(program.size(), MEMORY_SIZE - START);
+  std::copy_n(program.begin(), size, image->begin() + START);
+  return image;
+}
+
+template <Chip8Quirks Quirks>
+void BasicChip8<Quirks>::load_into_memory(
+    const std::array<uint8_t, MEMORY_SIZE> &memory) {
+  // a private image, only machines sharing one image avoid the copy
+  auto image = std::make_shared<MemoryImage>();
+  this->memory.copy_to(*image);
+  std::copy(memory.begin() + START, memory.end(), image->begin() + START);
+  load_memory_image(std::move(image));
+}
+
+template <Chip8Quirks Quirks>
+void BasicChip8<Quirks>::load_memory_image(
+    std::shared_ptr<const MemoryImage> image) {
+  memory = Memory(std::move(image));
+  invalidate_translations(0, MEMORY_SIZE);
+  prepare_translations();
+}
+
+template <Chip8Quirks Quirks>
+size_t BasicChip8<Quirks>::get_private_memory() const {
+  return memory.get_private_pages() * Memory::PAGE_SIZE;
+}
+
+template <Chip8Quirks Quirks>
+void BasicChip8<Quirks>::cycle() {
+  cycle_count++;
   if (waiting_for_input) {
-    auto pressed_it = std::ranges::find(keypad, true);
-    if (pressed_it != keypad.end()) {
-      V[target_register] = static_cast<uint8_t>(
-          std::ranges::distance(keypad.begin(), pressed_it));
-      waiting_for_input = false;
+    check_key_press();
+    return;
+  }
+
+  switch (engine) {
+  case Engine::INTERPRETER: {
+    profile_instruction();
+    uint16_t instruction = fetch();
+    PC += 2;
+    decode_and_execute(instruction);
+    break;
+  }
+  case Engine::DECODE_CACHE:
+    profile_instruction();
+    execute_cached();
+    break;
+  case Engine::RECOMPILER:
+    execute_block(1);
+    report_pending_buzzer();
+    break;
+  }
+}
+
+template <Chip8Quirks Quirks>
+void BasicChip8<Quirks>::run(uint64_t cycles) {
+  cycles -= skip_idle(cycles);
+  if (engine != Engine::RECOMPILER) {
+    for (uint64_t i = 0; i < cycles; i++) {
+      cycle();
+      if (waiting_for_input) {
+        i += skip_idle(cycles - i - 1);
+      }
     }
+    return;
   }
 
-  uint16_t instruction = fetch();
-  PC += 2;
-  decode_and_execute(instruction);
+  while (cycles > 0) {
+    uint64_t executed = 1;
+    if (waiting_for_input) {
+      check_key_press();
+    } else {
+      executed = execute_block(cycles);
+    }
+    cycles -= executed;
+    cycle_count += executed;
+    report_pending_buzzer();
+    if (waiting_for_input) {
+      cycles -= skip_idle(cycles);
+    }
+  }
 }
 
-void Chip8::load_font_data() {
+template <Chip8Quirks Quirks>
+uint8_t BasicChip8<Quirks>::loop_length(uint16_t target, uint16_t address,
+                                        int depth) const {
+  if (depth == 0 || address >= MEMORY_SIZE - 1) {
+    return 0;
+  }
+
+  uint16_t next = address + 2;
+  bool skips = false;
+  Instruction instruction =
+      decode(memory.read_word(address), Quirks::INSTRUCTIONS);
+  switch (instruction.op) {
+  case Op::JUMP:
+    next = instruction.nnn;
+    break;
+  case Op::EXIT:
+    next = address;
+    break;
+  case Op::LOAD_FROM_BYTE:
+  case Op::LOAD_FROM_REGISTER_TO_REGISTER:
+  case Op::LOAD_I:
+  case Op::LOAD_FROM_DELAY_TIMER:
+    break;
+  case Op::SKIP_NEXT_IF_EQUAL_BYTE:
+  case Op::SKIP_NEXT_IF_NOT_EQUAL_BYTE:
+  case Op::SKIP_NEXT_IF_EQUAL_REGISTERS:
+  case Op::SKIP_NEXT_IF_NOT_EQUAL_REGISTERS:
+  case Op::SKIP_IF_PRESSED:
+  case Op::SKIP_IF_NOT_PRESSED:
+    skips = true;
+    break;
+  default:
+    return 0;
+  }
+
+  uint8_t shortest = 0;
+  uint16_t skipped = next + instruction_length(next);
+  for (uint16_t choice : {next, skipped}) {
+    uint8_t length =
+        choice == target ? 1 : loop_length(target, choice, depth - 1);
+    if (length != 0 && choice != target) {
+      length++;
+    }
+    if (length != 0 && (shortest == 0 || length < shortest)) {
+      shortest = length;
+    }
+    if (!skips) {
+      break;
+    }
+  }
+  return shortest;
+}
+
+template <Chip8Quirks Quirks>
+bool BasicChip8<Quirks>::run_idle_iteration(IdleIteration &iteration) const {
+  std::array<uint8_t, REGISTER_COUNT> &v = iteration.V;
+  uint16_t address = PC;
+  iteration.length = 0;
+
+  do {
+    if (iteration.length == MAX_IDLE_LOOP || address >= MEMORY_SIZE - 1) {
+      return false;
+    }
+    iteration.addresses[iteration.length++] = address;
+    Instruction instruction =
+        decode(memory.read_word(address), Quirks::INSTRUCTIONS);
+    address += 2;
+
+    bool skip;
+    switch (instruction.op) {
+    case Op::JUMP:
+      address = instruction.nnn;
+      continue;
+    case Op::EXIT:
+      address -= 2;
+      continue;
+    case Op::LOAD_FROM_BYTE:
+      v[instruction.x] = instruction.nn;
+      continue;
+    case Op::LOAD_FROM_REGISTER_TO_REGISTER:
+      v[instruction.x] = v[instruction.y];
+      continue;
+    case Op::LOAD_I:
+      iteration.I = instruction.nnn;
+      continue;
+    case Op::LOAD_FROM_DELAY_TIMER:
+      v[instruction.x] = DT;
+      continue;
+    case Op::SKIP_NEXT_IF_EQUAL_BYTE:
+      skip = v[instruction.x] == instruction.nn;
+      break;
+    case Op::SKIP_NEXT_IF_NOT_EQUAL_BYTE:
+      skip = v[instruction.x] != instruction.nn;
+      break;
+    case Op::SKIP_NEXT_IF_EQUAL_REGISTERS:
+      skip = v[instruction.x] == v[instruction.y];
+      break;
+    case Op::SKIP_NEXT_IF_NOT_EQUAL_REGISTERS:
+      skip = v[instruction.x] != v[instruction.y];
+      break;
+    case Op::SKIP_IF_PRESSED:
+    case Op::SKIP_IF_NOT_PRESSED:
+      skip = keypad[v[instruction.x] & 0xF] ==
+             (instruction.op == Op::SKIP_IF_PRESSED);
+      break;
+    default: // anything else may change what the next pass does
+      return false;
+    }
+    address += skip ? instruction_length(address) : 0;
+  } while (address != PC);
+  return true;
+}
+
+template <Chip8Quirks Quirks>
+uint64_t BasicChip8<Quirks>::skip_idle(uint64_t cycles) {
+  if (!idle_skipping || cycles == 0) {
+    return 0;
+  }
+
+  // a faulted machine repeats the instruction it stopped on without effect
+  if (fault) {
+    cycle_count += cycles;
+    idle_cycles += cycles;
+    return cycles;
+  }
+
+  // the keypad can't change during a run, so neither can the wait
+  if (waiting_for_input) {
+    if (key_edge || std::ranges::find(keypad, true) != keypad.end()) {
+      return 0;
+    }
+    cycle_count += cycles;
+    idle_cycles += cycles;
+    return cycles;
+  }
+
+  // the first pass may still load registers, if the second ends where the
+  // first did every later pass is the same as the second
+  if (PC >= MEMORY_SIZE) {
+    return 0;
+  }
+  if (idle_loops.empty()) {
+    idle_loops.assign(MEMORY_SIZE, UNKNOWN_LOOP);
+  }
+  uint8_t &loop = idle_loops[PC];
+  if (loop == UNKNOWN_LOOP) {
+    loop = loop_length(PC, PC, MAX_IDLE_LOOP);
+  }
+  if (loop == 0 || cycles < IDLE_SKIP_COST * loop) {
+    return 0;
+  }
+
+  IdleIteration first{V, I, 0, {}}, second;
+  if (!run_idle_iteration(first)) {
+    return 0;
+  }
+  second.V = first.V;
+  second.I = first.I;
+  if (!run_idle_iteration(second) || second.V != first.V ||
+      second.I != first.I || cycles < first.length) {
+    return 0;
+  }
+
+  uint64_t passes = (cycles - first.length) / second.length;
+  uint64_t skipped = first.length + passes * second.length;
+  V = first.V;
+  I = first.I;
+  cycle_count += skipped;
+  idle_cycles += skipped;
+#ifdef CHIP8_PROFILING
+  for (uint8_t i = 0; i < first.length; i++) {
+    uint16_t address = first.addresses[i];
+    profiler.count_instruction(
+        address, decode(memory.read_word(address), Quirks::INSTRUCTIONS).op);
+  }
+  for (uint8_t i = 0; i < second.length && passes > 0; i++) {
+    uint16_t address = second.addresses[i];
+    profiler.count_instruction(
+        address, decode(memory.read_word(address), Quirks::INSTRUCTIONS).op,
+        passes);
+  }
+#endif
+  return skipped;
+}
+
+template <Chip8Quirks Quirks>
+uint64_t BasicChip8<Quirks>::nanoseconds_until_tick() const {
+  return (NANOSECONDS_PER_SECOND - timer_accumulator + TIMER_RATE - 1) /
+         TIMER_RATE;
+}
+
+template <Chip8Quirks Quirks>
+void BasicChip8<Quirks>::advance(uint64_t nanoseconds) {
+  while (nanoseconds > 0) {
+    // split at the next tick so the timers change between the right cycles
+    uint64_t step = std::min(nanoseconds, nanoseconds_until_tick());
+
+    step_time = emulated_time;
+    step_cycle = cycle_count;
+    step_accumulator = cycle_accumulator;
+    in_step = true;
+    cycle_accumulator += step * instruction_rate;
+    run(cycle_accumulator / NANOSECONDS_PER_SECOND);
+    cycle_accumulator %= NANOSECONDS_PER_SECOND;
+    in_step = false;
+    emulated_time += step;
+
+    timer_accumulator += step * TIMER_RATE;
+    if (timer_accumulator >= NANOSECONDS_PER_SECOND) {
+      timer_accumulator -= NANOSECONDS_PER_SECOND;
+      tick_timers();
+#ifdef CHIP8_PROFILING
+      profiler.count_frame(waiting_for_input);
+#endif
+    }
+    nanoseconds -= step;
+  }
+}
+
+template <Chip8Quirks Quirks>
+void BasicChip8<Quirks>::run_for(std::chrono::nanoseconds elapsed) {
+  if (elapsed.count() <= 0) {
+    return;
+  }
+
+  if (throttled) {
+    advance(elapsed.count());
+    return;
+  }
+
+  // reading the clock costs more than a frame, so check it every few frames
+  constexpr uint64_t FRAMES_PER_CHECK = 16;
+  auto deadline = std::chrono::steady_clock::now() + elapsed;
+  do {
+    run_frames(FRAMES_PER_CHECK);
+  } while (std::chrono::steady_clock::now() < deadline);
+}
+
+template <Chip8Quirks Quirks>
+void BasicChip8<Quirks>::run_frames(uint64_t frames) {
+  for (uint64_t i = 0; i < frames; i++) {
+    advance(nanoseconds_until_tick());
+  }
+}
+
+template <Chip8Quirks Quirks>
+void BasicChip8<Quirks>::run_until(std::chrono::nanoseconds time) {
+  if (time.count() > 0 && static_cast<uint64_t>(time.count()) > emulated_time) {
+    advance(time.count() - emulated_time);
+  }
+}
+
+template <Chip8Quirks Quirks>
+std::chrono::nanoseconds BasicChip8<Quirks>::get_emulated_time() const {
+  return std::chrono::nanoseconds(emulated_time);
+}
+
+template <Chip8Quirks Quirks>
+void BasicChip8<Quirks>::tick_timers() {
+  if (DT > 0) {
+    DT--;
+  }
+  if (ST > 0) {
+    ST--;
+    report_buzzer();
+  }
+}
+
+template <Chip8Quirks Quirks>
+uint64_t BasicChip8<Quirks>::instruction_time() const {
+  if (!in_step) {
+    return emulated_time;
+  }
+  // the nth instruction of the span runs once the accumulator has gained n
+  // instructions, it starts the span with step_accumulator
+  uint64_t progress = (cycle_count - step_cycle) * NANOSECONDS_PER_SECOND;
+  if (progress < step_accumulator) {
+    return step_time;
+  }
+  return step_time + (progress - step_accumulator) / instruction_rate;
+}
+
+template <Chip8Quirks Quirks> void BasicChip8<Quirks>::report_buzzer() {
+  bool on = ST != 0;
+  if (tone == nullptr || on == buzzer_on) {
+    return;
+  }
+  buzzer_on = on;
+  tone->set_buzzer(instruction_time(), on);
+}
+
+template <Chip8Quirks Quirks>
+void BasicChip8<Quirks>::set_instruction_rate(uint32_t rate) {
+  instruction_rate = std::max<uint32_t>(rate, 1);
+}
+
+template <Chip8Quirks Quirks>
+uint32_t BasicChip8<Quirks>::get_instruction_rate() const {
+  return instruction_rate;
+}
+
+template <Chip8Quirks Quirks>
+void BasicChip8<Quirks>::set_throttled(bool throttled) {
+  this->throttled = throttled;
+}
+
+template <Chip8Quirks Quirks>
+bool BasicChip8<Quirks>::is_throttled() const { return throttled; }
+
+template <Chip8Quirks Quirks>
+uint64_t BasicChip8<Quirks>::get_cycle_count() const { return cycle_count; }
+
+template <Chip8Quirks Quirks>
+void BasicChip8<Quirks>::set_idle_skipping(bool enabled) {
+  idle_skipping = enabled;
+}
+
+template <Chip8Quirks Quirks>
+void BasicChip8<Quirks>::set_tone_generator(ToneGenerator *tone) {
+  this->tone = tone;
+  buzzer_on = false;
+  report_buzzer();
+}
+
+template <Chip8Quirks Quirks>
+bool BasicChip8<Quirks>::is_idle_skipping() const { return idle_skipping; }
+
+template <Chip8Quirks Quirks>
+uint64_t BasicChip8<Quirks>::get_idle_cycles() const { return idle_cycles; }
+
+template <Chip8Quirks Quirks>
+void BasicChip8<Quirks>::set_seed(uint64_t seed) {
+  this->seed = seed;
+  rng_state = mix_seed(seed);
+}
+
+template <Chip8Quirks Quirks>
+uint64_t BasicChip8<Quirks>::get_seed() const { return seed; }
+
+template <Chip8Quirks Quirks>
+void BasicChip8<Quirks>::check_key_press() {
+  if (key_edge) {
+    V[target_register] = key_edge & 0xF;
+    key_edge = 0;
+    waiting_for_input = false;
+    PC += 2;
+    return;
+  }
+
+  auto pressed_it = std::ranges::find(keypad, true);
+  if (pressed_it != keypad.end()) {
+    V[target_register] =
+        static_cast<uint8_t>(std::ranges::distance(keypad.begin(), pressed_it));
+    waiting_for_input = false;
+    PC += 2;
+  }
+}
+
+template <Chip8Quirks Quirks>
+void BasicChip8<Quirks>::set_engine(Engine engine) {
+  this->engine = engine;
+  decode_cache.clear();
+  blocks.clear();
+  if (engine == Engine::DECODE_CACHE) {
+    decode_cache.resize(MEMORY_SIZE);
+  } else if (engine == Engine::RECOMPILER) {
+    blocks.resize(MEMORY_SIZE);
+  }
+  prepare_translations();
+}
+
+template <Chip8Quirks Quirks>
+Chip8Engine BasicChip8<Quirks>::get_engine() const { return engine; }
+
+template <Chip8Quirks Quirks>
+bool BasicChip8<Quirks>::is_code_static() const { return code_proven; }
+
+template <Chip8Quirks Quirks>
+void BasicChip8<Quirks>::prepare_translations() {
+  code_proven = false;
+  proven_code.clear();
+  if (engine == Engine::INTERPRETER) {
+    return;
+  }
+
+  // from reset the registers are known, anywhere else only the addresses
+  // execution can continue from are
+  AnalysisStart start;
+  start.at_reset = PC == START && SP == 0 && I == 0 &&
+                   std::ranges::count(V, 0) == REGISTER_COUNT;
+  if (!start.at_reset) {
+    start.entries = {PC};
+    start.entries.insert(start.entries.end(), stack.begin(),
+                         stack.begin() + SP);
+  }
+  auto image = std::make_unique<MemoryImage>();
+  memory.copy_to(*image);
+  RomAnalysis analysis =
+      analyze_rom(*image, AnalysisQuirks::of<Quirks>(), start);
+
+  if (engine == Engine::DECODE_CACHE) {
+    for (uint32_t address = 0; address < MEMORY_SIZE - 1; address++) {
+      if (analysis.is_instruction(address)) {
+        CachedInstruction &entry = decode_cache[address];
+        entry.instruction =
+            decode(memory.read_word(address), Quirks::INSTRUCTIONS);
+        entry.handler = HANDLERS[static_cast<size_t>(entry.instruction.op)];
+      }
+    }
+  }
+
+  // the recompiler also starts blocks after FX0A, FX18 and writes, which
+  // don't end a basic block of the analysis
+  if (engine == Engine::RECOMPILER) {
+    for (const RomAnalysis::Block &basic : analysis.blocks) {
+      uint32_t address = basic.start;
+      while (address < basic.end && address < MEMORY_SIZE - 1) {
+        Block &block = blocks[address];
+        if (block.ops.empty()) {
+          translate_block(address, block);
+        }
+        address += block.ops.size() * 2;
+        if (block.ops.back().instruction.op == Op::LOAD_I_LONG) {
+          address += 2;
+        }
+      }
+    }
+  }
+
+  if (!analysis.modifies_itself()) {
+    code_proven = true;
+    proven_code.assign(MEMORY_SIZE, -1);
+    for (uint32_t address = 0; address < MEMORY_SIZE; address++) {
+      if (analysis.bytes[address] & RomAnalysis::CODE) {
+        proven_code[address] = (*image)[address];
+      }
+    }
+  }
+}
+
+template <Chip8Quirks Quirks>
+void BasicChip8<Quirks>::load_font_data(MemoryImage &image) {
   static const std::array<uint8_t, 80> font = {
       0xF0, 0x90, 0x90, 0x90, 0xF0, // 0
       0x20, 0x60, 0x20, 0x20, 0x70, // 1
@@ -64,230 +635,659 @@ void Chip8::load_font_data() {
       0xF0, 0x80, 0xF0, 0x80, 0x80  // F
   };
 
-  std::copy(font.begin(), font.end(), memory.begin());
+  static const std::array<uint8_t, 160> large_font = {
+      0xFF, 0xFF, 0xC3, 0xC3, 0xC3, 0xC3, 0xC3, 0xC3, 0xFF, 0xFF, // 0
+      0x18, 0x78, 0x78, 0x18, 0x18, 0x18, 0x18, 0x18, 0xFF, 0xFF, // 1
+      0xFF, 0xFF, 0x03, 0x03, 0xFF, 0xFF, 0xC0, 0xC0, 0xFF, 0xFF, // 2
+      0xFF, 0xFF, 0x03, 0x03, 0xFF, 0xFF, 0x03, 0x03, 0xFF, 0xFF, // 3
+      0xC3, 0xC3, 0xC3, 0xC3, 0xFF, 0xFF, 0x03, 0x03, 0x03, 0x03, // 4
+      0xFF, 0xFF, 0xC0, 0xC0, 0xFF, 0xFF, 0x03, 0x03, 0xFF, 0xFF, // 5
+      0xFF, 0xFF, 0xC0, 0xC0, 0xFF, 0xFF, 0xC3, 0xC3, 0xFF, 0xFF, // 6
+      0xFF, 0xFF, 0x03, 0x03, 0x06, 0x0C, 0x18, 0x18, 0x18, 0x18, // 7
+      0xFF, 0xFF, 0xC3, 0xC3, 0xFF, 0xFF, 0xC3, 0xC3, 0xFF, 0xFF, // 8
+      0xFF, 0xFF, 0xC3, 0xC3, 0xFF, 0xFF, 0x03, 0x03, 0xFF, 0xFF, // 9
+      0x7E, 0xFF, 0xC3, 0xC3, 0xC3, 0xFF, 0xFF, 0xC3, 0xC3, 0xC3, // A
+      0xFC, 0xFC, 0xC3, 0xC3, 0xFC, 0xFC, 0xC3, 0xC3, 0xFC, 0xFC, // B
+      0x3C, 0xFF, 0xC3, 0xC0, 0xC0, 0xC0, 0xC0, 0xC3, 0xFF, 0x3C, // C
+      0xFC, 0xFE, 0xC3, 0xC3, 0xC3, 0xC3, 0xC3, 0xC3, 0xFE, 0xFC, // D
+      0xFF, 0xFF, 0xC0, 0xC0, 0xFF, 0xFF, 0xC0, 0xC0, 0xFF, 0xFF, // E
+      0xFF, 0xFF, 0xC0, 0xC0, 0xFF, 0xFF, 0xC0, 0xC0, 0xC0, 0xC0  // F
+  };
+
+  std::copy(font.begin(), font.end(), image.begin());
+  // the original set leaves this memory to the program
+  if constexpr (SUPER_CHIP_INSTRUCTIONS) {
+    std::copy(large_font.begin(), large_font.end(),
+              image.begin() + LARGE_FONT_ADDRESS);
+  }
 }
 
-void Chip8::sys(const uint16_t address) { PC = address & 0x0FFF; }
+template <Chip8Quirks Quirks>
+void BasicChip8<Quirks>::sys(const uint16_t address) { PC = address & 0x0FFF; }
+
+template <Chip8Quirks Quirks>
+void BasicChip8<Quirks>::cls() {
+  // rows past the current resolution are always clear
+  size_t words = get_display_height() * row_words();
+  for (uint8_t plane = 0; plane < PLANES; plane++) {
+    if (selected_planes() >> plane & 1) {
+      std::fill_n(display.begin() + plane * PLANE_WORDS, words, 0);
+    }
+  }
+  mark_dirty(0, get_display_height());
+}
 
-void Chip8::cls() { display_buffer.fill(0); }
+template <Chip8Quirks Quirks>
+void BasicChip8<Quirks>::raise_fault(Fault what) {
+  if (fault == static_cast<uint8_t>(Fault::NONE)) {
+    fault = static_cast<uint8_t>(what);
+  }
+  PC -= 2;
+}
 
-void Chip8::ret() {
-  assert(SP > 0);
+template <Chip8Quirks Quirks>
+void BasicChip8<Quirks>::ret() {
+  if (SP == 0) {
+    raise_fault(Fault::STACK_UNDERFLOW);
+    return;
+  }
   SP--;
   PC = stack[SP];
+#ifdef CHIP8_PROFILING
+  profiler.leave();
+#endif
 }
 
-void Chip8::jump(const uint16_t address) { PC = address & 0x0FFF; }
+template <Chip8Quirks Quirks>
+void BasicChip8<Quirks>::jump(const uint16_t address) { PC = address & 0x0FFF; }
 
-void Chip8::call(const uint16_t address) {
-  assert(SP < STACK_SIZE);
+template <Chip8Quirks Quirks>
+void BasicChip8<Quirks>::call(const uint16_t address) {
+  if (SP >= STACK_SIZE) {
+    raise_fault(Fault::STACK_OVERFLOW);
+    return;
+  }
   stack[SP] = PC;
   PC = address & 0x0FFF;
   SP++;
+#ifdef CHIP8_PROFILING
+  profiler.enter(PC);
+#endif
 }
 
-void Chip8::skip_next_if_equal_byte(const uint8_t register_num,
-                                    const uint8_t byte) {
+template <Chip8Quirks Quirks>
+void BasicChip8<Quirks>::skip_next_if_equal_byte(const uint8_t register_num,
+                                                 const uint8_t byte) {
   if (V[register_num] == byte) {
-    PC += 2;
+    PC += instruction_length(PC);
   }
 }
 
-void Chip8::skip_next_if_not_equal_byte(uint8_t register_num, uint8_t byte) {
+template <Chip8Quirks Quirks>
+void BasicChip8<Quirks>::skip_next_if_not_equal_byte(uint8_t register_num,
+                                                     uint8_t byte) {
   if (V[register_num] != byte) {
-    PC += 2;
+    PC += instruction_length(PC);
   }
 }
 
-void Chip8::skip_next_if_equal_registers(uint8_t register_x,
-                                         uint8_t register_y) {
+template <Chip8Quirks Quirks>
+void BasicChip8<Quirks>::skip_next_if_equal_registers(uint8_t register_x,
+                                                      uint8_t register_y) {
   if (V[register_x] == V[register_y]) {
-    PC += 2;
+    PC += instruction_length(PC);
   }
 }
 
-void Chip8::load_from_byte(uint8_t register_num, uint8_t byte) {
+template <Chip8Quirks Quirks>
+void BasicChip8<Quirks>::load_from_byte(uint8_t register_num, uint8_t byte) {
   V[register_num] = byte;
 }
 
-void Chip8::add(uint8_t register_num, uint8_t byte) { V[register_num] += byte; }
+template <Chip8Quirks Quirks>
+void BasicChip8<Quirks>::add(uint8_t register_num, uint8_t byte) {
+  V[register_num] += byte;
+}
 
-void Chip8::load_from_register_to_register(uint8_t register_x,
-                                           uint8_t register_y) {
+template <Chip8Quirks Quirks>
+void BasicChip8<Quirks>::load_from_register_to_register(uint8_t register_x,
+                                                        uint8_t register_y) {
   V[register_x] = V[register_y];
 }
 
-void Chip8::bitwise_or(uint8_t register_x, uint8_t register_y) {
+template <Chip8Quirks Quirks>
+void BasicChip8<Quirks>::bitwise_or(uint8_t register_x, uint8_t register_y) {
   V[register_x] |= V[register_y];
+  if constexpr (Quirks::LOGIC_RESETS_VF) {
+    V[0xF] = 0;
+  }
 }
 
-void Chip8::bitwise_and(uint8_t register_x, uint8_t register_y) {
+template <Chip8Quirks Quirks>
+void BasicChip8<Quirks>::bitwise_and(uint8_t register_x, uint8_t register_y) {
   V[register_x] &= V[register_y];
+  if constexpr (Quirks::LOGIC_RESETS_VF) {
+    V[0xF] = 0;
+  }
 }
 
-void Chip8::bitwise_xor(uint8_t register_x, uint8_t register_y) {
+template <Chip8Quirks Quirks>
+void BasicChip8<Quirks>::bitwise_xor(uint8_t register_x, uint8_t register_y) {
   V[register_x] ^= V[register_y];
+  if constexpr (Quirks::LOGIC_RESETS_VF) {
+    V[0xF] = 0;
+  }
 }
 
-void Chip8::add_and_store_carry(uint8_t register_x, uint8_t register_y) {
+template <Chip8Quirks Quirks>
+void BasicChip8<Quirks>::add_and_store_carry(uint8_t register_x,
+                                             uint8_t register_y) {
+  // the flag is written last, so it wins when x is F
   uint16_t sum = V[register_x] + V[register_y];
-  V[0xF] = (sum > 0xFF) ? 1 : 0;
   V[register_x] = sum & 0xFF;
+  V[0xF] = (sum > 0xFF) ? 1 : 0;
 }
 
-void Chip8::subtract(uint8_t register_x, uint8_t register_y) {
-  V[0xF] = V[register_x] >= V[register_y];
+template <Chip8Quirks Quirks>
+void BasicChip8<Quirks>::subtract(uint8_t register_x, uint8_t register_y) {
+  uint8_t flag = V[register_x] >= V[register_y];
   V[register_x] = V[register_x] - V[register_y];
+  V[0xF] = flag;
 }
 
-void Chip8::shift_right(uint8_t register_num) {
-  V[0xF] = V[register_num] & 1;
-  V[register_num] >>= 1;
+template <Chip8Quirks Quirks>
+void BasicChip8<Quirks>::shift_right(uint8_t register_x, uint8_t register_y) {
+  uint8_t value = Quirks::SHIFT_USES_VY ? V[register_y] : V[register_x];
+  V[register_x] = value >> 1;
+  V[0xF] = value & 1;
 }
 
-void Chip8::reverse_subtract(uint8_t register_x, uint8_t register_y) {
-  V[0xF] = V[register_y] >= V[register_x];
+template <Chip8Quirks Quirks>
+void BasicChip8<Quirks>::reverse_subtract(uint8_t register_x,
+                                          uint8_t register_y) {
+  uint8_t flag = V[register_y] >= V[register_x];
   V[register_x] = V[register_y] - V[register_x];
+  V[0xF] = flag;
 }
 
-void Chip8::shift_left(uint8_t register_num) {
-  V[0xF] = (V[register_num] >> 7) & 1;
-  V[register_num] <<= 1;
+template <Chip8Quirks Quirks>
+void BasicChip8<Quirks>::shift_left(uint8_t register_x, uint8_t register_y) {
+  uint8_t value = Quirks::SHIFT_USES_VY ? V[register_y] : V[register_x];
+  V[register_x] = value << 1;
+  V[0xF] = (value >> 7) & 1;
 }
 
-void Chip8::skip_next_if_not_equal_registers(uint8_t register_x,
-                                             uint8_t register_y) {
+template <Chip8Quirks Quirks>
+void BasicChip8<Quirks>::skip_next_if_not_equal_registers(uint8_t register_x,
+                                                          uint8_t register_y) {
   if (V[register_x] != V[register_y]) {
-    PC += 2;
+    PC += instruction_length(PC);
   }
 }
 
-void Chip8::load_I(uint16_t address) { I = address & 0xFFF; }
-
-void Chip8::jump_off_register(uint16_t address) { PC = V[0] + address; }
+template <Chip8Quirks Quirks>
+void BasicChip8<Quirks>::load_I(uint16_t address) { I = address & 0xFFF; }
 
-void Chip8::rand(uint8_t register_num, uint8_t byte) {
-  V[register_num] = generate_random_uint8() & byte;
+template <Chip8Quirks Quirks>
+void BasicChip8<Quirks>::jump_off_register(uint16_t address) {
+  uint8_t offset = Quirks::JUMP_USES_VX ? (address >> 8) & 0xF : 0;
+  PC = V[offset] + address;
 }
 
-void Chip8::draw(uint8_t register_x, uint8_t register_y, uint8_t height) {
-  V[0xF] = 0;
+template <Chip8Quirks Quirks>
+void BasicChip8<Quirks>::rand(uint8_t register_num, uint8_t byte) {
+  V[register_num] = next_random(rng_state) & byte;
+}
 
-  for (uint8_t row = 0; row < height; row++) {
-    uint8_t byte = memory[I + row];
-    uint16_t y = (V[register_y] + row) % HEIGHT;
-    uint16_t offset = y * WIDTH;
+template <Chip8Quirks Quirks>
+void BasicChip8<Quirks>::draw(uint8_t register_x, uint8_t register_y,
+                              uint8_t nibble) {
+#ifdef CHIP8_PROFILING
+  auto start = std::chrono::steady_clock::now();
+#endif
+  const int words = row_words();
+  uint8_t x = V[register_x] % get_display_width();
+  uint8_t y = V[register_y] % get_display_height();
+  bool large = SUPER_CHIP_INSTRUCTIONS && nibble == 0;
+  uint8_t height = large ? LARGE_SPRITE_SIZE : nibble;
+  uint8_t width = large ? LARGE_SPRITE_SIZE : SPRITE_WIDTH;
+  uint8_t before_wrap = std::min<int>(height, get_display_height() - y);
+
+  uint64_t collision = 0;
+  uint16_t address = I;
+  for (uint8_t plane = 0; plane < PLANES; plane++) {
+    if (!(selected_planes() >> plane & 1)) {
+      continue;
+    }
 
-    for (uint8_t col = 0; col < SPRITE_WIDTH; col++) {
-      uint8_t bit = byte >> (SPRITE_WIDTH - col - 1) & 1;
-      if (!bit) {
+    // each sprite row becomes a full display row, rotated so it wraps at
+    // the edge or shifted so the pixels past it drop off. a high resolution
+    // row is two words, the sprite spills from the word it starts in into
+    // the other one
+    std::array<uint64_t, MAX_SPRITE_HEIGHT * 2> sprite;
+    for (uint8_t row = 0; row < height; row++) {
+      uint64_t bits = memory[address++];
+      if (large) {
+        bits = bits << 8 | memory[address++];
+      }
+      bits <<= 64 - width;
+
+      if (words == 1) {
+        if constexpr (Quirks::CLIP_SPRITES) {
+          sprite[row] = bits >> x;
+        } else {
+          sprite[row] = std::rotr(bits, x);
+        }
         continue;
       }
-
-      uint16_t x = (V[register_x] + col) % WIDTH;
-      uint8_t *pixel = &display_buffer[x + offset];
-
-      if (*pixel) {
-        V[0xF] = 1;
+      uint8_t shift = x % 64;
+      uint64_t spill = shift != 0 ? bits << (64 - shift) : 0;
+      if (x < 64) {
+        sprite[row * 2] = bits >> shift;
+        sprite[row * 2 + 1] = spill;
+      } else {
+        sprite[row * 2] = Quirks::CLIP_SPRITES ? 0 : spill;
+        sprite[row * 2 + 1] = bits >> shift;
       }
+    }
 
-      *pixel ^= 1;
+    // the rows down to the bottom edge, then the ones wrapped to the top
+    uint64_t *rows = &display[plane * PLANE_WORDS];
+    collision |= xor_rows(&rows[y * words], sprite.data(), before_wrap * words);
+    if constexpr (!Quirks::CLIP_SPRITES) {
+      collision |= xor_rows(rows, sprite.data() + before_wrap * words,
+                            (height - before_wrap) * words);
     }
   }
+
+  mark_dirty(y, y + before_wrap);
+  if constexpr (!Quirks::CLIP_SPRITES) {
+    mark_dirty(0, height - before_wrap);
+  }
+  V[0xF] = collision != 0;
+#ifdef CHIP8_PROFILING
+  profiler.count_draw(std::chrono::nanoseconds(
+                          std::chrono::steady_clock::now() - start)
+                          .count());
+#endif
 }
 
-void Chip8::skip_if_pressed(uint8_t register_num) {
-  if (keypad[V[register_num]]) {
-    PC += 2;
+template <Chip8Quirks Quirks>
+void BasicChip8<Quirks>::skip_if_pressed(uint8_t register_num) {
+  // only the low nibble picks a key, like the VIP's keypad latch
+  if (keypad[V[register_num] & 0xF]) {
+    PC += instruction_length(PC);
   }
 }
 
-void Chip8::skip_if_not_pressed(uint8_t register_num) {
-  if (!keypad[V[register_num]]) {
-    PC += 2;
+template <Chip8Quirks Quirks>
+void BasicChip8<Quirks>::skip_if_not_pressed(uint8_t register_num) {
+  if (!keypad[V[register_num] & 0xF]) {
+    PC += instruction_length(PC);
   }
 }
 
-void Chip8::load_from_delay_timer(uint8_t register_x) { V[register_x] = DT; }
+template <Chip8Quirks Quirks>
+void BasicChip8<Quirks>::load_from_delay_timer(uint8_t register_x) {
+  V[register_x] = DT;
+}
 
-void Chip8::store_key_press(uint8_t register_num) {
+template <Chip8Quirks Quirks>
+void BasicChip8<Quirks>::store_key_press(uint8_t register_num) {
   waiting_for_input = true;
   target_register = register_num;
+  PC -= 2;
 }
 
-void Chip8::set_delay_timer(uint8_t register_num) { DT = V[register_num]; }
+template <Chip8Quirks Quirks>
+void BasicChip8<Quirks>::set_delay_timer(uint8_t register_num) {
+  DT = V[register_num];
+}
 
-void Chip8::set_sound_timer(uint8_t register_num) { ST = V[register_num]; }
+template <Chip8Quirks Quirks>
+void BasicChip8<Quirks>::set_sound_timer(uint8_t register_num) {
+  ST = V[register_num];
+  // the recompiler counts its cycles after the block, which this ends
+  if (engine == Engine::RECOMPILER) {
+    buzzer_pending = true;
+  } else {
+    report_buzzer();
+  }
+}
 
-void Chip8::add_I(uint8_t register_num) { I += V[register_num]; }
+template <Chip8Quirks Quirks>
+void BasicChip8<Quirks>::add_I(uint8_t register_num) { I += V[register_num]; }
 
-void Chip8::load_sprite(uint8_t register_num) {
-  constexpr uint8_t SPRITE_HEIGHT = 5;
-  I = V[register_num] * SPRITE_HEIGHT;
+template <Chip8Quirks Quirks>
+void BasicChip8<Quirks>::load_sprite(uint8_t register_num) {
+  I = V[register_num] * FONT_HEIGHT;
 }
 
-void Chip8::write_binary_coded_decimal(uint8_t register_num) {
-  memory[I] = V[register_num] / 100;
-  memory[I + 1] = (V[register_num] / 10) % 10;
-  memory[I + 2] = V[register_num] % 10;
+template <Chip8Quirks Quirks>
+void BasicChip8<Quirks>::write_binary_coded_decimal(uint8_t register_num) {
+  const uint8_t digits[] = {static_cast<uint8_t>(V[register_num] / 100),
+                            static_cast<uint8_t>((V[register_num] / 10) % 10),
+                            static_cast<uint8_t>(V[register_num] % 10)};
+  memory.write(I, digits, sizeof(digits));
+  memory_written(I, 3);
 }
 
-void Chip8::store_memory_from_registers(uint8_t register_num) {
-  uint16_t address = I;
-  for (uint8_t i = 0; i <= register_num; i++) {
-    memory[address++] = V[i];
+template <Chip8Quirks Quirks>
+void BasicChip8<Quirks>::store_memory_from_registers(uint8_t register_num) {
+  memory.write(I, V.data(), register_num + 1);
+  memory_written(I, register_num + 1);
+  if constexpr (Quirks::LOAD_STORE_INCREMENTS_I) {
+    I += register_num + 1;
   }
 }
 
-void Chip8::store_registers_from_memory(uint8_t register_num) {
+template <Chip8Quirks Quirks>
+void BasicChip8<Quirks>::store_registers_from_memory(uint8_t register_num) {
   uint16_t address = I;
   for (uint8_t i = 0; i <= register_num; i++) {
     V[i] = memory[address++];
   }
+  if constexpr (Quirks::LOAD_STORE_INCREMENTS_I) {
+    I = address;
+  }
+}
+
+template <Chip8Quirks Quirks>
+void BasicChip8<Quirks>::scroll_down(uint8_t rows) {
+  size_t words = get_display_height() * row_words();
+  size_t shift = std::min<size_t>(rows * row_words(), words);
+  for (uint8_t plane = 0; plane < PLANES; plane++) {
+    if (selected_planes() >> plane & 1) {
+      auto first = display.begin() + plane * PLANE_WORDS;
+      std::copy_backward(first, first + words - shift, first + words);
+      std::fill_n(first, shift, 0);
+    }
+  }
+  mark_dirty(0, get_display_height());
+}
+
+template <Chip8Quirks Quirks>
+void BasicChip8<Quirks>::scroll_up(uint8_t rows) {
+  size_t words = get_display_height() * row_words();
+  size_t shift = std::min<size_t>(rows * row_words(), words);
+  for (uint8_t plane = 0; plane < PLANES; plane++) {
+    if (selected_planes() >> plane & 1) {
+      auto first = display.begin() + plane * PLANE_WORDS;
+      std::copy(first + shift, first + words, first);
+      std::fill_n(first + words - shift, shift, 0);
+    }
+  }
+  mark_dirty(0, get_display_height());
+}
+
+template <Chip8Quirks Quirks>
+void BasicChip8<Quirks>::scroll_right() {
+  constexpr int PIXELS = 4;
+  size_t words = get_display_height() * row_words();
+  for (uint8_t plane = 0; plane < PLANES; plane++) {
+    if (!(selected_planes() >> plane & 1)) {
+      continue;
+    }
+    uint64_t *rows = &display[plane * PLANE_WORDS];
+    for (size_t i = 0; i < words; i += row_words()) {
+      if (row_words() == 2) {
+        rows[i + 1] = rows[i + 1] >> PIXELS | rows[i] << (64 - PIXELS);
+      }
+      rows[i] >>= PIXELS;
+    }
+  }
+  mark_dirty(0, get_display_height());
+}
+
+template <Chip8Quirks Quirks>
+void BasicChip8<Quirks>::scroll_left() {
+  constexpr int PIXELS = 4;
+  size_t words = get_display_height() * row_words();
+  for (uint8_t plane = 0; plane < PLANES; plane++) {
+    if (!(selected_planes() >> plane & 1)) {
+      continue;
+    }
+    uint64_t *rows = &display[plane * PLANE_WORDS];
+    for (size_t i = 0; i < words; i += row_words()) {
+      rows[i] <<= PIXELS;
+      if (row_words() == 2) {
+        rows[i] |= rows[i + 1] >> (64 - PIXELS);
+        rows[i + 1] <<= PIXELS;
+      }
+    }
+  }
+  mark_dirty(0, get_display_height());
+}
+
+template <Chip8Quirks Quirks>
+void BasicChip8<Quirks>::exit() { PC -= 2; }
+
+template <Chip8Quirks Quirks>
+void BasicChip8<Quirks>::low_resolution() {
+  hires = false;
+  display.fill(0);
+  mark_dirty(0, HEIGHT);
+}
+
+template <Chip8Quirks Quirks>
+void BasicChip8<Quirks>::high_resolution() {
+  hires = true;
+  display.fill(0);
+  mark_dirty(0, HIRES_HEIGHT);
+}
+
+template <Chip8Quirks Quirks>
+void BasicChip8<Quirks>::store_memory_from_register_range(uint8_t register_x,
+                                                          uint8_t register_y) {
+  int step = register_x <= register_y ? 1 : -1;
+  uint8_t count = std::abs(register_y - register_x) + 1;
+  uint8_t bytes[REGISTER_COUNT];
+  for (uint8_t i = 0; i < count; i++) {
+    bytes[i] = V[register_x + i * step];
+  }
+  memory.write(I, bytes, count);
+  memory_written(I, count);
+}
+
+template <Chip8Quirks Quirks>
+void BasicChip8<Quirks>::store_register_range_from_memory(uint8_t register_x,
+                                                          uint8_t register_y) {
+  int step = register_x <= register_y ? 1 : -1;
+  uint8_t count = std::abs(register_y - register_x) + 1;
+  for (uint8_t i = 0; i < count; i++) {
+    V[register_x + i * step] = memory[I + i];
+  }
+}
+
+template <Chip8Quirks Quirks>
+void BasicChip8<Quirks>::load_I_long() {
+  I = memory.read_word(PC);
+  PC += 2;
+}
+
+template <Chip8Quirks Quirks>
+void BasicChip8<Quirks>::select_planes(uint8_t mask) {
+  planes = mask & ((1 << PLANES) - 1);
+}
+
+template <Chip8Quirks Quirks>
+void BasicChip8<Quirks>::load_audio_pattern() {
+  if constexpr (XO_CHIP_INSTRUCTIONS) {
+    for (uint8_t i = 0; i < PATTERN_SIZE; i++) {
+      this->pattern[i] = memory[I + i];
+    }
+  }
+}
+
+template <Chip8Quirks Quirks>
+void BasicChip8<Quirks>::load_large_sprite(uint8_t register_num) {
+  I = LARGE_FONT_ADDRESS + (V[register_num] & 0xF) * LARGE_FONT_HEIGHT;
+}
+
+template <Chip8Quirks Quirks>
+void BasicChip8<Quirks>::set_pitch(uint8_t register_num) {
+  pitch = V[register_num];
+}
+
+template <Chip8Quirks Quirks>
+void BasicChip8<Quirks>::store_flags_from_registers(uint8_t register_num) {
+  if constexpr (SUPER_CHIP_INSTRUCTIONS) {
+    std::copy_n(V.begin(), register_num + 1, this->flags.begin());
+  }
+}
+
+template <Chip8Quirks Quirks>
+void BasicChip8<Quirks>::store_registers_from_flags(uint8_t register_num) {
+  if constexpr (SUPER_CHIP_INSTRUCTIONS) {
+    std::copy_n(this->flags.begin(), register_num + 1, V.begin());
+  }
 }
 
-const std::array<uint8_t, Chip8::WIDTH * Chip8::HEIGHT> &
-Chip8::get_display_buffer() const {
+template <Chip8Quirks Quirks>
+void BasicChip8<Quirks>::mark_dirty(uint8_t first, uint8_t end) {
+  display_generation++;
+  if (first >= end) {
+    return;
+  }
+
+  if (dirty_rows.first >= dirty_rows.end) {
+    dirty_rows = {first, end};
+  } else {
+    dirty_rows.first = std::min(dirty_rows.first, first);
+    dirty_rows.end = std::max(dirty_rows.end, end);
+  }
+}
+
+template <Chip8Quirks Quirks>
+uint64_t BasicChip8<Quirks>::get_display_generation() const {
+  return display_generation;
+}
+
+template <Chip8Quirks Quirks>
+Chip8Context::DirtyRows BasicChip8<Quirks>::get_dirty_rows() const {
+  return dirty_rows;
+}
+
+template <Chip8Quirks Quirks>
+void BasicChip8<Quirks>::clear_dirty_rows() { dirty_rows = {0, 0}; }
+
+template <Chip8Quirks Quirks>
+bool BasicChip8<Quirks>::get_display_buffer(std::span<uint8_t> buffer) const {
+  int width = get_display_width();
+  int height = get_display_height();
+  if (buffer.size() < static_cast<size_t>(width * height)) {
+    return false;
+  }
+  std::fill_n(buffer.begin(), width * height, 0);
+  for (uint8_t plane = 0; plane < PLANES; plane++) {
+    std::span<const uint64_t> rows = get_display_rows(plane);
+    for (int y = 0; y < height; y++) {
+      for (int x = 0; x < width; x++) {
+        uint64_t word = rows[y * row_words() + x / 64];
+        buffer[y * width + x] |= (word >> (63 - x % 64) & 1) << plane;
+      }
+    }
+  }
+  return true;
+}
+
+template <Chip8Quirks Quirks>
+std::vector<uint8_t> BasicChip8<Quirks>::get_display_buffer() const {
+  std::vector<uint8_t> display_buffer(get_display_width() *
+                                      get_display_height());
+  get_display_buffer(display_buffer);
   return display_buffer;
 }
 
-const std::array<uint16_t, Chip8::STACK_SIZE> &Chip8::get_stack() const {
+template <Chip8Quirks Quirks>
+std::span<const uint64_t>
+BasicChip8<Quirks>::get_display_rows(uint8_t plane) const {
+  const uint64_t *rows = plane < PLANES ? display.data() + plane * PLANE_WORDS
+                                        : BLANK_PLANE.data();
+  return {rows, static_cast<size_t>(get_display_height() * row_words())};
+}
+
+template <Chip8Quirks Quirks>
+int BasicChip8<Quirks>::get_display_width() const {
+  return row_words() == 2 ? HIRES_WIDTH : WIDTH;
+}
+
+template <Chip8Quirks Quirks>
+int BasicChip8<Quirks>::get_display_height() const {
+  return row_words() == 2 ? HIRES_HEIGHT : HEIGHT;
+}
+
+template <Chip8Quirks Quirks>
+const std::array<uint16_t, Chip8Context::STACK_SIZE> &
+BasicChip8<Quirks>::get_stack() const {
   return stack;
 }
 
-const std::array<uint8_t, Chip8::REGISTER_COUNT> &Chip8::get_registers() const {
+template <Chip8Quirks Quirks>
+const std::array<uint8_t, Chip8Context::REGISTER_COUNT> &
+BasicChip8<Quirks>::get_registers() const {
   return V;
 }
 
-uint8_t Chip8::get_register(uint8_t register_num) const {
+template <Chip8Quirks Quirks>
+uint8_t BasicChip8<Quirks>::get_register(uint8_t register_num) const {
   return V[register_num];
 }
 
-uint16_t Chip8::get_I() const { return I; }
+template <Chip8Quirks Quirks>
+uint16_t BasicChip8<Quirks>::get_I() const { return I; }
 
-uint16_t Chip8::get_PC() const { return PC; }
+template <Chip8Quirks Quirks>
+uint16_t BasicChip8<Quirks>::get_PC() const { return PC; }
 
-uint8_t Chip8::get_SP() const { return SP; }
+template <Chip8Quirks Quirks>
+uint8_t BasicChip8<Quirks>::get_SP() const { return SP; }
 
-uint8_t Chip8::get_DT() const { return DT; }
+template <Chip8Quirks Quirks>
+typename BasicChip8<Quirks>::Fault BasicChip8<Quirks>::get_fault() const {
+  return static_cast<Fault>(fault);
+}
 
-void Chip8::set_DT(uint8_t value) { DT = value; }
+template <Chip8Quirks Quirks>
+uint8_t BasicChip8<Quirks>::get_DT() const { return DT; }
 
-uint8_t Chip8::get_ST() const { return ST; }
+template <Chip8Quirks Quirks>
+void BasicChip8<Quirks>::set_DT(uint8_t value) { DT = value; }
 
-void Chip8::set_ST(uint8_t value) { ST = value; }
+template <Chip8Quirks Quirks>
+uint8_t BasicChip8<Quirks>::get_ST() const { return ST; }
 
-void Chip8::set_keypad(uint8_t keypad_num, uint8_t status) {
+template <Chip8Quirks Quirks>
+void BasicChip8<Quirks>::set_ST(uint8_t value) {
+  ST = value;
+  report_buzzer();
+}
+
+template <Chip8Quirks Quirks>
+void BasicChip8<Quirks>::set_keypad(uint8_t keypad_num, uint8_t status) {
+  if (status && waiting_for_input && !key_edge) {
+    key_edge = 0x10 | keypad_num;
+  }
   keypad[keypad_num] = status;
 }
 
-uint16_t Chip8::fetch() const {
-  constexpr uint8_t SHIFT_AMOUNT = 8;
-  uint16_t instruction = (memory[PC] << SHIFT_AMOUNT) | (memory[PC + 1]);
-  return instruction;
+template <Chip8Quirks Quirks>
+uint16_t BasicChip8<Quirks>::fetch() const {
+  return memory.read_word(PC);
 }
 
-void Chip8::decode_and_execute(uint16_t instruction) {
+template <Chip8Quirks Quirks>
+void BasicChip8<Quirks>::decode_and_execute(uint16_t instruction) {
+  // the extensions reuse encodings the switch below gives other meanings
+  if constexpr (SUPER_CHIP_INSTRUCTIONS) {
+    Op extension = decode_extension(instruction, Quirks::INSTRUCTIONS);
+    if (extension != Op::COUNT) {
+      HANDLERS[static_cast<size_t>(extension)](
+          *this, decode(instruction, Quirks::INSTRUCTIONS));
+      return;
+    }
+  }
+
   uint8_t type = (instruction & 0xF000) >> 12; // first nibble
   uint8_t x = (instruction & 0xF00) >> 8;      // second nibble
   uint8_t y = (instruction & 0xF0) >> 4;       // third nibble
@@ -347,13 +1347,13 @@ void Chip8::decode_and_execute(uint16_t instruction) {
       subtract(x, y);
       break;
     case 0x6:
-      shift_right(x);
+      shift_right(x, y);
       break;
     case 0x7:
       reverse_subtract(x, y);
       break;
     case 0xE:
-      shift_left(x);
+      shift_left(x, y);
       break;
     default:;
     }
@@ -424,12 +1424,279 @@ void Chip8::decode_and_execute(uint16_t instruction) {
   }
 }
 
-void Chip8::reset() {
+// clang-format off
+template <Chip8Quirks Quirks>
+const std::array<typename BasicChip8<Quirks>::Handler, static_cast<size_t>(Op::COUNT)>
+    BasicChip8<Quirks>::HANDLERS = {
+    [](BasicChip8 &c, const Instruction &i) { c.sys(i.nnn); },
+    [](BasicChip8 &c, const Instruction &) { c.cls(); },
+    [](BasicChip8 &c, const Instruction &) { c.ret(); },
+    [](BasicChip8 &c, const Instruction &i) { c.jump(i.nnn); },
+    [](BasicChip8 &c, const Instruction &i) { c.call(i.nnn); },
+    [](BasicChip8 &c, const Instruction &i) { c.skip_next_if_equal_byte(i.x, i.nn); },
+    [](BasicChip8 &c, const Instruction &i) { c.skip_next_if_not_equal_byte(i.x, i.nn); },
+    [](BasicChip8 &c, const Instruction &i) { c.skip_next_if_equal_registers(i.x, i.y); },
+    [](BasicChip8 &c, const Instruction &i) { c.load_from_byte(i.x, i.nn); },
+    [](BasicChip8 &c, const Instruction &i) { c.add(i.x, i.nn); },
+    [](BasicChip8 &c, const Instruction &i) { c.load_from_register_to_register(i.x, i.y); },
+    [](BasicChip8 &c, const Instruction &i) { c.bitwise_or(i.x, i.y); },
+    [](BasicChip8 &c, const Instruction &i) { c.bitwise_and(i.x, i.y); },
+    [](BasicChip8 &c, const Instruction &i) { c.bitwise_xor(i.x, i.y); },
+    [](BasicChip8 &c, const Instruction &i) { c.add_and_store_carry(i.x, i.y); },
+    [](BasicChip8 &c, const Instruction &i) { c.subtract(i.x, i.y); },
+    [](BasicChip8 &c, const Instruction &i) { c.shift_right(i.x, i.y); },
+    [](BasicChip8 &c, const Instruction &i) { c.reverse_subtract(i.x, i.y); },
+    [](BasicChip8 &c, const Instruction &i) { c.shift_left(i.x, i.y); },
+    [](BasicChip8 &c, const Instruction &i) { c.skip_next_if_not_equal_registers(i.x, i.y); },
+    [](BasicChip8 &c, const Instruction &i) { c.load_I(i.nnn); },
+    [](BasicChip8 &c, const Instruction &i) { c.jump_off_register(i.nnn); },
+    [](BasicChip8 &c, const Instruction &i) { c.rand(i.x, i.nn); },
+    [](BasicChip8 &c, const Instruction &i) { c.draw(i.x, i.y, i.n); },
+    [](BasicChip8 &c, const Instruction &i) { c.skip_if_pressed(i.x); },
+    [](BasicChip8 &c, const Instruction &i) { c.skip_if_not_pressed(i.x); },
+    [](BasicChip8 &c, const Instruction &i) { c.load_from_delay_timer(i.x); },
+    [](BasicChip8 &c, const Instruction &i) { c.store_key_press(i.x); },
+    [](BasicChip8 &c, const Instruction &i) { c.set_delay_timer(i.x); },
+    [](BasicChip8 &c, const Instruction &i) { c.set_sound_timer(i.x); },
+    [](BasicChip8 &c, const Instruction &i) { c.add_I(i.x); },
+    [](BasicChip8 &c, const Instruction &i) { c.load_sprite(i.x); },
+    [](BasicChip8 &c, const Instruction &i) { c.write_binary_coded_decimal(i.x); },
+    [](BasicChip8 &c, const Instruction &i) { c.store_memory_from_registers(i.x); },
+    [](BasicChip8 &c, const Instruction &i) { c.store_registers_from_memory(i.x); },
+    [](BasicChip8 &c, const Instruction &i) { c.scroll_down(i.n); },
+    [](BasicChip8 &c, const Instruction &i) { c.scroll_up(i.n); },
+    [](BasicChip8 &c, const Instruction &) { c.scroll_right(); },
+    [](BasicChip8 &c, const Instruction &) { c.scroll_left(); },
+    [](BasicChip8 &c, const Instruction &) { c.exit(); },
+    [](BasicChip8 &c, const Instruction &) { c.low_resolution(); },
+    [](BasicChip8 &c, const Instruction &) { c.high_resolution(); },
+    [](BasicChip8 &c, const Instruction &i) { c.store_memory_from_register_range(i.x, i.y); },
+    [](BasicChip8 &c, const Instruction &i) { c.store_register_range_from_memory(i.x, i.y); },
+    [](BasicChip8 &c, const Instruction &) { c.load_I_long(); },
+    [](BasicChip8 &c, const Instruction &i) { c.select_planes(i.x); },
+    [](BasicChip8 &c, const Instruction &) { c.load_audio_pattern(); },
+    [](BasicChip8 &c, const Instruction &i) { c.load_large_sprite(i.x); },
+    [](BasicChip8 &c, const Instruction &i) { c.set_pitch(i.x); },
+    [](BasicChip8 &c, const Instruction &i) { c.store_flags_from_registers(i.x); },
+    [](BasicChip8 &c, const Instruction &i) { c.store_registers_from_flags(i.x); },
+    [](BasicChip8 &, const Instruction &) {},
+};
+// clang-format on
+
+template <Chip8Quirks Quirks>
+void BasicChip8<Quirks>::execute_cached() {
+  // the last byte of memory can't hold a full instruction, decode it fresh
+  if (PC >= decode_cache.size() - 1) {
+    uint16_t instruction = fetch();
+    PC += 2;
+    decode_and_execute(instruction);
+    return;
+  }
+
+  CachedInstruction &entry = decode_cache[PC];
+  if (entry.handler == nullptr) {
+    check_proven(PC);
+    entry.instruction = decode(fetch(), Quirks::INSTRUCTIONS);
+    entry.handler = HANDLERS[static_cast<size_t>(entry.instruction.op)];
+  }
+
+  // copied since the handler may invalidate the entry it runs from
+  const Instruction instruction = entry.instruction;
+  PC += 2;
+  entry.handler(*this, instruction);
+}
+
+template <Chip8Quirks Quirks>
+void BasicChip8<Quirks>::translate_block(uint16_t address, Block &block) {
+  block.ops.clear();
+
+  while (address < MEMORY_SIZE - 1 && block.ops.size() < MAX_BLOCK_LENGTH) {
+    CachedInstruction op;
+    op.instruction = decode(memory.read_word(address), Quirks::INSTRUCTIONS);
+    op.handler = HANDLERS[static_cast<size_t>(op.instruction.op)];
+    block.ops.push_back(op);
+    address += 2;
+
+    switch (op.instruction.op) {
+    // control flow leaves the straight line
+    case Op::SYS:
+    case Op::RET:
+    case Op::JUMP:
+    case Op::CALL:
+    case Op::JUMP_OFF_REGISTER:
+    case Op::SKIP_NEXT_IF_EQUAL_BYTE:
+    case Op::SKIP_NEXT_IF_NOT_EQUAL_BYTE:
+    case Op::SKIP_NEXT_IF_EQUAL_REGISTERS:
+    case Op::SKIP_NEXT_IF_NOT_EQUAL_REGISTERS:
+    case Op::SKIP_IF_PRESSED:
+    case Op::SKIP_IF_NOT_PRESSED:
+    case Op::EXIT:
+    // the operand would be translated as an instruction
+    case Op::LOAD_I_LONG:
+    // execution pauses until a key is pressed
+    case Op::STORE_KEY_PRESS:
+    // the buzzer edge is timed once the block is counted
+    case Op::SET_SOUND_TIMER:
+    // memory writes may overwrite the rest of the block
+    case Op::WRITE_BINARY_CODED_DECIMAL:
+    case Op::STORE_MEMORY_FROM_REGISTERS:
+    case Op::STORE_MEMORY_FROM_REGISTER_RANGE:
+      return;
+    default:;
+    }
+  }
+}
+
+template <Chip8Quirks Quirks>
+uint64_t BasicChip8<Quirks>::execute_block(uint64_t max_cycles) {
+  // the last byte of memory can't hold a full instruction, decode it fresh
+  if (PC >= blocks.size() - 1) {
+    profile_instruction();
+    uint16_t instruction = fetch();
+    PC += 2;
+    decode_and_execute(instruction);
+    return 1;
+  }
+
+  Block &block = blocks[PC];
+  if (block.ops.empty()) {
+    check_proven(PC);
+    translate_block(PC, block);
+  }
+
+  uint64_t count = std::min<uint64_t>(block.ops.size(), max_cycles);
+  for (uint64_t i = 0; i < count; i++) {
+    // copied since the last handler may invalidate the block it runs from
+    const CachedInstruction op = block.ops[i];
+    profile_instruction();
+    PC += 2;
+    op.handler(*this, op.instruction);
+  }
+  return count;
+}
+
+template <Chip8Quirks Quirks>
+void BasicChip8<Quirks>::invalidate_translations(uint16_t address,
+                                                 uint32_t length) {
+  // hints only save work, a stale one can at worst miss an idle loop. the
+  // ones of instructions running straight into the write are redone
+  size_t hint_reach = MAX_IDLE_LOOP * 2;
+  size_t hint_first = address > hint_reach ? address - hint_reach : 0;
+  size_t hint_last = std::min<size_t>(address + length, idle_loops.size());
+  if (hint_first < hint_last) {
+    std::fill(idle_loops.begin() + hint_first,
+              idle_loops.begin() + hint_last, UNKNOWN_LOOP);
+  }
+
+  // an instruction starting one byte before the write overlaps it too
+  size_t first = address > 0 ? address - 1 : 0;
+
+  if (!decode_cache.empty()) {
+    size_t last = std::min<size_t>(address + length, decode_cache.size());
+    for (size_t i = first; i < last; i++) {
+      decode_cache[i].handler = nullptr;
+    }
+  }
+
+  if (!blocks.empty()) {
+    // any block starting up to its maximum length before the write may
+    // cover it
+    size_t reach = MAX_BLOCK_LENGTH * 2 - 1;
+    size_t start = address > reach ? address - reach : 0;
+    size_t last = std::min<size_t>(address + length, blocks.size());
+    for (size_t i = start; i < last; i++) {
+      Block &block = blocks[i];
+      if (!block.ops.empty() && i + block.ops.size() * 2 > address) {
+        block.ops.clear();
+      }
+    }
+  }
+}
+
+template <Chip8Quirks Quirks>
+void BasicChip8<Quirks>::memory_written(uint16_t address, uint16_t length) {
+  // the bytes went to (address + k) & ADDRESS_MASK, a range that wraps is
+  // split at the end of the address space
+  constexpr uint32_t SPACE = Memory::ADDRESS_MASK + 1;
+  uint32_t first = address & Memory::ADDRESS_MASK;
+  uint32_t end = first + length;
+  if (end > SPACE) {
+    range_written(0, end - SPACE);
+    end = SPACE;
+  }
+  range_written(first, end);
+}
+
+template <Chip8Quirks Quirks>
+void BasicChip8<Quirks>::range_written(uint32_t first, uint32_t end) {
+  // writes past the end of memory went to the guard pages and were dropped
+  end = std::min<uint32_t>(end, MEMORY_SIZE);
+  if (first >= end) {
+    return;
+  }
+  // the proof rests on the analysis seeing every write, one it missed that
+  // lands on the code ends it
+  if (code_proven) {
+    code_proven = std::all_of(proven_code.begin() + (first > 0 ? first - 1 : 0),
+                              proven_code.begin() + end,
+                              [](int16_t byte) { return byte < 0; });
+  }
+  if (!code_proven) {
+    invalidate_translations(first, end - first);
+  }
+  written_first = std::min(written_first, first);
+  written_end = std::max(written_end, end);
+}
+
+template <Chip8Quirks Quirks>
+typename BasicChip8<Quirks>::Snapshot BasicChip8<Quirks>::snapshot() const {
+  Snapshot snapshot;
+  static_cast<Chip8Context &>(snapshot) = *this;
+  static_cast<Extension &>(snapshot) = *this;
+  memory.copy_to(snapshot.memory);
+  return snapshot;
+}
+
+template <Chip8Quirks Quirks>
+void BasicChip8<Quirks>::restore(const Snapshot &snapshot) {
+  // the generation keeps counting up so a frontend sees the restored display
+  uint64_t generation = display_generation;
+  static_cast<Chip8Context &>(*this) = snapshot;
+  static_cast<Extension &>(*this) = snapshot;
+  memory.assign(snapshot.memory);
+  display_generation = generation;
+  mark_dirty(0, get_display_height());
+
+  // a snapshot with the proven code unchanged keeps every translation
+  if (code_proven) {
+    for (uint32_t address = 0; address < MEMORY_SIZE; address++) {
+      if (proven_code[address] >= 0 &&
+          proven_code[address] != snapshot.memory[address]) {
+        code_proven = false;
+        break;
+      }
+    }
+  }
+  if (!code_proven) {
+    invalidate_translations(0, MEMORY_SIZE);
+  }
+  report_buzzer();
+#ifdef CHIP8_PROFILING
+  profiler.leave_all();
+#endif
+}
+
+template <Chip8Quirks Quirks>
+void BasicChip8<Quirks>::reset() {
   stack.fill(0);
   V.fill(0);
   keypad.fill(0);
-  display_buffer.fill(0);
-  memory.fill(0);
+  static_cast<Extension &>(*this) = Extension{}; // display, flags, pattern
+  hires = false;
+  planes = 1;
+  pitch = 64;
+  mark_dirty(0, HEIGHT);
+  memory = Memory(font_image<BasicChip8>());
   I = 0;
   PC = START;
   SP = 0;
@@ -437,5 +1704,32 @@ void Chip8::reset() {
   ST = 0;
   target_register = 0;
   waiting_for_input = 0;
-  load_font_data();
+  key_edge = 0;
+  fault = 0;
+  cycle_accumulator = 0;
+  timer_accumulator = 0;
+  cycle_count = 0;
+  idle_cycles = 0;
+  emulated_time = 0;
+  rng_state = mix_seed(seed);
+  code_proven = false;
+  invalidate_translations(0, MEMORY_SIZE);
+  report_buzzer();
+#ifdef CHIP8_PROFILING
+  profiler.leave_all();
+#endif
 }
+
+#ifdef CHIP8_PROFILING
+template <Chip8Quirks Quirks>
+const Profiler &BasicChip8<Quirks>::get_profiler() const { return profiler; }
+
+template <Chip8Quirks Quirks>
+void BasicChip8<Quirks>::clear_profiler() { profiler.clear(); }
+#endif
+
+template class BasicChip8<DefaultQuirks>;
+template class BasicChip8<CosmacVipQuirks>;
+template class BasicChip8<Chip48Quirks>;
+template class BasicChip8<SuperChipQuirks>;
+template class BasicChip8<XoChipQuirks>;
@@ -1,56 +1,383 @@
 /// @file chip8.hpp
-/// @brief declaration of the Chip8 class
+/// @brief declaration of the BasicChip8 class template and Chip8
 /// @author Abhay Manoj
 /// @date Feb 19 2026
 #pragma once
 
+#include "opcode.hpp"
+#include "paged_memory.hpp"
+#include "quirks.hpp"
 #include <array>
+#include <chrono>
+#include <cstddef>
 #include <cstdint>
+#include <memory>
+#include <span>
+#include <type_traits>
+#include <vector>
 
-/// @brief represents the chip8 virtual machine
-class Chip8 {
-public:
+#ifdef CHIP8_PROFILING
+#include "profiler.hpp"
+#endif
+
+class ToneGenerator;
+
+/// @brief the machine state every platform shares, apart from the display
+/// and memory. trivially copyable, fields are ordered by size so the struct
+/// has no padding
+struct Chip8Context {
   // hardware constants
-  static constexpr int MEMORY_SIZE = 4096;
   static constexpr int START = 0x200;
-  static constexpr int WIDTH = 64;
+  static constexpr int WIDTH = 64; // the low resolution every platform has
   static constexpr int HEIGHT = 32;
+  static constexpr int HIRES_WIDTH = 128; // SUPER-CHIP and XO-CHIP
+  static constexpr int HIRES_HEIGHT = 64;
+  static constexpr int PLANE_COUNT = 2; // XO-CHIP bitplanes, the most of any
   static constexpr int STACK_SIZE = 16;
   static constexpr int REGISTER_COUNT = 16;
-  static constexpr int FREQUENCY = 432;
-
-private:
   static constexpr int KEYPAD_OPTIONS = 16;
-  static constexpr int SPRITE_WIDTH = 8;
+  static constexpr int FLAG_COUNT = 16;    // SUPER-CHIP has 8, XO-CHIP 16
+  static constexpr int PATTERN_SIZE = 16;  // bytes of an XO-CHIP pattern
+
+  /// @brief a range of display rows, empty if first >= end
+  struct DirtyRows {
+    uint8_t first = 0; // the first row written
+    uint8_t end = 0;   // one past the last row written
+  };
+
+  uint64_t display_generation = 0; // bumped on every display write
+  uint64_t cycle_accumulator = 0;  // progress towards the next instruction
+  uint64_t timer_accumulator = 0;  // progress towards the next timer tick
+  uint64_t cycle_count = 0;        // instructions executed since reset
+  uint64_t emulated_time = 0;      // nanoseconds advanced since reset
+  uint64_t rng_state = 1;          // xorshift64* state, never 0
+
+  std::array<uint16_t, STACK_SIZE> stack{}; // stores return addresses
+  uint16_t I = 0;      // stores memory addresses, use 12 lowest bits
+  uint16_t PC = START; // currently executing address
 
-  std::array<uint16_t, STACK_SIZE> stack{};     // stores return addresses
   std::array<uint8_t, REGISTER_COUNT> V{};      // registers 0 - F
   std::array<uint8_t, KEYPAD_OPTIONS> keypad{}; // status of keypad buttons
-  std::array<uint8_t, WIDTH * HEIGHT>
-      display_buffer{}; // pixel values, on or off
-  std::array<uint8_t, MEMORY_SIZE> memory{};
+  DirtyRows dirty_rows{0, HEIGHT}; // rows written since last cleared
+  uint8_t SP = 0;                  // topmost level of the stack
+  uint8_t DT = 0;                  // delay timer register
+  uint8_t ST = 0;                  // sound timer register, play if > 0
+  uint8_t target_register = 0;     // target register for input
+  uint8_t waiting_for_input = 0;   // program is waiting for input
+  uint8_t hires = 0;               // 128 x 64 instead of 64 x 32
+  uint8_t planes = 1;              // bit mask of the planes drawn to
+  uint8_t pitch = 64;              // FX3A, 64 plays patterns at 4000 Hz
+  uint8_t key_edge = 0; // 0x10 | a key pressed during FX0A, until it wakes
+  uint8_t fault = 0;    // the Chip8Fault the machine stopped on, if any
+};
+
+/// @brief the display of a platform and the state of the instructions it
+/// adds, sized so a machine only carries what its instructions can reach.
+/// one bit per pixel, msb is x = 0. each plane is PLANE_WORDS long and holds
+/// its rows back to back, one word each in low resolution and two in high
+/// resolution, so only the first rows of a plane are used in low resolution
+/// @tparam Instructions the instruction set of the platform
+template <InstructionSet Instructions> struct Chip8Extension;
+
+/// @brief the 64 x 32 display of the original instruction set
+template <> struct Chip8Extension<InstructionSet::CHIP8> {
+  static constexpr int PLANES = 1;
+  static constexpr int PLANE_WORDS = Chip8Context::HEIGHT;
+
+  std::array<uint64_t, PLANE_WORDS * PLANES> display{};
+};
+
+/// @brief SUPER-CHIP adds high resolution and the user flags
+template <> struct Chip8Extension<InstructionSet::SUPER_CHIP> {
+  static constexpr int PLANES = 1;
+  static constexpr int PLANE_WORDS =
+      Chip8Context::HIRES_WIDTH / 64 * Chip8Context::HIRES_HEIGHT;
+
+  std::array<uint64_t, PLANE_WORDS * PLANES> display{};
+  std::array<uint8_t, Chip8Context::FLAG_COUNT> flags{}; // FX75 and FX85
+};
+
+/// @brief XO-CHIP adds a second plane and the audio pattern
+template <> struct Chip8Extension<InstructionSet::XO_CHIP> {
+  static constexpr int PLANES = Chip8Context::PLANE_COUNT;
+  static constexpr int PLANE_WORDS =
+      Chip8Context::HIRES_WIDTH / 64 * Chip8Context::HIRES_HEIGHT;
+
+  std::array<uint64_t, PLANE_WORDS * PLANES> display{};
+  std::array<uint8_t, Chip8Context::FLAG_COUNT> flags{}; // FX75 and FX85
+  std::array<uint8_t, Chip8Context::PATTERN_SIZE> pattern{}; // F002
+};
+
+/// @brief the complete machine state of a Chip8 with a flat copy of its
+/// memory. trivially copyable so a snapshot is a plain copy
+/// @tparam Instructions the instruction set, which sizes the display
+/// @tparam MemorySize the bytes of memory
+template <InstructionSet Instructions, int MemorySize>
+struct BasicChip8State : Chip8Context, Chip8Extension<Instructions> {
+  std::array<uint8_t, MemorySize> memory{};
+};
 
-  uint16_t I = 0;                // stores memory addresses, use 12 lowest bits
-  uint16_t PC = START;           // currently executing address
-  uint8_t SP = 0;                // topmost level of the stack
-  uint8_t DT = 0;                // delay timer register
-  uint8_t ST = 0;                // sound timer register, play if > 0
-  uint8_t target_register = 0;   // target register for input
-  uint8_t waiting_for_input = 0; // program is waiting for input
+/// @brief the state of a chip8 machine with 4 KB of memory
+using Chip8State = BasicChip8State<InstructionSet::CHIP8, PagedMemory::SIZE>;
 
-  ///@brief loads the font data into the memory
-  void load_font_data();
+/// @brief the ways a Chip8 can execute instructions
+enum class Chip8Engine : uint8_t {
+  INTERPRETER,  // fetch, decode and execute every cycle, the reference
+  DECODE_CACHE, // reuse the decoded instruction from earlier visits to a PC
+  RECOMPILER,   // translate basic blocks into chains of handlers
+};
+
+/// @brief the ways a program can break the machine. the machine records the
+/// first one and stays on the instruction, the way 00FD stops it
+enum class Chip8Fault : uint8_t {
+  NONE,
+  STACK_OVERFLOW,  // 2NNN with every stack level in use
+  STACK_UNDERFLOW, // 00EE with nothing on the stack
+};
+
+/// @brief returns the name of a fault for reports
+/// @param fault the fault
+/// @return the name, such as "stack_overflow"
+const char *fault_name(Chip8Fault fault);
+
+/// @brief represents the chip8 virtual machine. the quirks are template
+/// parameters so each variant's opcodes compile without checking them.
+/// defined in chip8.cpp and instantiated there for every profile in
+/// quirks.hpp
+/// @tparam Quirks the behaviour to follow where interpreters differ
+template <Chip8Quirks Quirks>
+class BasicChip8 : private Chip8Context,
+                   private Chip8Extension<Quirks::INSTRUCTIONS> {
+  friend class Chip8Batch; // runs lanes through the private opcode methods
+
+public:
+  // hardware constants
+  using Chip8Context::HEIGHT;
+  using Chip8Context::HIRES_HEIGHT;
+  using Chip8Context::HIRES_WIDTH;
+  using Chip8Context::PLANE_COUNT;
+  using Chip8Context::REGISTER_COUNT;
+  using Chip8Context::STACK_SIZE;
+  using Chip8Context::START;
+  using Chip8Context::WIDTH;
+  static constexpr int MEMORY_SIZE =
+      Quirks::INSTRUCTIONS == InstructionSet::XO_CHIP ? 0x10000
+                                                      : PagedMemory::SIZE;
+  static constexpr int FREQUENCY = 432;
+  static constexpr int TIMER_RATE = 60;                // timer ticks per second
+  static constexpr int DEFAULT_INSTRUCTION_RATE = 600; // instructions a second
+  static constexpr uint64_t DEFAULT_SEED = 0; // every machine starts the same
+
+  using DirtyRows = Chip8Context::DirtyRows;
+
+  /// @brief a saved copy of the machine state
+  using Snapshot = BasicChip8State<Quirks::INSTRUCTIONS, MEMORY_SIZE>;
+
+  /// @brief the memory, shared with other machines until written
+  using Memory = BasicPagedMemory<MEMORY_SIZE, Quirks::MEMORY_WRAPS>;
+
+  /// @brief a complete memory image, START onwards holds the program
+  using MemoryImage = typename Memory::Image;
+
+  /// @brief the ways the Chip8 can execute instructions
+  using Engine = Chip8Engine;
+
+  /// @brief the ways a program can stop the Chip8
+  using Fault = Chip8Fault;
+
+  /// @brief the quirks this machine follows
+  using QuirkProfile = Quirks;
+
+private:
+  using Extension = Chip8Extension<Quirks::INSTRUCTIONS>;
+  using Extension::display;
+  static constexpr int PLANES = Extension::PLANES; // planes this one has
+  static constexpr int PLANE_WORDS = Extension::PLANE_WORDS;
+  // what get_display_rows returns for a plane the machine lacks
+  static constexpr std::array<uint64_t, PLANE_WORDS> BLANK_PLANE{};
+
+  static constexpr bool SUPER_CHIP_INSTRUCTIONS =
+      Quirks::INSTRUCTIONS != InstructionSet::CHIP8;
+  static constexpr bool XO_CHIP_INSTRUCTIONS =
+      Quirks::INSTRUCTIONS == InstructionSet::XO_CHIP;
+
+  static constexpr int SPRITE_WIDTH = 8;
+  static constexpr int MAX_SPRITE_HEIGHT = 16;
+  static constexpr int LARGE_SPRITE_SIZE = 16; // DXY0 is 16 x 16
+  static constexpr int FONT_HEIGHT = 5;
+  static constexpr int LARGE_FONT_ADDRESS = 0x50; // right after the font
+  static constexpr int LARGE_FONT_HEIGHT = 10;
+
+  /// @brief executes one decoded instruction
+  using Handler = void (*)(BasicChip8 &, const Instruction &);
+
+  /// @brief a decoded instruction along with the handler that executes it
+  struct CachedInstruction {
+    Handler handler = nullptr; // nullptr if the address is not decoded yet
+    Instruction instruction;
+  };
+
+  /// @brief a straight line run of instructions translated into a chain of
+  /// handlers, ends at the first instruction that can leave the sequence
+  struct Block {
+    std::vector<CachedInstruction> ops; // empty if not translated
+  };
+
+  static constexpr int MAX_BLOCK_LENGTH = 64; // instructions per block
+  static constexpr int MAX_IDLE_LOOP = 8;     // instructions per idle loop
+  static constexpr uint8_t UNKNOWN_LOOP = 0xFF; // loop length not looked at
+  // a fast forward costs about as much as executing this many passes
+  static constexpr int IDLE_SKIP_COST = 4;
+
+  /// @brief one pass around a loop at the PC, run on copies of the registers
+  /// it may write
+  struct IdleIteration {
+    std::array<uint8_t, REGISTER_COUNT> V{};
+    uint16_t I = 0;
+    uint8_t length = 0;                            // instructions executed
+    std::array<uint16_t, MAX_IDLE_LOOP> addresses; // of those instructions
+  };
+
+
+  /// @brief the handler of every opcode, indexed by Op
+  static const std::array<Handler, static_cast<size_t>(Op::COUNT)> HANDLERS;
+
+  // configuration, kept across reset and restore
+  uint32_t instruction_rate = DEFAULT_INSTRUCTION_RATE;
+  bool throttled = true; // run_for follows emulated time
+  uint64_t seed = DEFAULT_SEED; // reseeds the generator on reset
+  Engine engine = Engine::INTERPRETER;
+  bool idle_skipping = true; // run fast forwards loops that change nothing
+  uint64_t idle_cycles = 0;  // cycles fast forwarded since reset
+
+  // reads straight from the image it was loaded from, private copies are
+  // only made of the pages instructions write
+  Memory memory;
+
+  // the bytes instructions have written since construction, Chip8Batch
+  // uses it to tell when lanes may hold different code
+  uint32_t written_first = MEMORY_SIZE;
+  uint32_t written_end = 0;
+
+  std::vector<CachedInstruction> decode_cache; // indexed by address
+  std::vector<Block> blocks;                   // indexed by start address
+  // the shortest loop back to each address, 0 if there is none. saves
+  // running passes on most code. empty until the first idle check, so a
+  // machine with idle skipping off never allocates it
+  std::vector<uint8_t> idle_loops;
+
+  // while analyze_rom has proven no write reaches the code, writes skip
+  // invalidating translations. the byte the proof saw at each address of
+  // the code, -1 elsewhere, so a restore can tell whether it still holds
+  bool code_proven = false;
+  std::vector<int16_t> proven_code;
+
+#ifdef CHIP8_PROFILING
+  Profiler profiler{START}; // kept across reset and restore
+#endif
+
+  // buzzer edges are reported to tone if set, timed by the instruction that
+  // caused them. step_* describe the span advance is running, so an
+  // instruction's place in it gives its emulated time
+  ToneGenerator *tone = nullptr;
+  bool buzzer_on = false;      // the buzzer state tone last heard
+  bool buzzer_pending = false; // an FX18 the recompiler has not counted yet
+  bool in_step = false;        // advance is running instructions
+  uint64_t step_time = 0;        // emulated time at the start of the span
+  uint64_t step_cycle = 0;       // cycle count at the start of the span
+  uint64_t step_accumulator = 0; // cycle_accumulator at the start of the span
+
+  /// @brief loads the font data into the start of an image, followed by the
+  /// large font on SUPER-CHIP and XO-CHIP
+  /// @param image the image to write to
+  static void load_font_data(MemoryImage &image);
+
+  /// @brief returns the emulated time of the executing instruction, or of
+  /// the machine between instructions
+  /// @return the time in nanoseconds
+  uint64_t instruction_time() const;
+
+  /// @brief reports the buzzer to tone if it turned on or off
+  void report_buzzer();
+
+  /// @brief reports an FX18 the recompiler ran, once the cycle count has
+  /// caught up with the block it ended
+  void report_pending_buzzer() {
+    if (buzzer_pending) {
+      buzzer_pending = false;
+      report_buzzer();
+    }
+  }
+
+  /// @brief returns the words in a display row, 2 in high resolution
+  /// @return the words per row
+  int row_words() const {
+    if constexpr (SUPER_CHIP_INSTRUCTIONS) {
+      return hires ? 2 : 1;
+    }
+    return 1;
+  }
+
+  /// @brief returns the planes drawn to, only XO-CHIP can pick others
+  /// @return the bit mask of the planes
+  uint8_t selected_planes() const {
+    if constexpr (XO_CHIP_INSTRUCTIONS) {
+      return planes;
+    }
+    return 1;
+  }
+
+  /// @brief returns the length of the instruction at an address, a skip
+  /// jumps over all of it
+  /// @param address the address of the instruction
+  /// @return 4 for the XO-CHIP F000 NNNN, 2 otherwise
+  uint16_t instruction_length(uint16_t address) const {
+    if constexpr (XO_CHIP_INSTRUCTIONS) {
+      return memory.read_word(address) == 0xF000 ? 4 : 2;
+    }
+    return 2;
+  }
+
+  /// @brief advances a xorshift64* random number generator, inline so
+  /// Chip8Batch can vectorize it across lanes
+  /// @param state the generator state, never 0
+  /// @return the next random byte
+  static uint8_t next_random(uint64_t &state) {
+    state ^= state >> 12;
+    state ^= state << 25;
+    state ^= state >> 27;
+    return (state * 0x2545F4914F6CDD1Dull) >> 56; // the best mixed bits
+  }
+
+  /// @brief counts the instruction at the PC in the profiler, does nothing
+  /// unless built with CHIP8_PROFILING
+  void profile_instruction() {
+#ifdef CHIP8_PROFILING
+    profiler.count_instruction(
+        PC, decode(memory.read_word(PC), Quirks::INSTRUCTIONS).op);
+#endif
+  }
+
+  /// @brief records a write to a range of display rows
+  /// @param first the first row written
+  /// @param end one past the last row written
+  void mark_dirty(uint8_t first, uint8_t end);
 
   /// @brief jumps to a routine at nnn
   /// 0NNN
   /// @param address 0nnn
   void sys(uint16_t address);
 
-  /// @brief clears the screen
+  /// @brief clears the screen, only the selected planes on XO-CHIP
   /// 00E0
   void cls();
 
-  /// @brief returns from a subroutine
+  /// @brief stops the machine on the executing instruction with a fault,
+  /// unless it already stopped on one
+  /// @param what the fault
+  void raise_fault(Fault what);
+
+  /// @brief returns from a subroutine, faults on an empty stack
   /// 00EE
   void ret();
 
@@ -59,7 +386,7 @@ private:
   /// @param address 0nnn
   void jump(uint16_t address);
 
-  /// @brief calls the routine at nnn
+  /// @brief calls the routine at nnn, faults on a full stack
   /// 2NNN
   /// @param address 0nnn
   void call(uint16_t address);
@@ -100,19 +427,22 @@ private:
   /// @param register_y the register number, y in V_y
   void load_from_register_to_register(uint8_t register_x, uint8_t register_y);
 
-  /// @brief performs bitwise OR on V_x and V_y, stores in V_x
+  /// @brief performs bitwise OR on V_x and V_y, stores in V_x, clears
+  /// V_F with Quirks::LOGIC_RESETS_VF
   /// 8XY1
   /// @param register_x the register number, x in V_x
   /// @param register_y the register number, y in V_y
   void bitwise_or(uint8_t register_x, uint8_t register_y);
 
-  /// @brief performs bitwise AND on V_x and V_y, stores in V_x
+  /// @brief performs bitwise AND on V_x and V_y, stores in V_x, clears
+  /// V_F with Quirks::LOGIC_RESETS_VF
   /// 8XY2
   /// @param register_x the register number, x in V_x
   /// @param register_y the register number, y in V_y
   void bitwise_and(uint8_t register_x, uint8_t register_y);
 
-  /// @brief performs bitwise XOR on V_x and V_y, stores in V_x
+  /// @brief performs bitwise XOR on V_x and V_y, stores in V_x, clears
+  /// V_F with Quirks::LOGIC_RESETS_VF
   /// 8XY3
   /// @param register_x the register number, x in V_x
   /// @param register_y the register number, y in V_y
@@ -131,10 +461,12 @@ private:
   /// @param register_y the register number, y in V_y
   void subtract(uint8_t register_x, uint8_t register_y);
 
-  /// @brief stores V_x >> 1 in V_x, and the shifted bit in V_f
+  /// @brief stores V_x >> 1 in V_x, and the shifted bit in V_f. shifts V_y
+  /// instead with Quirks::SHIFT_USES_VY
   /// 8XY6
-  /// @param register_num the register number, x in V_x
-  void shift_right(uint8_t register_num);
+  /// @param register_x the register number, x in V_x
+  /// @param register_y the register number, y in V_y
+  void shift_right(uint8_t register_x, uint8_t register_y);
 
   /// @brief stores V_y - V_x in V_x, sets V_F to not borrow
   /// 8XY7
@@ -143,10 +475,12 @@ private:
   /// @param register_y the register number, y in V_y
   void reverse_subtract(uint8_t register_x, uint8_t register_y);
 
-  /// @brief stores V_x << 1 in V_x, and the shifted bit in V_f
+  /// @brief stores V_x << 1 in V_x, and the shifted bit in V_f. shifts V_y
+  /// instead with Quirks::SHIFT_USES_VY
   /// 8XYE
-  /// @param register_num the register number, x in V_x
-  void shift_left(uint8_t register_num);
+  /// @param register_x the register number, x in V_x
+  /// @param register_y the register number, y in V_y
+  void shift_left(uint8_t register_x, uint8_t register_y);
 
   /// @brief skips next instruction if V_x != V_y.
   /// 9XY0
@@ -159,7 +493,8 @@ private:
   /// @param address 0nnn
   void load_I(uint16_t address);
 
-  /// @brief jumps to location nnn + V_0
+  /// @brief jumps to location nnn + V_0, or nnn + V_x with
+  /// Quirks::JUMP_USES_VX
   /// BNNN
   /// @param address 0nnn
   void jump_off_register(uint16_t address);
@@ -171,11 +506,13 @@ private:
   void rand(uint8_t register_num, uint8_t byte);
 
   /// @brief displays n byte sprite starting at I at (V_x, V_y), V_F =
-  /// collision.
+  /// collision. wraps around the edges, or is cut off at them with
+  /// Quirks::CLIP_SPRITES. DXY0 draws a 16 x 16 sprite of 2 bytes a row on
+  /// SUPER-CHIP and XO-CHIP. on XO-CHIP each selected plane gets its own
+  /// sprite, stored one after the other from I
   /// DXYN
   /// @param register_x the x in V_x that contains the x coordinate
   /// @param register_y the y in V_y that contains the y coordinate
-  /// @param register_y the register number, y in V_y
   /// @param nibble the height of the sprite to draw
   void draw(uint8_t register_x, uint8_t register_y, uint8_t nibble);
 
@@ -195,7 +532,7 @@ private:
   void load_from_delay_timer(uint8_t register_num);
 
   /// @brief Enables waiting flag, and stores target register,
-  /// if a key from a previous call was not pressed
+  /// the PC stays on this instruction until a key is pressed
   /// FX0A
   /// @param register_num the register number, x in V_x
   void store_key_press(uint8_t register_num);
@@ -225,16 +562,97 @@ private:
   /// @param register_num the register number, x in V_x
   void write_binary_coded_decimal(uint8_t register_num);
 
-  /// @brief stores registers V_0 to V_x into memory, starting at I
+  /// @brief stores registers V_0 to V_x into memory, starting at I. I ends
+  /// up past the last byte with Quirks::LOAD_STORE_INCREMENTS_I
   /// FX55
   /// @param register_num the register number to stop at, x in V_x
   void store_memory_from_registers(uint8_t register_num);
 
-  /// @brief stores memory starting at I into V_0 to V_x
+  /// @brief stores memory starting at I into V_0 to V_x. I ends up past
+  /// the last byte with Quirks::LOAD_STORE_INCREMENTS_I
   /// FX65
   /// @param register_num the register number
   void store_registers_from_memory(uint8_t register_num);
 
+  /// @brief scrolls the selected planes down by n rows
+  /// 00CN
+  /// @param rows the number of rows
+  void scroll_down(uint8_t rows);
+
+  /// @brief scrolls the selected planes up by n rows
+  /// 00DN
+  /// @param rows the number of rows
+  void scroll_up(uint8_t rows);
+
+  /// @brief scrolls the selected planes right by 4 pixels
+  /// 00FB
+  void scroll_right();
+
+  /// @brief scrolls the selected planes left by 4 pixels
+  /// 00FC
+  void scroll_left();
+
+  /// @brief stops the program, the PC stays on this instruction
+  /// 00FD
+  void exit();
+
+  /// @brief switches to 64 x 32 and clears every plane
+  /// 00FE
+  void low_resolution();
+
+  /// @brief switches to 128 x 64 and clears every plane
+  /// 00FF
+  void high_resolution();
+
+  /// @brief stores registers V_x to V_y into memory starting at I, in
+  /// reverse order if x > y. I is left alone
+  /// 5XY2
+  /// @param register_x the register number, x in V_x
+  /// @param register_y the register number, y in V_y
+  void store_memory_from_register_range(uint8_t register_x,
+                                        uint8_t register_y);
+
+  /// @brief stores memory starting at I into registers V_x to V_y, in
+  /// reverse order if x > y. I is left alone
+  /// 5XY3
+  /// @param register_x the register number, x in V_x
+  /// @param register_y the register number, y in V_y
+  void store_register_range_from_memory(uint8_t register_x,
+                                        uint8_t register_y);
+
+  /// @brief loads the 16 bit word after the instruction into I and skips it
+  /// F000 NNNN
+  void load_I_long();
+
+  /// @brief selects the planes DXYN, 00E0 and the scrolls work on
+  /// FN01
+  /// @param mask the planes as a bit mask, n in FN01
+  void select_planes(uint8_t mask);
+
+  /// @brief loads the 16 bytes at I into the audio pattern
+  /// F002
+  void load_audio_pattern();
+
+  /// @brief sets I to the location of the large sprite of the digit in V_x
+  /// FX30
+  /// @param register_num the register number, x in V_x
+  void load_large_sprite(uint8_t register_num);
+
+  /// @brief sets the playback pitch of the audio pattern to V_x
+  /// FX3A
+  /// @param register_num the register number, x in V_x
+  void set_pitch(uint8_t register_num);
+
+  /// @brief stores registers V_0 to V_x in the user flags
+  /// FX75
+  /// @param register_num the register number to stop at, x in V_x
+  void store_flags_from_registers(uint8_t register_num);
+
+  /// @brief stores the user flags into V_0 to V_x
+  /// FX85
+  /// @param register_num the register number to stop at, x in V_x
+  void store_registers_from_flags(uint8_t register_num);
+
   /// @brief gets the 2 bytes at the program counter and ORS them
   /// @return the 2 bytes ORed together
   uint16_t fetch() const;
@@ -243,24 +661,270 @@ private:
   /// @param instruction the instruction to operate on
   void decode_and_execute(uint16_t instruction);
 
+  /// @brief executes the instruction at the PC through the decode cache,
+  /// decoding it first if this address has not been visited
+  void execute_cached();
+
+  /// @brief returns the emulated time left until the next timer tick
+  /// @return the nanoseconds until the next tick, rounded up
+  uint64_t nanoseconds_until_tick() const;
+
+  /// @brief runs the instructions that fall into a span of emulated time,
+  /// ticking the timers at exact 60 Hz boundaries along the way
+  /// @param nanoseconds the emulated time to advance by
+  void advance(uint64_t nanoseconds);
+
+  /// @brief finds the shortest way from an address back to a target
+  /// through instructions run_idle_iteration follows, over any choice of
+  /// skips
+  /// @param target the address to come back to
+  /// @param address the address of the next instruction
+  /// @param depth the most instructions left to follow
+  /// @return the instructions on the way, 0 if the target can't be reached
+  uint8_t loop_length(uint16_t target, uint16_t address, int depth) const;
+
+  /// @brief runs one pass of the loop at the PC on the registers of an
+  /// iteration. only instructions that read the timers, the keypad and
+  /// registers and write registers are followed, so until the next tick or
+  /// keypad change the pass repeats exactly
+  /// @param iteration the registers to start from, filled with the pass
+  /// @return true if the pass came back to the PC within MAX_IDLE_LOOP
+  /// instructions
+  bool run_idle_iteration(IdleIteration &iteration) const;
+
+  /// @brief fast forwards through cycles that can't change anything but the
+  /// cycle count: waiting in FX0A with no key pressed, or spinning in a
+  /// loop that reaches the same registers on every pass, such as polling DT
+  /// @param cycles the most cycles to skip
+  /// @return the number of cycles skipped, the rest are left to execute
+  uint64_t skip_idle(uint64_t cycles);
+
+  /// @brief resumes execution if a key was pressed while waiting in FX0A,
+  /// the key that went down first wins even if it is already back up
+  void check_key_press();
+
+  /// @brief translates the basic block starting at an address
+  /// @param address the address of the first instruction
+  /// @param block filled with the translated instructions
+  void translate_block(uint16_t address, Block &block);
+
+  /// @brief executes the block starting at the PC, translating it first if
+  /// needed, stops early once the cycle budget runs out
+  /// @param max_cycles the most instructions to execute
+  /// @return the number of instructions executed
+  uint64_t execute_block(uint64_t max_cycles);
+
+  /// @brief drops the cached instructions and blocks overlapping a written
+  /// range
+  /// @param address the first address that was written
+  /// @param length the number of bytes written
+  void invalidate_translations(uint16_t address, uint32_t length);
+
+  /// @brief analyzes the loaded program from the current state and
+  /// translates all the code it reaches for the engine, proving the code
+  /// static if no write can reach it
+  void prepare_translations();
+
+  /// @brief drops the proof of prepare_translations once an address outside
+  /// the code it covered is translated
+  /// @param address the address being translated
+  void check_proven(uint16_t address) {
+    if (code_proven && proven_code[address] < 0) {
+      code_proven = false;
+    }
+  }
+
+  /// @brief records a memory write made by an instruction, drops the
+  /// translations it overlaps and widens the written range
+  /// @param address the first address that was written
+  /// @param length the number of bytes written
+  void memory_written(uint16_t address, uint16_t length);
+
+  /// @brief memory_written for a range that does not wrap
+  /// @param first the first address written
+  /// @param end one past the last address written
+  void range_written(uint32_t first, uint32_t end);
+
 public:
   /// @brief default constructor, does not have defined memory
-  Chip8();
+  BasicChip8();
 
   /// @brief constructs a Chip8 with preloaded memory
   /// @param memory the memory to initialize with
-  explicit Chip8(const std::array<uint8_t, MEMORY_SIZE> &memory);
-
-  /// @brief replaces the Chip8's memory with the provided one
+  explicit BasicChip8(const std::array<uint8_t, MEMORY_SIZE> &memory);
+
+  /// @brief constructs a Chip8 that reads from a shared image
+  /// @param image the whole memory, see make_memory_image
+  explicit BasicChip8(std::shared_ptr<const MemoryImage> image);
+
+  /// @brief creates an image of zeros with the font data loaded, for the
+  /// program to be read into from START onwards
+  /// @return the image
+  static std::shared_ptr<MemoryImage> make_memory_image();
+
+  /// @brief creates an image with the font data loaded and a program copied
+  /// in at START
+  /// @param program the program, bytes past the end of memory are dropped
+  /// @return the image
+  static std::shared_ptr<MemoryImage>
+  make_memory_image(std::span<const uint8_t> program);
+
+  /// @brief replaces the Chip8's program memory with the provided one,
+  /// addresses from START onwards are copied, the font data is kept
   /// @param memory the new memory to use
   void load_into_memory(const std::array<uint8_t, MEMORY_SIZE> &memory);
 
+  /// @brief replaces the whole memory with a shared image without copying
+  /// it, any number of machines can share one image
+  /// @param image the whole memory, including the font data
+  void load_memory_image(std::shared_ptr<const MemoryImage> image);
+
+  /// @brief returns the memory this machine holds a private copy of, the
+  /// pages it has written
+  /// @return the number of private bytes
+  size_t get_private_memory() const;
+
   /// @brief performs one cpu tick
   void cycle();
 
-  /// @brief returns the display buffer, 64 x 32
-  /// @return the display buffer
-  const std::array<uint8_t, WIDTH * HEIGHT> &get_display_buffer() const;
+  /// @brief performs a number of cpu ticks, the recompiler runs whole blocks
+  /// at a time but never more instructions than asked for. idle cycles at
+  /// the start are skipped, see set_idle_skipping
+  /// @param cycles the number of ticks to perform
+  void run(uint64_t cycles);
+
+  /// @brief advances the machine by a span of host time. throttled, the
+  /// instruction rate and 60 Hz timers follow that time exactly. unthrottled,
+  /// whole frames run as fast as possible until the span has passed
+  /// @param elapsed the host time since the last call
+  void run_for(std::chrono::nanoseconds elapsed);
+
+  /// @brief runs whole frames, each ends with a timer tick
+  /// @param frames the number of frames to run
+  void run_frames(uint64_t frames);
+
+  /// @brief advances the emulated clock to a point in time, as fast as
+  /// possible and whether or not the machine is throttled
+  /// @param time the emulated time since reset to stop at
+  void run_until(std::chrono::nanoseconds time);
+
+  /// @brief returns the emulated time advanced since the last reset
+  /// @return the emulated time
+  std::chrono::nanoseconds get_emulated_time() const;
+
+  /// @brief decrements the delay and sound timers if they are above 0
+  void tick_timers();
+
+  /// @brief sets the number of instructions executed per emulated second
+  /// @param rate the instructions per second, at least 1
+  void set_instruction_rate(uint32_t rate);
+
+  /// @brief returns the number of instructions executed per emulated second
+  /// @return the instructions per second
+  uint32_t get_instruction_rate() const;
+
+  /// @brief switches run_for between following emulated time and running
+  /// flat out for fast forward and benchmarking
+  /// @param throttled true to follow emulated time
+  void set_throttled(bool throttled);
+
+  /// @brief returns whether run_for follows emulated time
+  /// @return true if throttled
+  bool is_throttled() const;
+
+  /// @brief returns the instructions executed since the last reset
+  /// @return the number of instructions executed
+  uint64_t get_cycle_count() const;
+
+  /// @brief switches fast forwarding through idle loops and FX0A waits, the
+  /// machine ends up in the same state either way
+  /// @param enabled true to skip idle cycles, the default
+  void set_idle_skipping(bool enabled);
+
+  /// @brief sends every edge of the buzzer to a generator from now on,
+  /// starting with the current state. copies of the machine share it, so
+  /// only one of them should run
+  /// @param tone the generator, nullptr to stop
+  void set_tone_generator(ToneGenerator *tone);
+
+  /// @brief returns whether run fast forwards through idle cycles
+  /// @return true if idle cycles are skipped
+  bool is_idle_skipping() const;
+
+  /// @brief returns the cycles fast forwarded since the last reset, counted
+  /// in get_cycle_count as well
+  /// @return the number of skipped cycles
+  uint64_t get_idle_cycles() const;
+
+  /// @brief seeds the random number generator used by CXNN, the same seed
+  /// gives the same sequence and is reused by reset
+  /// @param seed the seed, any value
+  void set_seed(uint64_t seed);
+
+  /// @brief returns the seed the generator was last seeded with
+  /// @return the seed
+  uint64_t get_seed() const;
+
+  /// @brief selects the engine used by cycle and run. the cache and the
+  /// recompiler start with the code analyze_rom finds already translated
+  /// @param engine the engine to execute with
+  void set_engine(Engine engine);
+
+  /// @brief returns the engine used by cycle and run
+  /// @return the engine used by cycle and run
+  Engine get_engine() const;
+
+  /// @brief returns whether the analysis of the loaded program proved it
+  /// never writes its own code, so writes skip invalidating translations.
+  /// only the cache and the recompiler analyze
+  /// @return true while the proof holds
+  bool is_code_static() const;
+
+  /// @brief returns the fault the program stopped the machine with. the PC
+  /// stays on the faulting instruction until reset or restore
+  /// @return Fault::NONE while the machine runs normally
+  Fault get_fault() const;
+
+  /// @brief unpacks the display at the current resolution into a buffer,
+  /// one byte per pixel holding a bit for each plane the pixel is on in.
+  /// allocates nothing, for callers that read it every frame
+  /// @param buffer filled row by row, at least get_display_width x
+  /// get_display_height bytes
+  /// @return false if the buffer is too small, it is left untouched then
+  bool get_display_buffer(std::span<uint8_t> buffer) const;
+
+  /// @brief returns the display buffer in a new vector, as the above. a
+  /// convenience that allocates on every call
+  /// @return the display buffer, get_display_width x get_display_height
+  std::vector<uint8_t> get_display_buffer() const;
+
+  /// @brief returns the rows of a plane, one 64 bit word per row in low
+  /// resolution and two in high resolution, the most significant bit is
+  /// the leftmost pixel
+  /// @param plane the plane, only XO-CHIP draws to plane 1, the others
+  /// return blank rows for it
+  /// @return the display rows
+  std::span<const uint64_t> get_display_rows(uint8_t plane = 0) const;
+
+  /// @brief returns the width of the display
+  /// @return WIDTH, or HIRES_WIDTH in high resolution
+  int get_display_width() const;
+
+  /// @brief returns the height of the display, what dirty rows count in
+  /// @return HEIGHT, or HIRES_HEIGHT in high resolution
+  int get_display_height() const;
+
+  /// @brief returns a counter that changes every time the display is written
+  /// @return the display generation
+  uint64_t get_display_generation() const;
+
+  /// @brief returns the display rows written since clear_dirty_rows, in
+  /// rows of the current resolution
+  /// @return the range of written rows
+  DirtyRows get_dirty_rows() const;
+
+  /// @brief marks every display row as clean, called once they are presented
+  void clear_dirty_rows();
 
   /// @brief returns the stack
   /// @return the stack
@@ -303,11 +967,52 @@ public:
   /// @param value the value to set the register to
   void set_ST(uint8_t value);
 
-  /// @brief sets the keypad value to the status value
+  /// @brief sets the keypad value to the status value. a press during FX0A
+  /// is latched, so a tap shorter than an instruction still wakes it
   /// @param keypad_num 0-F the keypad button number
   /// @param status the state of the button pressed, 0 or 1
   void set_keypad(uint8_t keypad_num, uint8_t status);
 
+  /// @brief returns a copy of the complete machine state
+  /// @return the snapshot
+  Snapshot snapshot() const;
+
+  /// @brief replaces the machine state with a snapshot, the engine and
+  /// scheduler settings are kept. unlike snapshot() this is not a plain
+  /// copy, it takes time linear in MEMORY_SIZE: memory is compared page by
+  /// page with the shared image, the code analyze_rom proved is compared
+  /// with the snapshot's, and every translation is dropped if that differs
+  /// @param snapshot the state to restore
+  void restore(const Snapshot &snapshot);
+
   /// @brief resets the state of the Chip8
   void reset();
+
+#ifdef CHIP8_PROFILING
+  /// @brief returns what the machine has executed since the profiler was
+  /// last cleared
+  /// @return the profiler
+  const Profiler &get_profiler() const;
+
+  /// @brief drops everything the profiler has counted
+  void clear_profiler();
+#endif
 };
+
+/// @brief the machine with the behaviour this emulator has always had
+using Chip8 = BasicChip8<DefaultQuirks>;
+
+extern template class BasicChip8<DefaultQuirks>;
+extern template class BasicChip8<CosmacVipQuirks>;
+extern template class BasicChip8<Chip48Quirks>;
+extern template class BasicChip8<SuperChipQuirks>;
+extern template class BasicChip8<XoChipQuirks>;
+
+static_assert(std::is_trivially_copyable_v<Chip8State>);
+// no padding, so equal states compare and hash equal byte for byte
+static_assert(std::has_unique_object_representations_v<Chip8Context>);
+static_assert(std::has_unique_object_representations_v<Chip8State>);
+static_assert(std::has_unique_object_representations_v<
+              BasicChip8<SuperChipQuirks>::Snapshot>);
+static_assert(std::has_unique_object_representations_v<
+              BasicChip8<XoChipQuirks>::Snapshot>);
@@ -0,0 +1,447 @@
+/// @file chip8_batch.cpp
+/// @brief implementation of the Chip8Batch class
+/// @author Abhay Manoj
+/// @date Oct 14 2026
+#include "chip8_batch.hpp"
+#include <algorithm>
+
+static constexpr uint64_t NANOSECONDS_PER_SECOND = 1'000'000'000;
+static constexpr uint32_t NO_LANE_PC = 0x10000; // above every 16 bit PC
+static constexpr size_t MIN_GROUP_SHARE = 4; // smaller groups run detached
+
+/// @brief returns whether an opcode only touches the structure of arrays
+/// registers, so it can run for every lane at once
+/// @param op the opcode
+/// @return true if Chip8Batch::execute_vector handles the opcode
+static bool is_vector_op(Op op) {
+  switch (op) {
+  case Op::SYS:
+  case Op::JUMP:
+  case Op::SKIP_NEXT_IF_EQUAL_BYTE:
+  case Op::SKIP_NEXT_IF_NOT_EQUAL_BYTE:
+  case Op::SKIP_NEXT_IF_EQUAL_REGISTERS:
+  case Op::LOAD_FROM_BYTE:
+  case Op::ADD:
+  case Op::LOAD_FROM_REGISTER_TO_REGISTER:
+  case Op::BITWISE_OR:
+  case Op::BITWISE_AND:
+  case Op::BITWISE_XOR:
+  case Op::ADD_AND_STORE_CARRY:
+  case Op::SUBTRACT:
+  case Op::SHIFT_RIGHT:
+  case Op::REVERSE_SUBTRACT:
+  case Op::SHIFT_LEFT:
+  case Op::SKIP_NEXT_IF_NOT_EQUAL_REGISTERS:
+  case Op::LOAD_I:
+  case Op::JUMP_OFF_REGISTER:
+  case Op::RAND:
+  case Op::LOAD_FROM_DELAY_TIMER:
+  case Op::SET_DELAY_TIMER:
+  case Op::SET_SOUND_TIMER:
+  case Op::ADD_I:
+  case Op::SKIP_IF_PRESSED:
+  case Op::SKIP_IF_NOT_PRESSED:
+  case Op::LOAD_SPRITE:
+  case Op::NOP:
+    return true;
+  default:
+    return false;
+  }
+}
+
+Chip8Batch::Chip8Batch(size_t lane_count,
+                       const std::array<uint8_t, Chip8::MEMORY_SIZE> &memory) {
+  // every lane reads the same image until it writes to it
+  auto image = Chip8::make_memory_image();
+  std::copy(memory.begin() + Chip8::START, memory.end(),
+            image->begin() + Chip8::START);
+  lanes.reserve(lane_count);
+  for (size_t i = 0; i < lane_count; i++) {
+    lanes.emplace_back(image);
+  }
+
+  for (auto &registers : V) {
+    registers.resize(lane_count);
+  }
+  I.resize(lane_count);
+  PC.resize(lane_count);
+  DT.resize(lane_count);
+  ST.resize(lane_count);
+  rng_state.resize(lane_count);
+  remaining.resize(lane_count);
+  active.resize(lane_count);
+
+  for (size_t i = 0; i < lane_count; i++) {
+    load_registers(i);
+  }
+}
+
+size_t Chip8Batch::size() const { return lanes.size(); }
+
+void Chip8Batch::set_seed(size_t lane, uint64_t seed) {
+  lanes[lane].set_seed(seed);
+  rng_state[lane] = lanes[lane].rng_state;
+}
+
+void Chip8Batch::set_keypad(size_t lane, uint8_t key, uint8_t status) {
+  lanes[lane].set_keypad(key, status);
+}
+
+void Chip8Batch::set_instruction_rate(uint32_t rate) {
+  instruction_rate = rate;
+}
+
+uint64_t Chip8Batch::get_cycle_count() const { return cycle_count; }
+
+const Chip8 &Chip8Batch::get_lane(size_t lane) {
+  Chip8 &cpu = lanes[lane];
+  flush_registers(lane);
+  cpu.instruction_rate = instruction_rate;
+  cpu.cycle_accumulator = cycle_accumulator;
+  cpu.timer_accumulator = timer_accumulator;
+  cpu.cycle_count = cycle_count;
+  cpu.emulated_time = emulated_time;
+  return cpu;
+}
+
+void Chip8Batch::flush_registers(size_t lane) {
+  Chip8 &cpu = lanes[lane];
+  for (size_t i = 0; i < Chip8::REGISTER_COUNT; i++) {
+    cpu.V[i] = V[i][lane];
+  }
+  cpu.I = I[lane];
+  cpu.PC = PC[lane];
+  cpu.DT = DT[lane];
+  cpu.ST = ST[lane];
+  cpu.rng_state = rng_state[lane];
+}
+
+void Chip8Batch::load_registers(size_t lane) {
+  const Chip8 &cpu = lanes[lane];
+  for (size_t i = 0; i < Chip8::REGISTER_COUNT; i++) {
+    V[i][lane] = cpu.V[i];
+  }
+  I[lane] = cpu.I;
+  PC[lane] = cpu.PC;
+  DT[lane] = cpu.DT;
+  ST[lane] = cpu.ST;
+  rng_state[lane] = cpu.rng_state;
+}
+
+uint16_t Chip8Batch::fetch(size_t lane, uint16_t address) const {
+  return lanes[lane].memory.read_word(address);
+}
+
+void Chip8Batch::run_frames(uint64_t frames) {
+  // mirrors Chip8::run_frames, one advance to the next tick per frame
+  for (uint64_t i = 0; i < frames; i++) {
+    uint64_t step = (NANOSECONDS_PER_SECOND - timer_accumulator +
+                     Chip8::TIMER_RATE - 1) /
+                    Chip8::TIMER_RATE;
+
+    cycle_accumulator += step * instruction_rate;
+    uint64_t cycles = cycle_accumulator / NANOSECONDS_PER_SECOND;
+    run_cycles(cycles);
+    cycle_count += cycles;
+    cycle_accumulator %= NANOSECONDS_PER_SECOND;
+
+    timer_accumulator += step * Chip8::TIMER_RATE;
+    if (timer_accumulator >= NANOSECONDS_PER_SECOND) {
+      timer_accumulator -= NANOSECONDS_PER_SECOND;
+      tick_timers();
+    }
+    emulated_time += step;
+  }
+}
+
+void Chip8Batch::run_cycles(uint32_t cycles) {
+  const size_t count = lanes.size();
+  std::fill(remaining.begin(), remaining.end(), cycles);
+  std::fill(active.begin(), active.end(), 0);
+
+  // raw pointers, so the byte stores can't be assumed to alias the vectors
+  uint32_t *left = remaining.data();
+  const uint8_t *a = active.data();
+  const uint16_t *lane_pc = PC.data();
+
+  while (true) {
+    // the lowest PC goes first, lanes split by a skip catch up and rejoin
+    uint32_t pc = NO_LANE_PC;
+    for (size_t i = 0; i < count; i++) {
+      left[i] -= a[i];
+      pc = std::min<uint32_t>(pc, left[i] != 0 ? lane_pc[i] : NO_LANE_PC);
+    }
+    if (pc == NO_LANE_PC) {
+      return;
+    }
+
+    size_t group = 0;
+    uint16_t raw = select_lanes(pc, group);
+    Instruction instruction = decode(raw);
+    if (group * MIN_GROUP_SHARE < count) {
+      // the lanes have spread out too far to pay for passes over all of
+      // them, every lane finishes the frame on its own
+      run_detached();
+      return;
+    } else if (is_vector_op(instruction.op)) {
+      execute_vector(instruction);
+    } else {
+      execute_scalar(raw);
+    }
+  }
+}
+
+uint16_t Chip8Batch::select_lanes(uint16_t pc, size_t &group) {
+  const size_t count = lanes.size();
+  const uint32_t *left = remaining.data();
+  const uint16_t *lane_pc = PC.data();
+  uint8_t *a = active.data();
+
+  size_t selected = 0;
+  for (size_t i = 0; i < count; i++) {
+    a[i] = left[i] != 0 && lane_pc[i] == pc;
+    selected += a[i];
+  }
+
+  size_t leader = std::find(active.begin(), active.end(), 1) - active.begin();
+  uint16_t raw = fetch(leader, pc);
+
+  // a lane may have overwritten the code here, only lanes that still hold
+  // the same instruction run together
+  if (static_cast<uint32_t>(pc) + 2 > written_first && pc < written_end) {
+    for (size_t i = 0; i < count; i++) {
+      if (active[i] && fetch(i, pc) != raw) {
+        active[i] = 0;
+        selected--;
+      }
+    }
+  }
+
+  group = selected;
+  return raw;
+}
+
+void Chip8Batch::execute_vector(const Instruction &instruction) {
+  const size_t count = lanes.size();
+  const uint8_t *a = active.data();
+  uint16_t *pc = PC.data();
+  uint16_t *index = I.data();
+  uint8_t *vx = V[instruction.x].data();
+  uint8_t *vy = V[instruction.y].data();
+  uint8_t *vf = V[0xF].data();
+  uint8_t *v0 = V[0x0].data();
+  uint8_t *dt = DT.data();
+  uint8_t *st = ST.data();
+  const uint8_t nn = instruction.nn;
+  const uint16_t nnn = instruction.nnn;
+
+  // the same semantics as the Chip8 opcode methods, in the same order so
+  // VF aliasing V_x or V_y gives the same result
+  for (size_t i = 0; i < count; i++) {
+    pc[i] += a[i] * 2;
+  }
+
+  switch (instruction.op) {
+  case Op::SYS:
+  case Op::JUMP:
+    for (size_t i = 0; i < count; i++) {
+      pc[i] = a[i] ? nnn & 0x0FFF : pc[i];
+    }
+    break;
+  case Op::SKIP_NEXT_IF_EQUAL_BYTE:
+    for (size_t i = 0; i < count; i++) {
+      pc[i] += (a[i] & (vx[i] == nn)) * 2;
+    }
+    break;
+  case Op::SKIP_NEXT_IF_NOT_EQUAL_BYTE:
+    for (size_t i = 0; i < count; i++) {
+      pc[i] += (a[i] & (vx[i] != nn)) * 2;
+    }
+    break;
+  case Op::SKIP_NEXT_IF_EQUAL_REGISTERS:
+    for (size_t i = 0; i < count; i++) {
+      pc[i] += (a[i] & (vx[i] == vy[i])) * 2;
+    }
+    break;
+  case Op::SKIP_NEXT_IF_NOT_EQUAL_REGISTERS:
+    for (size_t i = 0; i < count; i++) {
+      pc[i] += (a[i] & (vx[i] != vy[i])) * 2;
+    }
+    break;
+  case Op::LOAD_FROM_BYTE:
+    for (size_t i = 0; i < count; i++) {
+      vx[i] = a[i] ? nn : vx[i];
+    }
+    break;
+  case Op::ADD:
+    for (size_t i = 0; i < count; i++) {
+      vx[i] += a[i] ? nn : 0;
+    }
+    break;
+  case Op::LOAD_FROM_REGISTER_TO_REGISTER:
+    for (size_t i = 0; i < count; i++) {
+      vx[i] = a[i] ? vy[i] : vx[i];
+    }
+    break;
+  case Op::BITWISE_OR:
+    for (size_t i = 0; i < count; i++) {
+      vx[i] |= a[i] ? vy[i] : 0;
+    }
+    break;
+  case Op::BITWISE_AND:
+    for (size_t i = 0; i < count; i++) {
+      vx[i] &= a[i] ? vy[i] : 0xFF;
+    }
+    break;
+  case Op::BITWISE_XOR:
+    for (size_t i = 0; i < count; i++) {
+      vx[i] ^= a[i] ? vy[i] : 0;
+    }
+    break;
+  case Op::ADD_AND_STORE_CARRY:
+    for (size_t i = 0; i < count; i++) {
+      uint16_t sum = vx[i] + vy[i];
+      vx[i] = a[i] ? sum & 0xFF : vx[i];
+      vf[i] = a[i] ? sum > 0xFF : vf[i];
+    }
+    break;
+  case Op::SUBTRACT:
+    for (size_t i = 0; i < count; i++) {
+      uint8_t flag = vx[i] >= vy[i];
+      vx[i] = a[i] ? vx[i] - vy[i] : vx[i];
+      vf[i] = a[i] ? flag : vf[i];
+    }
+    break;
+  case Op::SHIFT_RIGHT:
+    for (size_t i = 0; i < count; i++) {
+      uint8_t flag = vx[i] & 1;
+      vx[i] = a[i] ? vx[i] >> 1 : vx[i];
+      vf[i] = a[i] ? flag : vf[i];
+    }
+    break;
+  case Op::REVERSE_SUBTRACT:
+    for (size_t i = 0; i < count; i++) {
+      uint8_t flag = vy[i] >= vx[i];
+      vx[i] = a[i] ? vy[i] - vx[i] : vx[i];
+      vf[i] = a[i] ? flag : vf[i];
+    }
+    break;
+  case Op::SHIFT_LEFT:
+    for (size_t i = 0; i < count; i++) {
+      uint8_t flag = (vx[i] >> 7) & 1;
+      vx[i] = a[i] ? vx[i] << 1 : vx[i];
+      vf[i] = a[i] ? flag : vf[i];
+    }
+    break;
+  case Op::LOAD_I:
+    for (size_t i = 0; i < count; i++) {
+      index[i] = a[i] ? nnn & 0xFFF : index[i];
+    }
+    break;
+  case Op::JUMP_OFF_REGISTER:
+    for (size_t i = 0; i < count; i++) {
+      pc[i] = a[i] ? v0[i] + nnn : pc[i];
+    }
+    break;
+  case Op::RAND:
+    for (size_t i = 0; i < count; i++) {
+      uint64_t state = rng_state[i];
+      uint8_t random = Chip8::next_random(state) & nn;
+      rng_state[i] = a[i] ? state : rng_state[i];
+      vx[i] = a[i] ? random : vx[i];
+    }
+    break;
+  case Op::SKIP_IF_PRESSED:
+    // the keypad stays in the lanes, a gather rather than a vector load
+    for (size_t i = 0; i < count; i++) {
+      pc[i] += (a[i] && lanes[i].keypad[vx[i] & 0xF]) * 2;
+    }
+    break;
+  case Op::SKIP_IF_NOT_PRESSED:
+    for (size_t i = 0; i < count; i++) {
+      pc[i] += (a[i] && !lanes[i].keypad[vx[i] & 0xF]) * 2;
+    }
+    break;
+  case Op::LOAD_FROM_DELAY_TIMER:
+    for (size_t i = 0; i < count; i++) {
+      vx[i] = a[i] ? dt[i] : vx[i];
+    }
+    break;
+  case Op::SET_DELAY_TIMER:
+    for (size_t i = 0; i < count; i++) {
+      dt[i] = a[i] ? vx[i] : dt[i];
+    }
+    break;
+  case Op::SET_SOUND_TIMER:
+    for (size_t i = 0; i < count; i++) {
+      st[i] = a[i] ? vx[i] : st[i];
+    }
+    break;
+  case Op::ADD_I:
+    for (size_t i = 0; i < count; i++) {
+      index[i] += a[i] ? vx[i] : 0;
+    }
+    break;
+  case Op::LOAD_SPRITE:
+    for (size_t i = 0; i < count; i++) {
+      index[i] = a[i] ? vx[i] * 5 : index[i];
+    }
+    break;
+  default:;
+  }
+}
+
+void Chip8Batch::execute_scalar(uint16_t raw) {
+  const size_t count = lanes.size();
+  for (size_t i = 0; i < count; i++) {
+    if (!active[i]) {
+      continue;
+    }
+
+    Chip8 &cpu = lanes[i];
+    flush_registers(i);
+
+    if (cpu.waiting_for_input) {
+      // the keypad can't change within a frame, so if no key is down yet
+      // the lane waits out the rest of it
+      cpu.check_key_press();
+      if (cpu.waiting_for_input) {
+        remaining[i] = 1;
+      }
+    } else {
+      cpu.PC += 2;
+      cpu.decode_and_execute(raw);
+    }
+
+    load_registers(i);
+    note_writes(i);
+  }
+}
+
+void Chip8Batch::run_detached() {
+  const size_t count = lanes.size();
+  for (size_t i = 0; i < count; i++) {
+    if (remaining[i] == 0) {
+      continue;
+    }
+
+    flush_registers(i);
+    lanes[i].run(remaining[i]);
+    load_registers(i);
+    note_writes(i);
+  }
+}
+
+void Chip8Batch::note_writes(size_t lane) {
+  const Chip8 &cpu = lanes[lane];
+  written_first = std::min(written_first, cpu.written_first);
+  written_end = std::max(written_end, cpu.written_end);
+}
+
+void Chip8Batch::tick_timers() {
+  const size_t count = lanes.size();
+  for (size_t i = 0; i < count; i++) {
+    DT[i] -= DT[i] > 0;
+    ST[i] -= ST[i] > 0;
+  }
+}
@@ -0,0 +1,129 @@
+/// @file chip8_batch.hpp
+/// @brief declaration of the Chip8Batch class
+/// @author Abhay Manoj
+/// @date Oct 14 2026
+#pragma once
+
+#include "chip8.hpp"
+#include "opcode.hpp"
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+/// @brief many copies of one rom run in lockstep. the registers of every lane
+/// are stored as structure of arrays, each step decodes one instruction and
+/// executes it for every lane at the same PC with loops the compiler can
+/// vectorize. when a skip splits the lanes, the lowest PC runs first so they
+/// meet again. instructions that touch the display, stack, keypad or memory
+/// run on a Chip8 per lane through the same opcode methods as Chip8 itself.
+/// once the lanes have split into groups too small to vectorize, they each
+/// finish the frame on their own Chip8
+class Chip8Batch {
+  std::vector<Chip8> lanes; // display, stack, memory and keypad of each lane
+
+  // the hot registers of every lane, index with [register][lane] or [lane]
+  std::array<std::vector<uint8_t>, Chip8::REGISTER_COUNT> V;
+  std::vector<uint16_t> I;
+  std::vector<uint16_t> PC;
+  std::vector<uint8_t> DT;
+  std::vector<uint8_t> ST;
+  std::vector<uint64_t> rng_state;
+
+  std::vector<uint32_t> remaining; // cycles each lane has left this frame
+  std::vector<uint8_t> active;     // 1 if the lane runs the current step
+
+  // the bytes any lane has written, an instruction outside them is the same
+  // in every lane
+  uint32_t written_first = Chip8::MEMORY_SIZE;
+  uint32_t written_end = 0;
+
+  // the scheduler, shared since every lane runs the same number of cycles
+  uint32_t instruction_rate = Chip8::DEFAULT_INSTRUCTION_RATE;
+  uint64_t cycle_accumulator = 0;
+  uint64_t timer_accumulator = 0;
+  uint64_t cycle_count = 0;
+  uint64_t emulated_time = 0;
+
+  /// @brief copies the hot registers of a lane into its Chip8
+  /// @param lane the index of the lane
+  void flush_registers(size_t lane);
+
+  /// @brief copies the hot registers of a lane back from its Chip8
+  /// @param lane the index of the lane
+  void load_registers(size_t lane);
+
+  /// @brief reads the instruction a lane would execute at an address
+  /// @param lane the index of the lane
+  /// @param address the address to read from
+  /// @return the 2 byte instruction
+  uint16_t fetch(size_t lane, uint16_t address) const;
+
+  /// @brief runs every lane for a number of cycles
+  /// @param cycles the cycles each lane runs
+  void run_cycles(uint32_t cycles);
+
+  /// @brief marks the lanes at a PC that will run the instruction there
+  /// @param pc the PC of the step
+  /// @param group filled with the number of lanes marked
+  /// @return the instruction the active lanes run
+  uint16_t select_lanes(uint16_t pc, size_t &group);
+
+  /// @brief executes an instruction for every active lane
+  /// @param instruction the decoded instruction
+  void execute_vector(const Instruction &instruction);
+
+  /// @brief executes an instruction lane by lane through Chip8
+  /// @param raw the 2 byte instruction
+  void execute_scalar(uint16_t raw);
+
+  /// @brief runs every lane with cycles left on its own Chip8 to the end of
+  /// the frame
+  void run_detached();
+
+  /// @brief widens the written range by the writes of a lane
+  /// @param lane the index of the lane
+  void note_writes(size_t lane);
+
+  /// @brief decrements the timers of every lane that are above 0
+  void tick_timers();
+
+public:
+  /// @brief creates lanes that all start from the same memory image
+  /// @param lane_count the number of lanes
+  /// @param memory the image loaded into every lane
+  Chip8Batch(size_t lane_count,
+             const std::array<uint8_t, Chip8::MEMORY_SIZE> &memory);
+
+  /// @brief returns the number of lanes
+  /// @return the number of lanes
+  size_t size() const;
+
+  /// @brief seeds the random number generator of one lane
+  /// @param lane the index of the lane
+  /// @param seed the seed, see Chip8::set_seed
+  void set_seed(size_t lane, uint64_t seed);
+
+  /// @brief sets the status of a key of one lane
+  /// @param lane the index of the lane
+  /// @param key the key, 0 - F
+  /// @param status 1 if pressed
+  void set_keypad(size_t lane, uint8_t key, uint8_t status);
+
+  /// @brief sets the instructions every lane executes per emulated second
+  /// @param rate the instructions per second
+  void set_instruction_rate(uint32_t rate);
+
+  /// @brief runs whole frames on every lane, matches Chip8::run_frames
+  /// @param frames the number of frames to run
+  void run_frames(uint64_t frames);
+
+  /// @brief returns the instructions each lane executed since construction
+  /// @return the number of instructions executed per lane
+  uint64_t get_cycle_count() const;
+
+  /// @brief brings the Chip8 of a lane up to date and returns it
+  /// @param lane the index of the lane
+  /// @return the machine of the lane
+  const Chip8 &get_lane(size_t lane);
+};
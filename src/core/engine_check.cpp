@@ -0,0 +1,247 @@
+/// @file engine_check.cpp
+/// @brief implementation of the differential runs in engine_check.hpp
+/// @author Abhay Manoj
+/// @date Oct 14 2026
+#include "engine_check.hpp"
+#include "chip8_batch.hpp"
+#include <cstdio>
+#include <cstring>
+#include <iterator>
+#include <optional>
+#include <type_traits>
+
+static constexpr uint32_t MAX_STEP_CYCLES = 64;
+static constexpr uint32_t MAX_STEPS = 128;
+static constexpr size_t HEADER_SIZE = 11; // step cycles, steps, seed, edges
+
+/// @brief a way of running the engines that is compared with the reference
+struct Contender {
+  const char *name;
+  Chip8Engine engine;
+  bool stepped; // one cycle call at a time with no idle skipping, else run
+};
+
+static constexpr Contender CONTENDERS[] = {
+    {"interpreter run", Chip8Engine::INTERPRETER, false},
+    {"decode cache", Chip8Engine::DECODE_CACHE, true},
+    {"decode cache run", Chip8Engine::DECODE_CACHE, false},
+    {"recompiler", Chip8Engine::RECOMPILER, true},
+    {"recompiler run", Chip8Engine::RECOMPILER, false},
+};
+
+EngineCheckCase parse_check_case(std::span<const uint8_t> data) {
+  EngineCheckCase test;
+  if (data.size() < HEADER_SIZE) {
+    test.program.assign(data.begin(), data.end());
+    test.steps = 1;
+    return test;
+  }
+
+  test.step_cycles = 1 + data[0] % MAX_STEP_CYCLES;
+  test.steps = 1 + data[1] % MAX_STEPS;
+  for (int i = 0; i < 8; i++) {
+    test.seed |= static_cast<uint64_t>(data[2 + i]) << (8 * i);
+  }
+
+  size_t edges = data[10] % 32;
+  size_t offset = HEADER_SIZE;
+  for (size_t i = 0; i < edges && offset + 2 <= data.size(); i++) {
+    uint8_t key = data[offset + 1];
+    test.events.push_back({data[offset] % test.steps,
+                           static_cast<uint8_t>(key & 0xF),
+                           (key & 0x10) != 0});
+    offset += 2;
+  }
+  test.program.assign(data.begin() + offset, data.end());
+  return test;
+}
+
+/// @brief names the first part of two states that differs
+/// @param a one state
+/// @param b the other
+/// @return the name, empty if the states are the same
+template <typename Snapshot>
+static std::string first_difference(const Snapshot &a, const Snapshot &b) {
+  char text[32];
+  if (a.PC != b.PC) {
+    return "PC";
+  }
+  if (a.I != b.I) {
+    return "I";
+  }
+  for (int i = 0; i < Chip8Context::REGISTER_COUNT; i++) {
+    if (a.V[i] != b.V[i]) {
+      std::snprintf(text, sizeof(text), "V%X", i);
+      return text;
+    }
+  }
+  if (a.SP != b.SP || a.stack != b.stack) {
+    return "stack";
+  }
+  if (a.fault != b.fault) {
+    return "fault";
+  }
+  if (a.DT != b.DT || a.ST != b.ST) {
+    return "timers";
+  }
+  if (a.waiting_for_input != b.waiting_for_input ||
+      a.target_register != b.target_register || a.key_edge != b.key_edge) {
+    return "key wait";
+  }
+  if (a.display != b.display || a.hires != b.hires || a.planes != b.planes) {
+    return "display";
+  }
+  for (size_t address = 0; address < a.memory.size(); address++) {
+    if (a.memory[address] != b.memory[address]) {
+      std::snprintf(text, sizeof(text), "memory 0x%04zX", address);
+      return text;
+    }
+  }
+  if (a.cycle_count != b.cycle_count) {
+    return "cycle count";
+  }
+  if (std::memcmp(&a, &b, sizeof(a)) != 0) {
+    return "other state";
+  }
+  return "";
+}
+
+/// @brief compares a machine with the reference and fills the mismatch if
+/// they differ
+/// @param reference the state of the reference
+/// @param cpu the machine compared with it
+/// @param name the name of the contender
+/// @param step the step just run
+/// @param mismatch filled on a difference
+/// @return true if the states are the same
+template <typename Snapshot, Chip8Quirks Quirks>
+static bool matches(const Snapshot &reference, const BasicChip8<Quirks> &cpu,
+                    const char *name, uint32_t step,
+                    EngineMismatch &mismatch) {
+  std::string field = first_difference(reference, cpu.snapshot());
+  if (field.empty()) {
+    return true;
+  }
+  mismatch = {name, step, field};
+  return false;
+}
+
+/// @brief applies the edges of a step to a machine
+/// @param events the edges of the case
+/// @param step the step about to run
+/// @param cpu the machine
+template <Chip8Quirks Quirks>
+static void apply_edges(const std::vector<InputEvent> &events, uint32_t step,
+                        BasicChip8<Quirks> &cpu) {
+  for (const InputEvent &event : events) {
+    if (event.time == step) {
+      cpu.set_keypad(event.key, event.pressed);
+    }
+  }
+}
+
+template <Chip8Quirks Quirks>
+bool check_engines(const EngineCheckCase &test, EngineMismatch &mismatch) {
+  using Machine = BasicChip8<Quirks>;
+  auto image = Machine::make_memory_image(test.program);
+  Machine reference(image);
+  reference.set_seed(test.seed);
+  reference.set_idle_skipping(false);
+
+  // step by cycles, the timers tick between steps
+  std::vector<Machine> machines(std::size(CONTENDERS), reference);
+  for (size_t i = 0; i < machines.size(); i++) {
+    machines[i].set_engine(CONTENDERS[i].engine);
+    machines[i].set_idle_skipping(!CONTENDERS[i].stepped);
+  }
+  for (uint32_t step = 0; step < test.steps; step++) {
+    apply_edges(test.events, step, reference);
+    for (uint32_t i = 0; i < test.step_cycles; i++) {
+      reference.cycle();
+    }
+    reference.tick_timers();
+    typename Machine::Snapshot expected = reference.snapshot();
+
+    for (size_t i = 0; i < machines.size(); i++) {
+      Machine &cpu = machines[i];
+      apply_edges(test.events, step, cpu);
+      if (CONTENDERS[i].stepped) {
+        for (uint32_t j = 0; j < test.step_cycles; j++) {
+          cpu.cycle();
+        }
+      } else {
+        cpu.run(test.step_cycles);
+      }
+      cpu.tick_timers();
+      if (!matches(expected, cpu, CONTENDERS[i].name, step, mismatch)) {
+        return false;
+      }
+    }
+  }
+
+  // step by frames on the scheduler, which splits them at timer ticks
+  Machine frame_reference(image);
+  frame_reference.set_seed(test.seed);
+  frame_reference.set_idle_skipping(false);
+  machines.assign(std::size(CONTENDERS), frame_reference);
+  for (size_t i = 0; i < machines.size(); i++) {
+    machines[i].set_engine(CONTENDERS[i].engine);
+    machines[i].set_idle_skipping(!CONTENDERS[i].stepped);
+  }
+
+  // the batch only runs the default machine. lane 1 has another seed and no
+  // input, so the lanes split apart
+  constexpr bool BATCHED = std::is_same_v<Quirks, DefaultQuirks>;
+  Machine quiet_reference = frame_reference;
+  quiet_reference.set_seed(test.seed + 1);
+  std::optional<Chip8Batch> batch;
+  if constexpr (BATCHED) {
+    batch.emplace(2, *image);
+    batch->set_seed(0, test.seed);
+    batch->set_seed(1, test.seed + 1);
+  }
+
+  for (uint32_t step = 0; step < test.steps; step++) {
+    apply_edges(test.events, step, frame_reference);
+    frame_reference.run_frames(1);
+    typename Machine::Snapshot expected = frame_reference.snapshot();
+
+    for (size_t i = 0; i < machines.size(); i++) {
+      apply_edges(test.events, step, machines[i]);
+      machines[i].run_frames(1);
+      if (!matches(expected, machines[i], CONTENDERS[i].name, step,
+                   mismatch)) {
+        mismatch.engine += " frames";
+        return false;
+      }
+    }
+
+    if constexpr (BATCHED) {
+      for (const InputEvent &event : test.events) {
+        if (event.time == step) {
+          batch->set_keypad(0, event.key, event.pressed);
+        }
+      }
+      quiet_reference.run_frames(1);
+      batch->run_frames(1);
+      if (!matches(expected, batch->get_lane(0), "batch lane 0", step,
+                   mismatch) ||
+          !matches(quiet_reference.snapshot(), batch->get_lane(1),
+                   "batch lane 1", step, mismatch)) {
+        return false;
+      }
+    }
+  }
+  return true;
+}
+
+template bool check_engines<DefaultQuirks>(const EngineCheckCase &,
+                                           EngineMismatch &);
+template bool check_engines<CosmacVipQuirks>(const EngineCheckCase &,
+                                             EngineMismatch &);
+template bool check_engines<Chip48Quirks>(const EngineCheckCase &,
+                                          EngineMismatch &);
+template bool check_engines<SuperChipQuirks>(const EngineCheckCase &,
+                                             EngineMismatch &);
+template bool check_engines<XoChipQuirks>(const EngineCheckCase &,
+                                          EngineMismatch &);
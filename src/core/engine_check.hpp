@@ -0,0 +1,64 @@
+/// @file engine_check.hpp
+/// @brief differential runs of one program through every execution engine
+/// @author Abhay Manoj
+/// @date Oct 14 2026
+#pragma once
+
+#include "chip8.hpp"
+#include "input_movie.hpp"
+#include "quirks.hpp"
+#include <cstdint>
+#include <span>
+#include <string>
+#include <vector>
+
+/// @brief a program and the input to run it with, usually made up by a
+/// fuzzer. the run is split into steps of a fixed number of cycles and the
+/// engines are compared after each one
+struct EngineCheckCase {
+  std::vector<uint8_t> program; // loaded at START
+  uint64_t seed = 0;
+  uint32_t step_cycles = 1; // cycles between comparisons
+  uint32_t steps = 0;
+  // the time of each edge is the step it is applied before
+  std::vector<InputEvent> events;
+};
+
+/// @brief where an engine first disagreed with the reference
+struct EngineMismatch {
+  std::string engine; // the engine and how it was driven
+  uint32_t step = 0;  // the step after which the states differed
+  std::string field;  // the first part of the state that differs
+};
+
+/// @brief decodes a case from arbitrary bytes, any input gives a valid one.
+/// the first byte picks the cycles per step, the second the steps, the next
+/// 8 the seed and the one after that the number of key edges, each taking 2
+/// bytes: the step and the key in the low nibble with the state in bit 4.
+/// the rest is the program
+/// @param data the bytes
+/// @return the case
+EngineCheckCase parse_check_case(std::span<const uint8_t> data);
+
+/// @brief runs a case through every engine and compares each with the
+/// interpreter stepped by cycle after every step. the cache and the
+/// recompiler run cycle by cycle and through run with idle skipping, then
+/// whole frames are compared the same way, along with Chip8Batch lanes for
+/// the default quirks
+/// @tparam Quirks the quirks of the machines
+/// @param test the case to run
+/// @param mismatch filled with the first disagreement, if any
+/// @return true if every engine matched the reference
+template <Chip8Quirks Quirks>
+bool check_engines(const EngineCheckCase &test, EngineMismatch &mismatch);
+
+extern template bool check_engines<DefaultQuirks>(const EngineCheckCase &,
+                                                  EngineMismatch &);
+extern template bool check_engines<CosmacVipQuirks>(const EngineCheckCase &,
+                                                    EngineMismatch &);
+extern template bool check_engines<Chip48Quirks>(const EngineCheckCase &,
+                                                 EngineMismatch &);
+extern template bool check_engines<SuperChipQuirks>(const EngineCheckCase &,
+                                                    EngineMismatch &);
+extern template bool check_engines<XoChipQuirks>(const EngineCheckCase &,
+                                                 EngineMismatch &);
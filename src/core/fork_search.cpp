@@ -0,0 +1,113 @@
+/// @file fork_search.cpp
+/// @brief implementation of the ForkSearch class
+/// @author Abhay Manoj
+/// @date Oct 14 2026
+#include "fork_search.hpp"
+#include <algorithm>
+
+template <Chip8Quirks Quirks>
+ForkSearch<Quirks>::ForkSearch(ThreadPool &pool, const Machine &parent)
+    : pool(pool), instruction_rate(parent.get_instruction_rate()),
+      idle_skipping(parent.is_idle_skipping()), engine(parent.get_engine()) {
+  set_checkpoint(parent.snapshot());
+}
+
+template <Chip8Quirks Quirks>
+void ForkSearch<Quirks>::set_checkpoint(const Snapshot &state) {
+  checkpoint = state;
+  // the machines keep their image while the memory matches it, and with it
+  // the translations of the code
+  if (!image || *image != state.memory) {
+    image = std::make_shared<typename Machine::MemoryImage>(state.memory);
+    prepared = 0;
+  }
+}
+
+template <Chip8Quirks Quirks>
+const typename ForkSearch<Quirks>::Snapshot &
+ForkSearch<Quirks>::get_checkpoint() const {
+  return checkpoint;
+}
+
+template <Chip8Quirks Quirks>
+void ForkSearch<Quirks>::prepare(Machine &machine) const {
+  // the interpreter skips analyzing the image before the state is restored
+  machine.set_engine(Chip8Engine::INTERPRETER);
+  machine.load_memory_image(image);
+  machine.set_instruction_rate(instruction_rate);
+  machine.set_idle_skipping(idle_skipping);
+  machine.restore(checkpoint);
+  machine.set_engine(engine);
+}
+
+template <Chip8Quirks Quirks>
+void ForkSearch<Quirks>::run_branch(Machine &machine, const KeySequence &keys,
+                                    uint32_t frames, const Reward &reward,
+                                    Result &result) const {
+  machine.restore(checkpoint);
+  uint16_t held = 0;
+  for (int key = 0; key < Chip8Context::KEYPAD_OPTIONS; key++) {
+    held |= (checkpoint.keypad[key] ? 1 : 0) << key;
+  }
+
+  for (uint32_t frame = 0; frame < frames; frame++) {
+    uint16_t next =
+        keys.empty() ? 0 : keys[std::min<size_t>(frame, keys.size() - 1)];
+    // only edges reach the machine, a held key does not press again
+    for (int key = 0; key < Chip8Context::KEYPAD_OPTIONS; key++) {
+      if ((held ^ next) >> key & 1) {
+        machine.set_keypad(key, next >> key & 1);
+      }
+    }
+    held = next;
+
+    uint64_t generation = machine.get_display_generation();
+    machine.run_frames(1);
+    if (machine.get_display_generation() != generation) {
+      result.display_changes++;
+    }
+    if (reward) {
+      result.reward += reward(machine);
+    }
+  }
+
+  result.state = machine.snapshot();
+  result.frame.resize(machine.get_display_width() *
+                      machine.get_display_height());
+  machine.get_display_buffer(result.frame);
+  result.private_memory = machine.get_private_memory();
+}
+
+template <Chip8Quirks Quirks>
+std::vector<typename ForkSearch<Quirks>::Result>
+ForkSearch<Quirks>::fork(std::span<const KeySequence> branches,
+                         uint32_t frames, const Reward &reward) {
+  std::vector<Result> results(branches.size());
+  size_t tasks = std::min(branches.size(), pool.size());
+  while (machines.size() < tasks) {
+    machines.push_back(std::make_unique<Machine>(image));
+  }
+
+  // a task per machine, each running every tasks'th branch, so no two
+  // workers touch the same machine
+  for (size_t task = 0; task < tasks; task++) {
+    pool.submit([this, task, tasks, branches, frames, &reward, &results] {
+      Machine &machine = *machines[task];
+      if (task >= prepared) {
+        prepare(machine);
+      }
+      for (size_t i = task; i < branches.size(); i += tasks) {
+        run_branch(machine, branches[i], frames, reward, results[i]);
+      }
+    });
+  }
+  pool.wait();
+  prepared = std::max(prepared, tasks);
+  return results;
+}
+
+template class ForkSearch<DefaultQuirks>;
+template class ForkSearch<CosmacVipQuirks>;
+template class ForkSearch<Chip48Quirks>;
+template class ForkSearch<SuperChipQuirks>;
+template class ForkSearch<XoChipQuirks>;
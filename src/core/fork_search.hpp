@@ -0,0 +1,108 @@
+/// @file fork_search.hpp
+/// @brief declaration of the ForkSearch class
+/// @author Abhay Manoj
+/// @date Oct 14 2026
+#pragma once
+
+#include "chip8.hpp"
+#include "quirks.hpp"
+#include "thread_pool.hpp"
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <span>
+#include <vector>
+
+/// @brief what one branch of a fork ended with
+/// @tparam Quirks the quirks of the machines
+template <Chip8Quirks Quirks> struct ForkResult {
+  // the child after its last frame, a checkpoint to search on from
+  typename BasicChip8<Quirks>::Snapshot state;
+  std::vector<uint8_t> frame; // get_display_buffer after the last frame
+  double reward = 0;          // the reward summed over every frame
+  uint32_t display_changes = 0; // frames that drew to the display
+  size_t private_memory = 0;    // bytes of memory the child did not share
+};
+
+/// @brief explores many input branches from one checkpoint. every child
+/// restores the checkpoint into a machine reading a shared image of its
+/// memory, so it only copies the pages it writes, then runs its own keypad
+/// sequence a frame at a time. the children are split across the workers of
+/// a thread pool, each keeping one machine whose translations survive from
+/// child to child and fork to fork while the code stays the same
+/// @tparam Quirks the quirks of the machines
+template <Chip8Quirks Quirks> class ForkSearch {
+public:
+  using Machine = BasicChip8<Quirks>;
+  using Snapshot = typename Machine::Snapshot;
+  using Result = ForkResult<Quirks>;
+
+  /// @brief the keys held through each frame of a branch, bit k for key k.
+  /// frames past the end hold the last entry, an empty one holds none
+  using KeySequence = std::vector<uint16_t>;
+
+  /// @brief scores a child after each of its frames, called from the pool
+  /// workers so it must be safe to call concurrently
+  using Reward = std::function<double(const Machine &)>;
+
+private:
+  ThreadPool &pool;
+  Snapshot checkpoint;
+  // the memory of the checkpoint, read by every child until it writes
+  std::shared_ptr<typename Machine::MemoryImage> image;
+
+  // the settings of the machine the search started from
+  uint32_t instruction_rate;
+  bool idle_skipping;
+  Chip8Engine engine;
+
+  // one per pool task, rebuilt when the checkpoint's memory changes
+  std::vector<std::unique_ptr<Machine>> machines;
+  size_t prepared = 0; // machines already reading the current image
+
+  /// @brief points a machine at the image and the checkpoint with the
+  /// settings of the search
+  /// @param machine the machine to prepare
+  void prepare(Machine &machine) const;
+
+  /// @brief runs one branch from the checkpoint
+  /// @param machine a prepared machine, left holding the child
+  /// @param keys the keys of each frame
+  /// @param frames the frames to run
+  /// @param reward scores each frame, may be empty
+  /// @param result filled with the outcome
+  void run_branch(Machine &machine, const KeySequence &keys, uint32_t frames,
+                  const Reward &reward, Result &result) const;
+
+public:
+  /// @brief starts a search from the current state of a machine, taking its
+  /// instruction rate, idle skipping and engine
+  /// @param pool runs the children, must outlive the search
+  /// @param parent the machine to fork
+  ForkSearch(ThreadPool &pool, const Machine &parent);
+
+  /// @brief moves the search to a new checkpoint, such as the state of a
+  /// child, keeping the settings
+  /// @param state the state to fork from
+  void set_checkpoint(const Snapshot &state);
+
+  /// @brief returns the state every fork starts from
+  /// @return the checkpoint
+  const Snapshot &get_checkpoint() const;
+
+  /// @brief runs every branch from the checkpoint in parallel and waits for
+  /// them to finish
+  /// @param branches the keypad sequence of each child
+  /// @param frames the frames each child runs
+  /// @param reward scores each frame of each child, may be empty
+  /// @return the outcome of each branch, in the order given
+  std::vector<Result> fork(std::span<const KeySequence> branches,
+                           uint32_t frames, const Reward &reward = {});
+};
+
+extern template class ForkSearch<DefaultQuirks>;
+extern template class ForkSearch<CosmacVipQuirks>;
+extern template class ForkSearch<Chip48Quirks>;
+extern template class ForkSearch<SuperChipQuirks>;
+extern template class ForkSearch<XoChipQuirks>;
@@ -0,0 +1,26 @@
+/// @file hash.hpp
+/// @brief 64 bit FNV-1a hashing used for state and frame comparisons
+/// @author Abhay Manoj
+/// @date Oct 14 2026
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+static constexpr uint64_t FNV_OFFSET_BASIS = 0xCBF29CE484222325ull;
+static constexpr uint64_t FNV_PRIME = 0x100000001B3ull;
+
+/// @brief folds a block of bytes into a running FNV-1a hash
+/// @param data the bytes to hash
+/// @param size the number of bytes
+/// @param hash the hash to continue from
+/// @return the updated hash
+inline uint64_t fnv1a(const void *data, size_t size,
+                      uint64_t hash = FNV_OFFSET_BASIS) {
+  const auto *bytes = static_cast<const uint8_t *>(data);
+  for (size_t i = 0; i < size; i++) {
+    hash ^= bytes[i];
+    hash *= FNV_PRIME;
+  }
+  return hash;
+}
@@ -0,0 +1,109 @@
+/// @file input_movie.cpp
+/// @brief implementation of input movie recording and replay
+/// @author Abhay Manoj
+/// @date Oct 14 2026
+#include "input_movie.hpp"
+#include "byte_stream.hpp"
+#include "hash.hpp"
+#include <cstring>
+#include <utility>
+
+static constexpr uint8_t PRESSED_BIT = 0x10;
+
+/// @brief writes a LEB128 varint
+/// @param out the stream to write to
+/// @param value the value to write
+static void put_varint(std::ostream &out, uint64_t value) {
+  while (value >= 0x80) {
+    out.put(static_cast<char>(value | 0x80));
+    value >>= 7;
+  }
+  out.put(static_cast<char>(value));
+}
+
+/// @brief reads a LEB128 varint
+/// @param in the stream to read from
+/// @param value filled with the value
+/// @return true if a complete varint of at most 64 bits was read
+static bool get_varint(std::istream &in, uint64_t &value) {
+  value = 0;
+  for (int shift = 0; shift < 64; shift += 7) {
+    int byte = in.get();
+    if (byte == std::char_traits<char>::eof()) {
+      return false;
+    }
+    value |= static_cast<uint64_t>(byte & 0x7F) << shift;
+    if ((byte & 0x80) == 0) {
+      return true;
+    }
+  }
+  return false;
+}
+
+uint64_t hash_rom(const std::array<uint8_t, Chip8::MEMORY_SIZE> &memory) {
+  return fnv1a(memory.data() + Chip8::START, memory.size() - Chip8::START);
+}
+
+void truncate_movie(InputMovie &movie, std::chrono::nanoseconds time) {
+  uint64_t end = time.count();
+  while (!movie.events.empty() && movie.events.back().time > end) {
+    movie.events.pop_back();
+  }
+  movie.length = end;
+}
+
+bool write_movie(std::ostream &out, const InputMovie &movie) {
+  out.write(MOVIE_MAGIC, sizeof(MOVIE_MAGIC));
+  put_le(out, MOVIE_VERSION, 4);
+  put_le(out, movie.seed, 8);
+  put_le(out, movie.instruction_rate, 4);
+  put_le(out, movie.rom_hash, 8);
+  put_le(out, movie.length, 8);
+  put_le(out, movie.events.size(), 4);
+
+  uint64_t previous = 0;
+  for (const InputEvent &event : movie.events) {
+    put_varint(out, event.time - previous);
+    out.put(static_cast<char>(event.key | (event.pressed ? PRESSED_BIT : 0)));
+    previous = event.time;
+  }
+  return static_cast<bool>(out);
+}
+
+bool read_movie(std::istream &in, InputMovie &movie) {
+  char magic[sizeof(MOVIE_MAGIC)];
+  if (!in.read(magic, sizeof(magic)) ||
+      std::memcmp(magic, MOVIE_MAGIC, sizeof(magic)) != 0) {
+    return false;
+  }
+
+  InputMovie loaded;
+  uint64_t version, instruction_rate, count;
+  if (!get_le(in, 4, version) || version != MOVIE_VERSION ||
+      !get_le(in, 8, loaded.seed) || !get_le(in, 4, instruction_rate) ||
+      !get_le(in, 8, loaded.rom_hash) || !get_le(in, 8, loaded.length) ||
+      !get_le(in, 4, count)) {
+    return false;
+  }
+  loaded.instruction_rate = instruction_rate;
+
+  uint64_t time = 0;
+  for (uint64_t i = 0; i < count; i++) {
+    uint64_t delta;
+    int byte;
+    if (!get_varint(in, delta) ||
+        (byte = in.get()) == std::char_traits<char>::eof() ||
+        (byte & ~(PRESSED_BIT | 0xF)) != 0) {
+      return false;
+    }
+    time += delta;
+    loaded.events.push_back({time, static_cast<uint8_t>(byte & 0xF),
+                             (byte & PRESSED_BIT) != 0});
+  }
+
+  if (time > loaded.length) {
+    return false;
+  }
+  movie = std::move(loaded);
+  return true;
+}
@@ -0,0 +1,103 @@
+/// @file input_movie.hpp
+/// @brief recording and replay of keypad input for deterministic runs
+/// @author Abhay Manoj
+/// @date Oct 14 2026
+#pragma once
+
+#include "chip8.hpp"
+#include <array>
+#include <chrono>
+#include <cstdint>
+#include <istream>
+#include <ostream>
+#include <vector>
+
+// a movie file is a header followed by one event per keypad edge. each event
+// is the emulated time since the previous event as a LEB128 varint and one
+// byte holding the key in the low nibble and the new state in bit 4. every
+// value is little endian
+static constexpr char MOVIE_MAGIC[4] = {'C', '8', 'M', 'V'};
+static constexpr uint32_t MOVIE_VERSION = 1; // bump on any format change
+
+/// @brief a keypad edge at a point in emulated time
+struct InputEvent {
+  uint64_t time = 0; // emulated nanoseconds since reset
+  uint8_t key = 0;   // 0 - F
+  bool pressed = false;
+};
+
+/// @brief the input needed to replay a session from reset
+struct InputMovie {
+  uint64_t seed = Chip8::DEFAULT_SEED;
+  uint32_t instruction_rate = Chip8::DEFAULT_INSTRUCTION_RATE;
+  uint64_t rom_hash = 0; // hash_rom of the rom the movie was recorded on
+  uint64_t length = 0;   // emulated nanoseconds the movie covers
+  std::vector<InputEvent> events; // in time order
+};
+
+/// @brief hashes the program part of a memory image
+/// @param memory the image passed to Chip8::load_into_memory
+/// @return the hash of everything from Chip8::START on
+uint64_t hash_rom(const std::array<uint8_t, Chip8::MEMORY_SIZE> &memory);
+
+/// @brief starts a new movie from the current seed and rate of a machine,
+/// the machine should have just been reset
+/// @param cpu the machine that will be recorded
+/// @param rom_hash the hash_rom of the loaded rom
+/// @return an empty movie
+template <Chip8Quirks Quirks>
+InputMovie start_movie(const BasicChip8<Quirks> &cpu, uint64_t rom_hash) {
+  InputMovie movie;
+  movie.seed = cpu.get_seed();
+  movie.instruction_rate = cpu.get_instruction_rate();
+  movie.rom_hash = rom_hash;
+  movie.length = cpu.get_emulated_time().count();
+  return movie;
+}
+
+/// @brief appends a keypad edge stamped with the emulated time of a machine
+/// @param movie the movie to record to
+/// @param cpu the machine being recorded
+/// @param key the key that changed, 0 - F
+/// @param pressed true if the key went down
+template <Chip8Quirks Quirks>
+void record_key(InputMovie &movie, const BasicChip8<Quirks> &cpu, uint8_t key,
+                bool pressed) {
+  uint64_t time = cpu.get_emulated_time().count();
+  movie.events.push_back({time, static_cast<uint8_t>(key & 0xF), pressed});
+  movie.length = time;
+}
+
+/// @brief drops the events after a point in time and ends the movie there,
+/// used when the recorded machine is rewound
+/// @param movie the movie to shorten
+/// @param time the emulated time of the restored state
+void truncate_movie(InputMovie &movie, std::chrono::nanoseconds time);
+
+/// @brief replays a movie from reset as fast as possible
+/// @param cpu a reset machine holding the recorded rom, with the quirks it
+/// was recorded with
+/// @param movie the movie to replay
+template <Chip8Quirks Quirks>
+void play_movie(BasicChip8<Quirks> &cpu, const InputMovie &movie) {
+  cpu.set_seed(movie.seed);
+  cpu.set_instruction_rate(movie.instruction_rate);
+
+  for (const InputEvent &event : movie.events) {
+    cpu.run_until(std::chrono::nanoseconds(event.time));
+    cpu.set_keypad(event.key, event.pressed);
+  }
+  cpu.run_until(std::chrono::nanoseconds(movie.length));
+}
+
+/// @brief writes a movie
+/// @param out the stream to write to
+/// @param movie the movie to write
+/// @return true if the whole movie was written
+bool write_movie(std::ostream &out, const InputMovie &movie);
+
+/// @brief reads a movie written by write_movie
+/// @param in the stream to read from
+/// @param movie filled with the movie, untouched on failure
+/// @return true if the header matched and every event was valid
+bool read_movie(std::istream &in, InputMovie &movie);
@@ -0,0 +1,65 @@
+/// @file input_queue.hpp
+/// @brief keypad edges stamped with host time, queued for the machine
+/// @author Abhay Manoj
+/// @date Oct 14 2026
+#pragma once
+
+#include "chip8.hpp"
+#include "input_movie.hpp"
+#include "spsc_queue.hpp"
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+
+/// @brief a lock free queue of keypad edges from the thread handling events
+/// to the one running the machine. each edge is applied at the emulated
+/// instant matching the host time it happened at, instead of between frames
+/// @tparam Capacity the most edges queued at once, a power of 2
+template <size_t Capacity> class InputQueue {
+  SpscQueue<InputEvent, Capacity> events; // times are host nanoseconds
+
+public:
+  /// @brief queues an edge, only for the producer
+  /// @param host_time the host nanoseconds the edge happened at, on the
+  /// clock passed to run_for as host_start
+  /// @param key the key that changed, 0 - F
+  /// @param pressed true if the key went down
+  /// @return false if the queue is full and the edge was dropped
+  bool push(uint64_t host_time, uint8_t key, bool pressed) {
+    return events.push({host_time, static_cast<uint8_t>(key & 0xF), pressed});
+  }
+
+  /// @brief advances a machine by a span of host time, applying every queued
+  /// edge at its offset into the span, only for the consumer. edges from
+  /// before the span land at its start and those after it at its end.
+  /// unthrottled the emulated span isn't known up front, so the edges are
+  /// all applied before it runs
+  /// @param cpu the machine
+  /// @param host_start the host time the span starts at
+  /// @param elapsed the host nanoseconds the span covers
+  /// @param movie if set, the edges are recorded to it as they are applied
+  template <Chip8Quirks Quirks>
+  void run_for(BasicChip8<Quirks> &cpu, uint64_t host_start, uint64_t elapsed,
+               InputMovie *movie = nullptr) {
+    uint64_t start = cpu.get_emulated_time().count();
+    InputEvent event;
+    while (events.pop(event)) {
+      uint64_t offset = event.time > host_start ? event.time - host_start : 0;
+      if (cpu.is_throttled()) {
+        cpu.run_until(
+            std::chrono::nanoseconds(start + std::min(offset, elapsed)));
+      }
+      if (movie) {
+        record_key(*movie, cpu, event.key, event.pressed);
+      }
+      cpu.set_keypad(event.key, event.pressed);
+    }
+
+    if (cpu.is_throttled()) {
+      cpu.run_until(std::chrono::nanoseconds(start + elapsed));
+    } else {
+      cpu.run_for(std::chrono::nanoseconds(elapsed));
+    }
+  }
+};
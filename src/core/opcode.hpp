@@ -0,0 +1,281 @@
+/// @file opcode.hpp
+/// @brief decoding of chip8 instructions into opcodes and operands
+/// @author Abhay Manoj
+/// @date Oct 14 2026
+#pragma once
+
+#include <cstdint>
+
+/// @brief the instructions a machine understands
+enum class InstructionSet : uint8_t {
+  CHIP8,      // only the original instructions
+  SUPER_CHIP, // adds hi-res, scrolling, 16 x 16 sprites and the large font
+  XO_CHIP,    // adds bitplanes, 64 KB of memory, long loads and audio
+};
+
+/// @brief every operation the Chip8 can execute, named after its handler
+enum class Op : uint8_t {
+  SYS,                              // 0NNN
+  CLS,                              // 00E0
+  RET,                              // 00EE
+  JUMP,                             // 1NNN
+  CALL,                             // 2NNN
+  SKIP_NEXT_IF_EQUAL_BYTE,          // 3XNN
+  SKIP_NEXT_IF_NOT_EQUAL_BYTE,      // 4XNN
+  SKIP_NEXT_IF_EQUAL_REGISTERS,     // 5XY0
+  LOAD_FROM_BYTE,                   // 6XNN
+  ADD,                              // 7XNN
+  LOAD_FROM_REGISTER_TO_REGISTER,   // 8XY0
+  BITWISE_OR,                       // 8XY1
+  BITWISE_AND,                      // 8XY2
+  BITWISE_XOR,                      // 8XY3
+  ADD_AND_STORE_CARRY,              // 8XY4
+  SUBTRACT,                         // 8XY5
+  SHIFT_RIGHT,                      // 8XY6
+  REVERSE_SUBTRACT,                 // 8XY7
+  SHIFT_LEFT,                       // 8XYE
+  SKIP_NEXT_IF_NOT_EQUAL_REGISTERS, // 9XY0
+  LOAD_I,                           // ANNN
+  JUMP_OFF_REGISTER,                // BNNN
+  RAND,                             // CXNN
+  DRAW,                             // DXYN
+  SKIP_IF_PRESSED,                  // EX9E
+  SKIP_IF_NOT_PRESSED,              // EXA1
+  LOAD_FROM_DELAY_TIMER,            // FX07
+  STORE_KEY_PRESS,                  // FX0A
+  SET_DELAY_TIMER,                  // FX15
+  SET_SOUND_TIMER,                  // FX18
+  ADD_I,                            // FX1E
+  LOAD_SPRITE,                      // FX29
+  WRITE_BINARY_CODED_DECIMAL,       // FX33
+  STORE_MEMORY_FROM_REGISTERS,      // FX55
+  STORE_REGISTERS_FROM_MEMORY,      // FX65
+  SCROLL_DOWN,                      // 00CN, SUPER-CHIP
+  SCROLL_UP,                        // 00DN, XO-CHIP
+  SCROLL_RIGHT,                     // 00FB, SUPER-CHIP
+  SCROLL_LEFT,                      // 00FC, SUPER-CHIP
+  EXIT,                             // 00FD, SUPER-CHIP
+  LOW_RESOLUTION,                   // 00FE, SUPER-CHIP
+  HIGH_RESOLUTION,                  // 00FF, SUPER-CHIP
+  STORE_MEMORY_FROM_REGISTER_RANGE, // 5XY2, XO-CHIP
+  STORE_REGISTER_RANGE_FROM_MEMORY, // 5XY3, XO-CHIP
+  LOAD_I_LONG,                      // F000 NNNN, XO-CHIP
+  SELECT_PLANES,                    // FN01, XO-CHIP
+  LOAD_AUDIO_PATTERN,               // F002, XO-CHIP
+  LOAD_LARGE_SPRITE,                // FX30, SUPER-CHIP
+  SET_PITCH,                        // FX3A, XO-CHIP
+  STORE_FLAGS_FROM_REGISTERS,       // FX75, SUPER-CHIP
+  STORE_REGISTERS_FROM_FLAGS,       // FX85, SUPER-CHIP
+  NOP,                              // anything not recognised
+  COUNT
+};
+
+/// @brief an instruction split into its opcode and operands
+struct Instruction {
+  Op op = Op::NOP;
+  uint8_t x = 0;    // second nibble
+  uint8_t y = 0;    // third nibble
+  uint8_t n = 0;    // final nibble
+  uint8_t nn = 0;   // second byte
+  uint16_t nnn = 0; // last 12 bits
+};
+
+/// @brief decodes the instructions SUPER-CHIP and XO-CHIP added, which all
+/// reuse encodings the original set gives another meaning or none
+/// @param instruction the 2 byte instruction
+/// @param set the instructions understood
+/// @return the opcode, Op::COUNT if the instruction is not an extension
+constexpr Op decode_extension(uint16_t instruction, InstructionSet set) {
+  if (set == InstructionSet::XO_CHIP) {
+    if ((instruction & 0xFFF0) == 0x00D0) {
+      return Op::SCROLL_UP;
+    } else if ((instruction & 0xF00F) == 0x5002) {
+      return Op::STORE_MEMORY_FROM_REGISTER_RANGE;
+    } else if ((instruction & 0xF00F) == 0x5003) {
+      return Op::STORE_REGISTER_RANGE_FROM_MEMORY;
+    } else if (instruction == 0xF000) {
+      return Op::LOAD_I_LONG;
+    } else if ((instruction & 0xF0FF) == 0xF001) {
+      return Op::SELECT_PLANES;
+    } else if (instruction == 0xF002) {
+      return Op::LOAD_AUDIO_PATTERN;
+    } else if ((instruction & 0xF0FF) == 0xF03A) {
+      return Op::SET_PITCH;
+    }
+  }
+
+  if (set != InstructionSet::CHIP8) {
+    if ((instruction & 0xFFF0) == 0x00C0) {
+      return Op::SCROLL_DOWN;
+    }
+    switch (instruction) {
+    case 0x00FB:
+      return Op::SCROLL_RIGHT;
+    case 0x00FC:
+      return Op::SCROLL_LEFT;
+    case 0x00FD:
+      return Op::EXIT;
+    case 0x00FE:
+      return Op::LOW_RESOLUTION;
+    case 0x00FF:
+      return Op::HIGH_RESOLUTION;
+    }
+    switch (instruction & 0xF0FF) {
+    case 0xF030:
+      return Op::LOAD_LARGE_SPRITE;
+    case 0xF075:
+      return Op::STORE_FLAGS_FROM_REGISTERS;
+    case 0xF085:
+      return Op::STORE_REGISTERS_FROM_FLAGS;
+    }
+  }
+  return Op::COUNT;
+}
+
+/// @brief decodes an instruction, mirrors Chip8::decode_and_execute
+/// @param instruction the 2 byte instruction
+/// @param set the instructions understood, the others decode as they do in
+/// the original set
+/// @return the opcode and operands of the instruction
+constexpr Instruction decode(uint16_t instruction,
+                             InstructionSet set = InstructionSet::CHIP8) {
+  Instruction decoded;
+  uint8_t type = (instruction & 0xF000) >> 12;
+  decoded.x = (instruction & 0xF00) >> 8;
+  decoded.y = (instruction & 0xF0) >> 4;
+  decoded.n = instruction & 0xF;
+  decoded.nn = instruction & 0xFF;
+  decoded.nnn = instruction & 0xFFF;
+
+  // unrecognised instructions must stay NOP, COUNT has no handler
+  Op extension = decode_extension(instruction, set);
+  if (extension != Op::COUNT) {
+    decoded.op = extension;
+    return decoded;
+  }
+
+  switch (type) {
+  case 0x0:
+    if (decoded.nn == 0xE0) {
+      decoded.op = Op::CLS;
+    } else if (decoded.nn == 0xEE) {
+      decoded.op = Op::RET;
+    } else {
+      decoded.op = Op::SYS;
+    }
+    break;
+  case 0x1:
+    decoded.op = Op::JUMP;
+    break;
+  case 0x2:
+    decoded.op = Op::CALL;
+    break;
+  case 0x3:
+    decoded.op = Op::SKIP_NEXT_IF_EQUAL_BYTE;
+    break;
+  case 0x4:
+    decoded.op = Op::SKIP_NEXT_IF_NOT_EQUAL_BYTE;
+    break;
+  case 0x5:
+    decoded.op = Op::SKIP_NEXT_IF_EQUAL_REGISTERS;
+    break;
+  case 0x6:
+    decoded.op = Op::LOAD_FROM_BYTE;
+    break;
+  case 0x7:
+    decoded.op = Op::ADD;
+    break;
+  case 0x8:
+    switch (decoded.n) {
+    case 0x0:
+      decoded.op = Op::LOAD_FROM_REGISTER_TO_REGISTER;
+      break;
+    case 0x1:
+      decoded.op = Op::BITWISE_OR;
+      break;
+    case 0x2:
+      decoded.op = Op::BITWISE_AND;
+      break;
+    case 0x3:
+      decoded.op = Op::BITWISE_XOR;
+      break;
+    case 0x4:
+      decoded.op = Op::ADD_AND_STORE_CARRY;
+      break;
+    case 0x5:
+      decoded.op = Op::SUBTRACT;
+      break;
+    case 0x6:
+      decoded.op = Op::SHIFT_RIGHT;
+      break;
+    case 0x7:
+      decoded.op = Op::REVERSE_SUBTRACT;
+      break;
+    case 0xE:
+      decoded.op = Op::SHIFT_LEFT;
+      break;
+    default:;
+    }
+    break;
+  case 0x9:
+    decoded.op = Op::SKIP_NEXT_IF_NOT_EQUAL_REGISTERS;
+    break;
+  case 0xA:
+    decoded.op = Op::LOAD_I;
+    break;
+  case 0xB:
+    decoded.op = Op::JUMP_OFF_REGISTER;
+    break;
+  case 0xC:
+    decoded.op = Op::RAND;
+    break;
+  case 0xD:
+    decoded.op = Op::DRAW;
+    break;
+  case 0xE:
+    decoded.op =
+        decoded.n == 0xE ? Op::SKIP_IF_PRESSED : Op::SKIP_IF_NOT_PRESSED;
+    break;
+  case 0xF:
+    switch (decoded.n) {
+    case 0x3:
+      decoded.op = Op::WRITE_BINARY_CODED_DECIMAL;
+      break;
+    case 0x5:
+      switch (decoded.y) {
+      case 0x1:
+        decoded.op = Op::SET_DELAY_TIMER;
+        break;
+      case 0x5:
+        decoded.op = Op::STORE_MEMORY_FROM_REGISTERS;
+        break;
+      case 0x6:
+        decoded.op = Op::STORE_REGISTERS_FROM_MEMORY;
+        break;
+      default:;
+      }
+      break;
+    case 0x7:
+      decoded.op = Op::LOAD_FROM_DELAY_TIMER;
+      break;
+    case 0x8:
+      decoded.op = Op::SET_SOUND_TIMER;
+      break;
+    case 0x9:
+      decoded.op = Op::LOAD_SPRITE;
+      break;
+    case 0xA:
+      decoded.op = Op::STORE_KEY_PRESS;
+      break;
+    case 0xE:
+    case 0xF:
+      decoded.op = Op::ADD_I;
+      break;
+    default:;
+    }
+    break;
+  default:;
+  }
+
+  return decoded;
+}
@@ -0,0 +1,131 @@
+/// @file paged_memory.cpp
+/// @brief implementation of the BasicPagedMemory class template
+/// @author Abhay Manoj
+/// @date Oct 14 2026
+#include "paged_memory.hpp"
+#include <algorithm>
+#include <cstring>
+#include <utility>
+
+/// @brief returns an image of all zeros shared by every blank memory
+/// @tparam Size the bytes of memory
+/// @return the blank image
+template <int Size>
+static const std::shared_ptr<const typename BasicPagedMemory<Size>::Image> &
+blank_image() {
+  static const auto blank =
+      std::make_shared<const typename BasicPagedMemory<Size>::Image>();
+  return blank;
+}
+
+template <int Size, bool Wraps>
+BasicPagedMemory<Size, Wraps>::BasicPagedMemory()
+    : BasicPagedMemory(blank_image<Size>()) {}
+
+template <int Size, bool Wraps>
+BasicPagedMemory<Size, Wraps>::BasicPagedMemory(
+    std::shared_ptr<const Image> image)
+    : image(std::move(image)) {
+  map_image();
+}
+
+template <int Size, bool Wraps>
+BasicPagedMemory<Size, Wraps>::BasicPagedMemory(const BasicPagedMemory &other)
+    : image(other.image) {
+  map_image();
+  // what was written to the guard region is gone anyway, it isn't copied
+  for (size_t i = 0; i < PAGE_COUNT; i++) {
+    if (other.owned[i]) {
+      owned[i] = std::make_unique<Page>(*other.owned[i]);
+      pages[i] = owned[i]->data();
+    }
+  }
+}
+
+template <int Size, bool Wraps>
+BasicPagedMemory<Size, Wraps> &
+BasicPagedMemory<Size, Wraps>::operator=(const BasicPagedMemory &other) {
+  if (this != &other) {
+    *this = BasicPagedMemory(other);
+  }
+  return *this;
+}
+
+template <int Size, bool Wraps>
+void BasicPagedMemory<Size, Wraps>::map_image() {
+  static const Page zeros{};
+  for (size_t i = 0; i < TABLE_PAGES; i++) {
+    pages[i] = i < PAGE_COUNT ? image->data() + i * PAGE_SIZE : zeros.data();
+  }
+}
+
+template <int Size, bool Wraps>
+uint8_t *BasicPagedMemory<Size, Wraps>::make_private(size_t page) {
+  owned[page] = std::make_unique<Page>();
+  if (page < PAGE_COUNT) {
+    std::memcpy(owned[page]->data(), pages[page], PAGE_SIZE);
+    pages[page] = owned[page]->data();
+  }
+  return owned[page]->data();
+}
+
+template <int Size, bool Wraps>
+void BasicPagedMemory<Size, Wraps>::write(uint16_t address,
+                                          const uint8_t *bytes,
+                                          uint16_t length) {
+  // counted past 16 bits, a run off the end of the table must not carry on
+  // from page 0
+  uint32_t position = address;
+  while (length > 0) {
+    if (!Wraps && position > ADDRESS_MASK) {
+      return; // the guard region ends with the table, the rest is dropped
+    }
+    position &= ADDRESS_MASK;
+    size_t page = position / PAGE_SIZE;
+    uint16_t offset = position % PAGE_SIZE;
+    uint16_t count = std::min<uint16_t>(length, PAGE_SIZE - offset);
+    uint8_t *target = owned[page] ? owned[page]->data() : make_private(page);
+    // runs are a few bytes, a loop beats the setup cost of memcpy
+    for (uint16_t i = 0; i < count; i++) {
+      target[offset + i] = bytes[i];
+    }
+    position += count;
+    bytes += count;
+    length -= count;
+  }
+}
+
+template <int Size, bool Wraps>
+void BasicPagedMemory<Size, Wraps>::copy_to(Image &out) const {
+  for (size_t i = 0; i < PAGE_COUNT; i++) {
+    std::memcpy(out.data() + i * PAGE_SIZE, pages[i], PAGE_SIZE);
+  }
+}
+
+template <int Size, bool Wraps>
+void BasicPagedMemory<Size, Wraps>::assign(const Image &in) {
+  for (size_t i = 0; i < PAGE_COUNT; i++) {
+    const uint8_t *source = in.data() + i * PAGE_SIZE;
+    const uint8_t *shared = image->data() + i * PAGE_SIZE;
+    if (std::memcmp(pages[i], source, PAGE_SIZE) == 0) {
+      continue;
+    }
+    if (std::memcmp(shared, source, PAGE_SIZE) == 0) {
+      owned[i].reset();
+      pages[i] = shared;
+    } else {
+      std::memcpy(owned[i] ? owned[i]->data() : make_private(i), source,
+                  PAGE_SIZE);
+    }
+  }
+}
+
+template <int Size, bool Wraps>
+size_t BasicPagedMemory<Size, Wraps>::get_private_pages() const {
+  return std::count_if(owned.begin(), owned.begin() + PAGE_COUNT,
+                       [](const auto &page) { return page != nullptr; });
+}
+
+template class BasicPagedMemory<4096, true>;
+template class BasicPagedMemory<4096, false>;
+template class BasicPagedMemory<65536, true>;
@@ -0,0 +1,131 @@
+/// @file paged_memory.hpp
+/// @brief declaration of the BasicPagedMemory class template and PagedMemory
+/// @author Abhay Manoj
+/// @date Oct 14 2026
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+
+/// @brief chip8 memory split into pages that are shared until written. every
+/// machine loaded from the same image reads it in place, the first write to a
+/// page gives the machine a private copy of just that page. a copy of a
+/// PagedMemory shares the image and copies the private pages. addresses wrap
+/// at SIZE, or past it the 16 bit address space is a guard region that
+/// reads as zeros and drops writes. either way every access is a mask and a
+/// page table lookup, without a bounds check. defined in paged_memory.cpp and
+/// instantiated there for the chip8 and XO-CHIP sizes
+/// @tparam Size the bytes of memory, a power of 2 up to 64 KB
+/// @tparam Wraps true if addresses past the end wrap around to 0
+template <int Size, bool Wraps = true> class BasicPagedMemory {
+public:
+  static constexpr int SIZE = Size;
+  static constexpr int PAGE_SIZE = 256;
+  static constexpr int PAGE_COUNT = SIZE / PAGE_SIZE;
+  // every address is masked with this, past SIZE is the guard region
+  static constexpr uint16_t ADDRESS_MASK = Wraps ? SIZE - 1 : 0xFFFF;
+  static constexpr int TABLE_PAGES = (ADDRESS_MASK + 1) / PAGE_SIZE;
+
+  /// @brief a complete memory image
+  using Image = std::array<uint8_t, SIZE>;
+
+private:
+  using Page = std::array<uint8_t, PAGE_SIZE>;
+
+  std::shared_ptr<const Image> image; // never written
+  // nullptr if shared. a guard page gets a scratch page its writes land in,
+  // which reads never see
+  std::array<std::unique_ptr<Page>, TABLE_PAGES> owned;
+  std::array<const uint8_t *, TABLE_PAGES> pages; // what reads see
+
+  /// @brief points the reads of every page at the image, and of the guard
+  /// region at zeros
+  void map_image();
+
+  /// @brief gives this memory its own copy of a page, or a scratch page for
+  /// a guard page
+  /// @param page the index of the page
+  /// @return the writable bytes of the page
+  uint8_t *make_private(size_t page);
+
+public:
+  /// @brief creates a memory of all zeros
+  BasicPagedMemory();
+
+  /// @brief creates a memory that reads from a shared image
+  /// @param image the image, kept alive for as long as any page uses it
+  explicit BasicPagedMemory(std::shared_ptr<const Image> image);
+
+  /// @brief copies a memory, sharing its image and copying its private pages
+  /// @param other the memory to copy
+  BasicPagedMemory(const BasicPagedMemory &other);
+
+  /// @brief copies a memory, sharing its image and copying its private pages
+  /// @param other the memory to copy
+  /// @return this memory
+  BasicPagedMemory &operator=(const BasicPagedMemory &other);
+
+  BasicPagedMemory(BasicPagedMemory &&) = default;
+  BasicPagedMemory &operator=(BasicPagedMemory &&) = default;
+
+  /// @brief reads a byte
+  /// @param address the address, see ADDRESS_MASK
+  /// @return the byte at the address
+  uint8_t operator[](uint16_t address) const {
+    address &= ADDRESS_MASK;
+    return pages[address / PAGE_SIZE][address % PAGE_SIZE];
+  }
+
+  /// @brief reads a big endian 2 byte word
+  /// @param address the address of the high byte, see ADDRESS_MASK
+  /// @return the word at the address
+  uint16_t read_word(uint16_t address) const {
+    address &= ADDRESS_MASK;
+    const uint8_t *page = pages[address / PAGE_SIZE];
+    uint16_t offset = address % PAGE_SIZE;
+    if (offset == PAGE_SIZE - 1) {
+      return (page[offset] << 8) | (*this)[address + 1];
+    }
+    return (page[offset] << 8) | page[offset + 1];
+  }
+
+  /// @brief writes a byte, copying its page first if it is shared
+  /// @param address the address, see ADDRESS_MASK
+  /// @param value the byte to write
+  void write(uint16_t address, uint8_t value) {
+    address &= ADDRESS_MASK;
+    Page *page = owned[address / PAGE_SIZE].get();
+    uint8_t *bytes =
+        page != nullptr ? page->data() : make_private(address / PAGE_SIZE);
+    bytes[address % PAGE_SIZE] = value;
+  }
+
+  /// @brief writes a run of bytes, copying the pages it lands in first if
+  /// they are shared
+  /// @param address the address of the first byte, see ADDRESS_MASK
+  /// @param bytes the bytes to write
+  /// @param length the number of bytes, at most SIZE
+  void write(uint16_t address, const uint8_t *bytes, uint16_t length);
+
+  /// @brief copies the whole memory out
+  /// @param out filled with every byte
+  void copy_to(Image &out) const;
+
+  /// @brief replaces the whole memory. pages that match the shared image go
+  /// back to reading it, only pages that differ from it stay private
+  /// @param in the bytes to load
+  void assign(const Image &in);
+
+  /// @brief returns the number of pages this memory holds a copy of
+  /// @return the number of private pages
+  size_t get_private_pages() const;
+};
+
+/// @brief the 4 KB memory of chip8 and SUPER-CHIP
+using PagedMemory = BasicPagedMemory<4096>;
+
+extern template class BasicPagedMemory<4096, true>;
+extern template class BasicPagedMemory<4096, false>;
+extern template class BasicPagedMemory<65536, true>;
@@ -0,0 +1,193 @@
+/// @file profiler.cpp
+/// @brief implementation of the Profiler class
+/// @author Abhay Manoj
+/// @date Oct 14 2026
+#include "profiler.hpp"
+#include <algorithm>
+#include <cinttypes>
+#include <cstdio>
+#include <iterator>
+#include <string>
+
+// the names of the opcodes in the json, in the order of Op
+static constexpr const char *OP_NAMES[] = {
+    "SYS",
+    "CLS",
+    "RET",
+    "JUMP",
+    "CALL",
+    "SKIP_NEXT_IF_EQUAL_BYTE",
+    "SKIP_NEXT_IF_NOT_EQUAL_BYTE",
+    "SKIP_NEXT_IF_EQUAL_REGISTERS",
+    "LOAD_FROM_BYTE",
+    "ADD",
+    "LOAD_FROM_REGISTER_TO_REGISTER",
+    "BITWISE_OR",
+    "BITWISE_AND",
+    "BITWISE_XOR",
+    "ADD_AND_STORE_CARRY",
+    "SUBTRACT",
+    "SHIFT_RIGHT",
+    "REVERSE_SUBTRACT",
+    "SHIFT_LEFT",
+    "SKIP_NEXT_IF_NOT_EQUAL_REGISTERS",
+    "LOAD_I",
+    "JUMP_OFF_REGISTER",
+    "RAND",
+    "DRAW",
+    "SKIP_IF_PRESSED",
+    "SKIP_IF_NOT_PRESSED",
+    "LOAD_FROM_DELAY_TIMER",
+    "STORE_KEY_PRESS",
+    "SET_DELAY_TIMER",
+    "SET_SOUND_TIMER",
+    "ADD_I",
+    "LOAD_SPRITE",
+    "WRITE_BINARY_CODED_DECIMAL",
+    "STORE_MEMORY_FROM_REGISTERS",
+    "STORE_REGISTERS_FROM_MEMORY",
+    "SCROLL_DOWN",
+    "SCROLL_UP",
+    "SCROLL_RIGHT",
+    "SCROLL_LEFT",
+    "EXIT",
+    "LOW_RESOLUTION",
+    "HIGH_RESOLUTION",
+    "STORE_MEMORY_FROM_REGISTER_RANGE",
+    "STORE_REGISTER_RANGE_FROM_MEMORY",
+    "LOAD_I_LONG",
+    "SELECT_PLANES",
+    "LOAD_AUDIO_PATTERN",
+    "LOAD_LARGE_SPRITE",
+    "SET_PITCH",
+    "STORE_FLAGS_FROM_REGISTERS",
+    "STORE_REGISTERS_FROM_FLAGS",
+    "NOP",
+};
+static_assert(std::size(OP_NAMES) == static_cast<size_t>(Op::COUNT));
+
+Profiler::Profiler(uint16_t root) { nodes.push_back({root, 0, 0}); }
+
+void Profiler::count_instruction(uint16_t address, Op op, uint64_t count) {
+  instructions += count;
+  op_counts[static_cast<size_t>(op)] += count;
+  pc_counts[address % ADDRESS_COUNT] += count;
+  nodes[current].instructions += count;
+}
+
+void Profiler::count_draw(uint64_t nanoseconds) {
+  draw_calls++;
+  draw_nanoseconds += nanoseconds;
+}
+
+void Profiler::count_frame(bool blocked) {
+  frames++;
+  blocked_frames += blocked;
+}
+
+void Profiler::enter(uint16_t routine) {
+  auto [it, added] = tree.try_emplace({current, routine}, nodes.size());
+  if (added) {
+    nodes.push_back({routine, current, 0});
+  }
+  current = it->second;
+}
+
+void Profiler::leave() { current = nodes[current].parent; }
+
+void Profiler::leave_all() { current = 0; }
+
+void Profiler::clear() { *this = Profiler(nodes[0].routine); }
+
+uint64_t Profiler::get_op_count(Op op) const {
+  return op_counts[static_cast<size_t>(op)];
+}
+
+uint64_t Profiler::get_pc_count(uint16_t address) const {
+  return pc_counts[address % ADDRESS_COUNT];
+}
+
+uint64_t Profiler::get_instructions() const { return instructions; }
+
+uint64_t Profiler::get_blocked_frames() const { return blocked_frames; }
+
+uint64_t Profiler::get_draw_calls() const { return draw_calls; }
+
+bool Profiler::write_json(std::ostream &out) const {
+  char line[128];
+  std::snprintf(line, sizeof(line),
+                "{\n  \"instructions\": %" PRIu64 ",\n  \"frames\": %" PRIu64
+                ",\n  \"blocked_frames\": %" PRIu64 ",\n",
+                instructions, frames, blocked_frames);
+  out << line;
+  std::snprintf(line, sizeof(line),
+                "  \"draw\": {\"calls\": %" PRIu64 ", \"nanoseconds\": %" PRIu64
+                "},\n",
+                draw_calls, draw_nanoseconds);
+  out << line;
+
+  out << "  \"ops\": {";
+  const char *separator = "";
+  for (size_t i = 0; i < op_counts.size(); i++) {
+    if (op_counts[i] != 0) {
+      std::snprintf(line, sizeof(line), "%s\n    \"%s\": %" PRIu64, separator,
+                    OP_NAMES[i], op_counts[i]);
+      out << line;
+      separator = ",";
+    }
+  }
+  out << "\n  },\n";
+
+  // the hottest addresses, most executed first
+  std::vector<uint16_t> hot;
+  for (size_t i = 0; i < pc_counts.size(); i++) {
+    if (pc_counts[i] != 0) {
+      hot.push_back(i);
+    }
+  }
+  size_t shown = std::min(hot.size(), HOT_PC_COUNT);
+  std::partial_sort(hot.begin(), hot.begin() + shown, hot.end(),
+                    [&](uint16_t a, uint16_t b) {
+                      return pc_counts[a] != pc_counts[b]
+                                 ? pc_counts[a] > pc_counts[b]
+                                 : a < b;
+                    });
+  out << "  \"hot_pcs\": [";
+  separator = "";
+  for (size_t i = 0; i < shown; i++) {
+    std::snprintf(line, sizeof(line),
+                  "%s\n    {\"pc\": \"0x%03X\", \"count\": %" PRIu64 "}",
+                  separator, hot[i], pc_counts[hot[i]]);
+    out << line;
+    separator = ",";
+  }
+  out << "\n  ]\n}\n";
+  return static_cast<bool>(out);
+}
+
+bool Profiler::write_folded(std::ostream &out) const {
+  for (size_t i = 0; i < nodes.size(); i++) {
+    if (nodes[i].instructions == 0) {
+      continue;
+    }
+
+    // walk up to the root, then print the chain from the root down
+    std::vector<uint16_t> chain;
+    for (size_t node = i;; node = nodes[node].parent) {
+      chain.push_back(nodes[node].routine);
+      if (node == 0) {
+        break;
+      }
+    }
+
+    std::string stack;
+    char frame[8];
+    for (auto it = chain.rbegin(); it != chain.rend(); ++it) {
+      std::snprintf(frame, sizeof(frame), "%s0x%03X", stack.empty() ? "" : ";",
+                    *it);
+      stack += frame;
+    }
+    out << stack << ' ' << nodes[i].instructions << '\n';
+  }
+  return static_cast<bool>(out);
+}
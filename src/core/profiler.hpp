@@ -0,0 +1,110 @@
+/// @file profiler.hpp
+/// @brief declaration of the Profiler class
+/// @author Abhay Manoj
+/// @date Oct 14 2026
+#pragma once
+
+#include "opcode.hpp"
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <ostream>
+#include <utility>
+#include <vector>
+
+/// @brief counts what a machine spends its cycles on. Chip8 only holds and
+/// feeds one when built with CHIP8_PROFILING, otherwise the hooks compile
+/// to nothing
+class Profiler {
+public:
+  static constexpr size_t ADDRESS_COUNT = 4096;
+  static constexpr size_t HOT_PC_COUNT = 32; // addresses listed in the json
+
+private:
+  /// @brief a routine in the call tree, reached by one chain of calls
+  struct Node {
+    uint16_t routine = 0;      // the address the routine was called at
+    uint32_t parent = 0;       // index of the caller, the root is its own
+    uint64_t instructions = 0; // executed in the routine itself
+  };
+
+  std::array<uint64_t, static_cast<size_t>(Op::COUNT)> op_counts{};
+  std::vector<uint64_t> pc_counts = std::vector<uint64_t>(ADDRESS_COUNT);
+  uint64_t instructions = 0;
+  uint64_t draw_calls = 0;
+  uint64_t draw_nanoseconds = 0;
+  uint64_t frames = 0;
+  uint64_t blocked_frames = 0; // frames that ended waiting in FX0A
+
+  std::vector<Node> nodes;                                // nodes[0] is root
+  std::map<std::pair<uint32_t, uint16_t>, uint32_t> tree; // (parent, routine)
+  uint32_t current = 0;                                   // the running node
+
+public:
+  /// @brief creates an empty profile whose root routine is at root
+  /// @param root the address execution starts at
+  explicit Profiler(uint16_t root = 0x200);
+
+  /// @brief counts an instruction about to execute
+  /// @param address the address of the instruction
+  /// @param op the decoded opcode
+  /// @param count the times it executes, more than 1 for skipped idle loops
+  void count_instruction(uint16_t address, Op op, uint64_t count = 1);
+
+  /// @brief counts one DXYN
+  /// @param nanoseconds the host time it took
+  void count_draw(uint64_t nanoseconds);
+
+  /// @brief counts a frame ending at a timer tick
+  /// @param blocked true if the machine was waiting for a key in FX0A
+  void count_frame(bool blocked);
+
+  /// @brief moves into a called routine
+  /// @param routine the address that was called
+  void enter(uint16_t routine);
+
+  /// @brief returns to the calling routine, stays at the root if there is
+  /// none
+  void leave();
+
+  /// @brief returns to the root routine, for when the stack is replaced
+  void leave_all();
+
+  /// @brief drops everything counted so far
+  void clear();
+
+  /// @brief returns the executions of an opcode
+  /// @param op the opcode
+  /// @return the number of times it was executed
+  uint64_t get_op_count(Op op) const;
+
+  /// @brief returns the executions of the instruction at an address
+  /// @param address the address
+  /// @return the number of times it was executed
+  uint64_t get_pc_count(uint16_t address) const;
+
+  /// @brief returns the total instructions counted
+  /// @return the number of instructions
+  uint64_t get_instructions() const;
+
+  /// @brief returns the number of frames that ended waiting in FX0A
+  /// @return the blocked frames
+  uint64_t get_blocked_frames() const;
+
+  /// @brief returns the number of DXYN executed
+  /// @return the draw calls
+  uint64_t get_draw_calls() const;
+
+  /// @brief writes the counts as a json object: totals, per opcode counts,
+  /// the hottest addresses and the draw time
+  /// @param out the stream to write to
+  /// @return true if everything was written
+  bool write_json(std::ostream &out) const;
+
+  /// @brief writes the call tree in the folded stack format of flamegraph
+  /// tools, one line per routine chain with the instructions run in it
+  /// @param out the stream to write to
+  /// @return true if everything was written
+  bool write_folded(std::ostream &out) const;
+};
@@ -0,0 +1,78 @@
+/// @file quirks.hpp
+/// @brief the behaviours chip8 interpreters disagree on, picked at compile
+/// time so every variant of BasicChip8 gets its own branch free opcodes
+/// @author Abhay Manoj
+/// @date Oct 14 2026
+#pragma once
+
+#include "opcode.hpp"
+#include <concepts>
+
+/// @brief a set of quirks, each a constant the opcodes test with if
+/// constexpr, along with the instructions the platform understands
+template <typename Quirks>
+concept Chip8Quirks = requires {
+  { Quirks::INSTRUCTIONS } -> std::convertible_to<InstructionSet>;
+  { Quirks::SHIFT_USES_VY } -> std::convertible_to<bool>;
+  { Quirks::JUMP_USES_VX } -> std::convertible_to<bool>;
+  { Quirks::LOAD_STORE_INCREMENTS_I } -> std::convertible_to<bool>;
+  { Quirks::CLIP_SPRITES } -> std::convertible_to<bool>;
+  { Quirks::LOGIC_RESETS_VF } -> std::convertible_to<bool>;
+  { Quirks::MEMORY_WRAPS } -> std::convertible_to<bool>;
+};
+
+/// @brief the behaviour this emulator has always had, what Chip8 uses
+struct DefaultQuirks {
+  static constexpr InstructionSet INSTRUCTIONS = InstructionSet::CHIP8;
+  static constexpr bool SHIFT_USES_VY = false; // 8XY6 and 8XYE shift V_y
+  static constexpr bool JUMP_USES_VX = false;  // BXNN jumps to XNN + V_x
+  static constexpr bool LOAD_STORE_INCREMENTS_I = false; // FX55 and FX65
+  static constexpr bool CLIP_SPRITES = false;  // DXYN drops pixels off edges
+  static constexpr bool LOGIC_RESETS_VF = false; // 8XY1 - 8XY3 clear V_F
+  // I past the end of memory wraps to 0, else it reads zeros and drops writes
+  static constexpr bool MEMORY_WRAPS = true;
+};
+
+/// @brief the original interpreter on the COSMAC VIP
+struct CosmacVipQuirks {
+  static constexpr InstructionSet INSTRUCTIONS = InstructionSet::CHIP8;
+  static constexpr bool SHIFT_USES_VY = true;
+  static constexpr bool JUMP_USES_VX = false;
+  static constexpr bool LOAD_STORE_INCREMENTS_I = true;
+  static constexpr bool CLIP_SPRITES = true;
+  static constexpr bool LOGIC_RESETS_VF = true;
+  static constexpr bool MEMORY_WRAPS = true;
+};
+
+/// @brief CHIP-48 on the HP48 calculators
+struct Chip48Quirks {
+  static constexpr InstructionSet INSTRUCTIONS = InstructionSet::CHIP8;
+  static constexpr bool SHIFT_USES_VY = false;
+  static constexpr bool JUMP_USES_VX = true;
+  static constexpr bool LOAD_STORE_INCREMENTS_I = false;
+  static constexpr bool CLIP_SPRITES = true;
+  static constexpr bool LOGIC_RESETS_VF = false;
+  static constexpr bool MEMORY_WRAPS = false;
+};
+
+/// @brief SUPER-CHIP 1.1, which kept the CHIP-48 behaviour
+struct SuperChipQuirks {
+  static constexpr InstructionSet INSTRUCTIONS = InstructionSet::SUPER_CHIP;
+  static constexpr bool SHIFT_USES_VY = false;
+  static constexpr bool JUMP_USES_VX = true;
+  static constexpr bool LOAD_STORE_INCREMENTS_I = false;
+  static constexpr bool CLIP_SPRITES = true;
+  static constexpr bool LOGIC_RESETS_VF = false;
+  static constexpr bool MEMORY_WRAPS = false;
+};
+
+/// @brief XO-CHIP, which went back to the VIP but wraps sprites
+struct XoChipQuirks {
+  static constexpr InstructionSet INSTRUCTIONS = InstructionSet::XO_CHIP;
+  static constexpr bool SHIFT_USES_VY = true;
+  static constexpr bool JUMP_USES_VX = false;
+  static constexpr bool LOAD_STORE_INCREMENTS_I = true;
+  static constexpr bool CLIP_SPRITES = false;
+  static constexpr bool LOGIC_RESETS_VF = false;
+  static constexpr bool MEMORY_WRAPS = true;
+};
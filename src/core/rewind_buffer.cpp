@@ -0,0 +1,141 @@
+/// @file rewind_buffer.cpp
+/// @brief implementation of the RewindBuffer class
+/// @author Abhay Manoj
+/// @date Oct 14 2026
+#include "rewind_buffer.hpp"
+#include <cstring>
+
+// a delta is a list of runs, each a 2 byte count of unchanged bytes, a 2 byte
+// count of changed bytes and then the changed bytes XORed with the keyframe.
+// longer stretches take several runs, an XO-CHIP snapshot is over 64 KB
+static constexpr size_t RUN_HEADER_SIZE = 4;
+static constexpr size_t MAX_RUN = UINT16_MAX;
+
+/// @brief appends a 2 byte count to a delta
+/// @param delta the delta to append to
+/// @param count the count to append
+static void put_count(std::vector<uint8_t> &delta, size_t count) {
+  delta.push_back(count & 0xFF);
+  delta.push_back(count >> 8);
+}
+
+/// @brief squeezes the zero runs out of an XOR difference
+/// @param diff the XOR of a frame with its keyframe
+/// @param delta filled with the encoded runs
+static void encode(const std::vector<uint8_t> &diff,
+                   std::vector<uint8_t> &delta) {
+  size_t i = 0;
+  while (i < diff.size()) {
+    size_t zeros_start = i;
+    while (i < diff.size() && diff[i] == 0 && i - zeros_start < MAX_RUN) {
+      i++;
+    }
+    size_t zeros = i - zeros_start;
+
+    // changed bytes end at a zero run long enough to pay for a new header
+    size_t literal_start = i;
+    size_t run = 0;
+    while (i < diff.size() && run < RUN_HEADER_SIZE &&
+           i - literal_start < MAX_RUN) {
+      run = diff[i] == 0 ? run + 1 : 0;
+      i++;
+    }
+    if (run == RUN_HEADER_SIZE) {
+      i -= run;
+    }
+
+    put_count(delta, zeros);
+    put_count(delta, i - literal_start);
+    delta.insert(delta.end(), diff.begin() + literal_start, diff.begin() + i);
+  }
+}
+
+/// @brief applies a delta made by encode to a copy of its keyframe
+/// @param delta the encoded runs
+/// @param state the keyframe, becomes the frame of the delta
+static void decode(const std::vector<uint8_t> &delta, uint8_t *state) {
+  size_t position = 0;
+  size_t i = 0;
+  while (i < delta.size()) {
+    position += delta[i] | delta[i + 1] << 8;
+    size_t literal = delta[i + 2] | delta[i + 3] << 8;
+    i += RUN_HEADER_SIZE;
+    for (size_t j = 0; j < literal; j++) {
+      state[position++] ^= delta[i++];
+    }
+  }
+}
+
+RewindBuffer::RewindBuffer(size_t byte_budget, size_t keyframe_interval)
+    : byte_budget(byte_budget),
+      keyframe_interval(keyframe_interval > 0 ? keyframe_interval : 1) {}
+
+void RewindBuffer::push_bytes(const uint8_t *state, size_t size) {
+  if (size != snapshot_size) {
+    clear();
+    snapshot_size = size;
+    scratch.resize(size);
+  }
+
+  if (groups.empty() || groups.back().deltas.size() + 1 >= keyframe_interval) {
+    Group &group = groups.emplace_back();
+    group.keyframe.assign(state, state + size);
+    group.bytes = size;
+    bytes_used += group.bytes;
+    frame_count++;
+    evict();
+    return;
+  }
+
+  Group &group = groups.back();
+  for (size_t i = 0; i < size; i++) {
+    scratch[i] = group.keyframe[i] ^ state[i];
+  }
+
+  std::vector<uint8_t> &delta = group.deltas.emplace_back();
+  encode(scratch, delta);
+  delta.shrink_to_fit();
+  group.bytes += delta.size();
+  bytes_used += delta.size();
+  frame_count++;
+  evict();
+}
+
+bool RewindBuffer::pop_bytes(uint8_t *state, size_t size) {
+  if (groups.empty() || size != snapshot_size) {
+    return false;
+  }
+
+  Group &group = groups.back();
+  std::memcpy(state, group.keyframe.data(), size);
+  if (group.deltas.empty()) {
+    bytes_used -= group.bytes;
+    groups.pop_back();
+  } else {
+    decode(group.deltas.back(), state);
+    group.bytes -= group.deltas.back().size();
+    bytes_used -= group.deltas.back().size();
+    group.deltas.pop_back();
+  }
+
+  frame_count--;
+  return true;
+}
+
+void RewindBuffer::clear() {
+  groups.clear();
+  bytes_used = 0;
+  frame_count = 0;
+}
+
+size_t RewindBuffer::size() const { return frame_count; }
+
+size_t RewindBuffer::get_bytes_used() const { return bytes_used; }
+
+void RewindBuffer::evict() {
+  while (groups.size() > 1 && bytes_used > byte_budget) {
+    bytes_used -= groups.front().bytes;
+    frame_count -= groups.front().deltas.size() + 1;
+    groups.pop_front();
+  }
+}
@@ -0,0 +1,89 @@
+/// @file rewind_buffer.hpp
+/// @brief declaration of the RewindBuffer class
+/// @author Abhay Manoj
+/// @date Oct 14 2026
+#pragma once
+
+#include "chip8.hpp"
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <type_traits>
+#include <vector>
+
+/// @brief a fixed memory history of snapshots, one per frame. frames are
+/// grouped behind a full keyframe, every other frame keeps only its XOR
+/// against the keyframe with the runs of zeros squeezed out, so any frame
+/// restores with one pass over its delta. the oldest groups are dropped once
+/// the byte budget is reached. any profile's snapshots can be recorded, a
+/// snapshot of another size than the recorded ones starts the history over
+class RewindBuffer {
+public:
+  static constexpr size_t DEFAULT_KEYFRAME_INTERVAL = 60; // one a second
+
+private:
+  /// @brief a keyframe and the deltas of the frames recorded after it
+  struct Group {
+    std::vector<uint8_t> keyframe;
+    std::vector<std::vector<uint8_t>> deltas; // oldest first
+    size_t bytes = 0;                         // memory held by the group
+  };
+
+  std::deque<Group> groups; // oldest first
+  std::vector<uint8_t> scratch; // the XOR of the last frame, reused
+  size_t snapshot_size = 0;     // of the recorded frames, 0 if none
+  size_t byte_budget;
+  size_t keyframe_interval;
+  size_t bytes_used = 0;
+  size_t frame_count = 0;
+
+  /// @brief drops the oldest groups until the buffer fits its budget, the
+  /// newest group is always kept
+  void evict();
+
+  /// @brief records the bytes of a snapshot, see push
+  /// @param state the snapshot
+  /// @param size the bytes of the snapshot
+  void push_bytes(const uint8_t *state, size_t size);
+
+  /// @brief removes the newest frame into the bytes of a snapshot, see pop
+  /// @param state filled with the snapshot
+  /// @param size the bytes of the snapshot
+  /// @return false if the history is empty or holds another size
+  bool pop_bytes(uint8_t *state, size_t size);
+
+public:
+  /// @brief creates an empty buffer
+  /// @param byte_budget the most memory the recorded frames may hold
+  /// @param keyframe_interval frames per keyframe, including the keyframe
+  explicit RewindBuffer(size_t byte_budget,
+                        size_t keyframe_interval = DEFAULT_KEYFRAME_INTERVAL);
+
+  /// @brief records a frame as the newest entry of the history
+  /// @tparam Snapshot the snapshot of a BasicChip8
+  /// @param snapshot the state at the end of the frame
+  template <typename Snapshot> void push(const Snapshot &snapshot) {
+    static_assert(std::is_trivially_copyable_v<Snapshot>);
+    push_bytes(reinterpret_cast<const uint8_t *>(&snapshot), sizeof(snapshot));
+  }
+
+  /// @brief removes the newest frame and returns its state
+  /// @tparam Snapshot the snapshot of a BasicChip8
+  /// @param snapshot filled with the state of the frame
+  /// @return false if the history is empty or of another profile
+  template <typename Snapshot> bool pop(Snapshot &snapshot) {
+    static_assert(std::is_trivially_copyable_v<Snapshot>);
+    return pop_bytes(reinterpret_cast<uint8_t *>(&snapshot), sizeof(snapshot));
+  }
+
+  /// @brief forgets every recorded frame
+  void clear();
+
+  /// @brief returns the number of frames that can be rewound
+  /// @return the number of recorded frames
+  size_t size() const;
+
+  /// @brief returns the memory held by the recorded frames
+  /// @return the size of the keyframes and deltas in bytes
+  size_t get_bytes_used() const;
+};
@@ -0,0 +1,655 @@
+/// @file rom_analysis.cpp
+/// @brief implementation of the static program analysis
+/// @author Abhay Manoj
+/// @date Oct 14 2026
+#include "rom_analysis.hpp"
+#include <algorithm>
+#include <array>
+#include <cstdio>
+
+static constexpr int16_t ANY = -1; // a register that may hold any value
+static constexpr uint32_t I_MAX = 0xFFFF;
+// visits of an instruction after which growing ranges of I jump to the
+// end of memory, so loops stepping I through a table still finish
+static constexpr uint16_t WIDEN_AFTER = 16;
+static constexpr uint16_t FONT_HEIGHT = 5;
+static constexpr uint16_t LARGE_FONT_ADDRESS = 0x50;
+static constexpr uint16_t LARGE_FONT_HEIGHT = 10;
+
+/// @brief what is known about the registers before an instruction
+struct Registers {
+  std::array<int16_t, 16> V{}; // the value, or ANY
+  uint32_t I_first = 0;      // I lies in [I_first, I_last]
+  uint32_t I_last = 0;
+};
+
+/// @brief where control goes after an instruction
+struct Flow {
+  std::array<uint16_t, 2> next{};
+  uint8_t count = 0;    // entries of next in use
+  bool returns = false; // 00EE, goes to every return site
+  bool terminates = false; // leaves the straight line, ends a block
+};
+
+/// @brief merges the registers of another path into those known
+/// @param into the registers known so far
+/// @param from the registers of the other path
+/// @param widen true to move a growing range of I straight to its limit
+/// @return true if anything changed
+static bool merge(Registers &into, const Registers &from, bool widen) {
+  bool changed = false;
+  for (size_t i = 0; i < into.V.size(); i++) {
+    if (into.V[i] != from.V[i] && into.V[i] != ANY) {
+      into.V[i] = ANY;
+      changed = true;
+    }
+  }
+  if (from.I_first < into.I_first) {
+    into.I_first = widen ? 0 : from.I_first;
+    changed = true;
+  }
+  if (from.I_last > into.I_last) {
+    into.I_last = widen ? I_MAX : from.I_last;
+    changed = true;
+  }
+  return changed;
+}
+
+/// @brief follows the paths of one program, see analyze_rom
+class Analyzer {
+  std::span<const uint8_t> memory;
+  AnalysisQuirks quirks;
+  uint32_t mask; // addresses wrap at the size of memory
+  RomAnalysis &result;
+
+  std::vector<Registers> before; // indexed by address
+  std::vector<uint8_t> reached;  // before holds the registers of a path
+  std::vector<uint8_t> queued;   // waiting in pending
+  std::vector<uint16_t> visits;
+  std::vector<Flow> flows;
+  std::vector<uint16_t> pending;
+
+  std::vector<uint16_t> return_sites; // after every call, sorted
+  Registers returned;                 // merged from every 00EE
+  bool has_returned = false;
+
+public:
+  Analyzer(std::span<const uint8_t> memory, const AnalysisQuirks &quirks,
+           RomAnalysis &result)
+      : memory(memory), quirks(quirks), mask(memory.size() - 1),
+        result(result), before(memory.size()), reached(memory.size()),
+        queued(memory.size()), visits(memory.size()), flows(memory.size()) {
+    result.bytes.assign(memory.size(), 0);
+  }
+
+  /// @brief follows every path from the start to the end
+  /// @param start where the paths begin
+  void run(const AnalysisStart &start) {
+    Registers entry;
+    if (!start.at_reset) {
+      entry.V.fill(ANY);
+      entry.I_last = I_MAX;
+    }
+    for (uint16_t address : start.entries) {
+      reach(address, entry);
+    }
+
+    while (!pending.empty()) {
+      uint16_t address = pending.back();
+      pending.pop_back();
+      queued[address] = false;
+      step(address);
+    }
+
+    find_overwritten();
+    build_blocks(start);
+  }
+
+private:
+  /// @brief reads a big endian word
+  uint16_t word(uint32_t address) const {
+    return memory[address & mask] << 8 | memory[(address + 1) & mask];
+  }
+
+  /// @brief returns the bytes the instruction at an address takes
+  uint16_t length(uint32_t address) const {
+    if (quirks.instructions == InstructionSet::XO_CHIP &&
+        word(address) == 0xF000) {
+      return 4;
+    }
+    return 2;
+  }
+
+  /// @brief merges the registers of a path into an instruction, queueing it
+  /// if that taught anything new
+  void reach(uint32_t address, const Registers &registers) {
+    address &= mask;
+    if (!reached[address]) {
+      reached[address] = true;
+      before[address] = registers;
+    } else if (!merge(before[address], registers,
+                      visits[address] >= WIDEN_AFTER)) {
+      return;
+    }
+    if (!queued[address]) {
+      queued[address] = true;
+      pending.push_back(address);
+    }
+  }
+
+  /// @brief marks the bytes an access through I may touch
+  void access(const Registers &registers, uint32_t count, uint8_t bit) {
+    if (count == 0) {
+      return;
+    }
+    uint32_t span = registers.I_last - registers.I_first + count;
+    if (span >= memory.size()) {
+      span = memory.size();
+    }
+    for (uint32_t i = 0; i < span; i++) {
+      result.bytes[(registers.I_first + i) & mask] |= bit;
+    }
+  }
+
+  /// @brief moves I by an amount within a range
+  static void add_to_I(Registers &registers, uint32_t least, uint32_t most) {
+    registers.I_first += least;
+    registers.I_last += most;
+    if (registers.I_last > I_MAX) { // I is 16 bits and wraps
+      registers.I_first = 0;
+      registers.I_last = I_MAX;
+    }
+  }
+
+  /// @brief sets I to one address
+  static void load_I(Registers &registers, uint32_t address) {
+    registers.I_first = address;
+    registers.I_last = address;
+  }
+
+  /// @brief applies what an instruction that continues in a straight line
+  /// does to the registers and memory
+  void transfer(const Instruction &in, uint32_t address, Registers &r) {
+    int16_t &vx = r.V[in.x];
+    int16_t vy = r.V[in.y];
+    bool known = vx != ANY && vy != ANY;
+    uint8_t low = std::min(in.x, in.y);
+    uint8_t high = std::max(in.x, in.y);
+
+    switch (in.op) {
+    case Op::LOAD_FROM_BYTE:
+      vx = in.nn;
+      break;
+    case Op::ADD:
+      vx = vx == ANY ? ANY : (vx + in.nn) & 0xFF;
+      break;
+    case Op::LOAD_FROM_REGISTER_TO_REGISTER:
+      vx = vy;
+      break;
+    case Op::BITWISE_OR:
+      vx = known ? vx | vy : ANY;
+      r.V[0xF] = ANY;
+      break;
+    case Op::BITWISE_AND:
+      vx = known ? vx & vy : ANY;
+      r.V[0xF] = ANY;
+      break;
+    case Op::BITWISE_XOR:
+      vx = known ? vx ^ vy : ANY;
+      r.V[0xF] = ANY;
+      break;
+    case Op::ADD_AND_STORE_CARRY:
+    case Op::SUBTRACT:
+    case Op::SHIFT_RIGHT:
+    case Op::REVERSE_SUBTRACT:
+    case Op::SHIFT_LEFT:
+      vx = ANY;
+      r.V[0xF] = ANY;
+      break;
+    case Op::RAND:
+    case Op::LOAD_FROM_DELAY_TIMER:
+    case Op::STORE_KEY_PRESS:
+      vx = ANY;
+      break;
+    case Op::DRAW: {
+      uint32_t rows = in.n;
+      if (in.n == 0 && quirks.instructions != InstructionSet::CHIP8) {
+        rows = 32; // 16 rows of 2 bytes
+      }
+      if (quirks.instructions == InstructionSet::XO_CHIP) {
+        rows *= 2; // a sprite for each plane
+      }
+      access(r, rows, RomAnalysis::READ);
+      r.V[0xF] = ANY;
+      break;
+    }
+    case Op::LOAD_I:
+      load_I(r, in.nnn);
+      break;
+    case Op::LOAD_I_LONG:
+      load_I(r, word(address + 2));
+      break;
+    case Op::ADD_I:
+      if (vx == ANY) {
+        add_to_I(r, 0, 0xFF);
+      } else {
+        add_to_I(r, vx, vx);
+      }
+      break;
+    case Op::LOAD_SPRITE:
+      if (vx == ANY) {
+        r.I_first = 0;
+        r.I_last = 0xFF * FONT_HEIGHT;
+      } else {
+        load_I(r, vx * FONT_HEIGHT);
+      }
+      break;
+    case Op::LOAD_LARGE_SPRITE:
+      if (vx == ANY) {
+        r.I_first = LARGE_FONT_ADDRESS;
+        r.I_last = LARGE_FONT_ADDRESS + 0xF * LARGE_FONT_HEIGHT;
+      } else {
+        load_I(r, LARGE_FONT_ADDRESS + (vx & 0xF) * LARGE_FONT_HEIGHT);
+      }
+      break;
+    case Op::WRITE_BINARY_CODED_DECIMAL:
+      access(r, 3, RomAnalysis::WRITTEN);
+      break;
+    case Op::STORE_MEMORY_FROM_REGISTERS:
+      access(r, in.x + 1, RomAnalysis::WRITTEN);
+      if (quirks.load_store_increments_i) {
+        add_to_I(r, in.x + 1, in.x + 1);
+      }
+      break;
+    case Op::STORE_REGISTERS_FROM_MEMORY:
+      access(r, in.x + 1, RomAnalysis::READ);
+      std::fill_n(r.V.begin(), in.x + 1, ANY);
+      if (quirks.load_store_increments_i) {
+        add_to_I(r, in.x + 1, in.x + 1);
+      }
+      break;
+    case Op::STORE_MEMORY_FROM_REGISTER_RANGE:
+      access(r, high - low + 1, RomAnalysis::WRITTEN);
+      break;
+    case Op::STORE_REGISTER_RANGE_FROM_MEMORY:
+      access(r, high - low + 1, RomAnalysis::READ);
+      std::fill(r.V.begin() + low, r.V.begin() + high + 1, ANY);
+      break;
+    case Op::LOAD_AUDIO_PATTERN:
+      access(r, 16, RomAnalysis::READ);
+      break;
+    case Op::STORE_REGISTERS_FROM_FLAGS:
+      std::fill_n(r.V.begin(), in.x + 1, ANY);
+      break;
+    default:;
+    }
+  }
+
+  /// @brief adds a successor to a flow
+  static void add(Flow &flow, uint32_t address) {
+    flow.next[flow.count++] = static_cast<uint16_t>(address);
+  }
+
+  /// @brief follows one instruction with the registers known before it
+  void step(uint16_t address) {
+    visits[address]++;
+    uint16_t raw = word(address);
+    uint16_t size = length(address);
+    Instruction in = decode(raw, quirks.instructions);
+    result.bytes[address] |= RomAnalysis::INSTRUCTION;
+    for (uint16_t i = 0; i < size; i++) {
+      result.bytes[(address + i) & mask] |= RomAnalysis::CODE;
+    }
+
+    Registers out = before[address];
+    Flow flow;
+    flow.terminates = true;
+    uint32_t next = (address + size) & mask;
+
+    switch (in.op) {
+    case Op::SYS:
+    case Op::JUMP:
+      add(flow, in.nnn);
+      break;
+    case Op::CALL:
+      add(flow, in.nnn);
+      add_return_site(next);
+      break;
+    case Op::RET:
+      flow.returns = true;
+      if (!has_returned) {
+        has_returned = true;
+        returned = out;
+      } else if (!merge(returned, out, false)) {
+        break;
+      }
+      for (uint16_t site : return_sites) {
+        reach(site, returned);
+      }
+      break;
+    case Op::EXIT:
+      break;
+    case Op::JUMP_OFF_REGISTER: {
+      int16_t offset = out.V[quirks.jump_uses_vx ? in.x : 0];
+      if (offset == ANY) {
+        result.complete = false; // a jump table the registers don't pin
+      } else {
+        add(flow, (in.nnn + offset) & mask);
+      }
+      break;
+    }
+    case Op::SKIP_NEXT_IF_EQUAL_BYTE:
+    case Op::SKIP_NEXT_IF_NOT_EQUAL_BYTE:
+    case Op::SKIP_NEXT_IF_EQUAL_REGISTERS:
+    case Op::SKIP_NEXT_IF_NOT_EQUAL_REGISTERS:
+    case Op::SKIP_IF_PRESSED:
+    case Op::SKIP_IF_NOT_PRESSED:
+      add(flow, next);
+      add(flow, (next + length(next)) & mask);
+      break;
+    default:
+      transfer(in, address, out);
+      add(flow, next);
+      flow.terminates = false;
+    }
+
+    flows[address] = flow;
+    for (uint8_t i = 0; i < flow.count; i++) {
+      reach(flow.next[i], out);
+    }
+  }
+
+  /// @brief notes the address after a call, where every 00EE may go
+  void add_return_site(uint16_t site) {
+    auto it = std::lower_bound(return_sites.begin(), return_sites.end(), site);
+    if (it != return_sites.end() && *it == site) {
+      return;
+    }
+    return_sites.insert(it, site);
+    if (has_returned) {
+      reach(site, returned);
+    }
+  }
+
+  /// @brief lists the instructions with a byte a write may reach
+  void find_overwritten() {
+    for (uint32_t address = 0; address < memory.size(); address++) {
+      if (!(result.bytes[address] & RomAnalysis::INSTRUCTION)) {
+        continue;
+      }
+      uint16_t size = length(address);
+      for (uint16_t i = 0; i < size; i++) {
+        if (result.bytes[(address + i) & mask] & RomAnalysis::WRITTEN) {
+          result.overwritten.push_back(address);
+          break;
+        }
+      }
+    }
+  }
+
+  /// @brief splits the instructions into basic blocks, which start at the
+  /// entries and wherever anything but running straight on leads
+  void build_blocks(const AnalysisStart &start) {
+    std::vector<uint8_t> leader(memory.size());
+    for (uint16_t address : start.entries) {
+      leader[address & mask] = true;
+    }
+    for (uint16_t site : return_sites) {
+      leader[site] = true;
+    }
+    for (uint32_t address = 0; address < memory.size(); address++) {
+      if (reached[address] && flows[address].terminates) {
+        for (uint8_t i = 0; i < flows[address].count; i++) {
+          leader[flows[address].next[i]] = true;
+        }
+      }
+    }
+
+    for (uint32_t first = 0; first < memory.size(); first++) {
+      if (!leader[first] || !reached[first]) {
+        continue;
+      }
+      RomAnalysis::Block block;
+      block.start = first;
+      uint32_t address = first;
+      while (true) {
+        const Flow &flow = flows[address];
+        uint32_t next = (address + length(address)) & mask;
+        if (flow.terminates) {
+          block.end = address + length(address);
+          if (flow.returns) {
+            block.successors = return_sites;
+          } else {
+            block.successors.assign(flow.next.begin(),
+                                    flow.next.begin() + flow.count);
+          }
+          break;
+        }
+        if (leader[next] || next <= address) {
+          block.end = address + length(address);
+          block.successors = {static_cast<uint16_t>(next)};
+          break;
+        }
+        address = next;
+      }
+      result.blocks.push_back(std::move(block));
+    }
+  }
+};
+
+RomAnalysis analyze_rom(std::span<const uint8_t> memory,
+                        const AnalysisQuirks &quirks,
+                        const AnalysisStart &start) {
+  RomAnalysis result;
+  Analyzer(memory, quirks, result).run(start);
+  return result;
+}
+
+std::string disassemble(uint16_t instruction, InstructionSet set,
+                        uint16_t operand) {
+  Instruction in = decode(instruction, set);
+  unsigned x = in.x, y = in.y, n = in.n, nn = in.nn, nnn = in.nnn;
+  char text[32];
+  switch (in.op) {
+  case Op::SYS:
+    std::snprintf(text, sizeof(text), "SYS 0x%03X", nnn);
+    break;
+  case Op::CLS:
+    return "CLS";
+  case Op::RET:
+    return "RET";
+  case Op::JUMP:
+    std::snprintf(text, sizeof(text), "JP 0x%03X", nnn);
+    break;
+  case Op::CALL:
+    std::snprintf(text, sizeof(text), "CALL 0x%03X", nnn);
+    break;
+  case Op::SKIP_NEXT_IF_EQUAL_BYTE:
+    std::snprintf(text, sizeof(text), "SE V%X, 0x%02X", x, nn);
+    break;
+  case Op::SKIP_NEXT_IF_NOT_EQUAL_BYTE:
+    std::snprintf(text, sizeof(text), "SNE V%X, 0x%02X", x, nn);
+    break;
+  case Op::SKIP_NEXT_IF_EQUAL_REGISTERS:
+    std::snprintf(text, sizeof(text), "SE V%X, V%X", x, y);
+    break;
+  case Op::LOAD_FROM_BYTE:
+    std::snprintf(text, sizeof(text), "LD V%X, 0x%02X", x, nn);
+    break;
+  case Op::ADD:
+    std::snprintf(text, sizeof(text), "ADD V%X, 0x%02X", x, nn);
+    break;
+  case Op::LOAD_FROM_REGISTER_TO_REGISTER:
+    std::snprintf(text, sizeof(text), "LD V%X, V%X", x, y);
+    break;
+  case Op::BITWISE_OR:
+    std::snprintf(text, sizeof(text), "OR V%X, V%X", x, y);
+    break;
+  case Op::BITWISE_AND:
+    std::snprintf(text, sizeof(text), "AND V%X, V%X", x, y);
+    break;
+  case Op::BITWISE_XOR:
+    std::snprintf(text, sizeof(text), "XOR V%X, V%X", x, y);
+    break;
+  case Op::ADD_AND_STORE_CARRY:
+    std::snprintf(text, sizeof(text), "ADD V%X, V%X", x, y);
+    break;
+  case Op::SUBTRACT:
+    std::snprintf(text, sizeof(text), "SUB V%X, V%X", x, y);
+    break;
+  case Op::SHIFT_RIGHT:
+    std::snprintf(text, sizeof(text), "SHR V%X, V%X", x, y);
+    break;
+  case Op::REVERSE_SUBTRACT:
+    std::snprintf(text, sizeof(text), "SUBN V%X, V%X", x, y);
+    break;
+  case Op::SHIFT_LEFT:
+    std::snprintf(text, sizeof(text), "SHL V%X, V%X", x, y);
+    break;
+  case Op::SKIP_NEXT_IF_NOT_EQUAL_REGISTERS:
+    std::snprintf(text, sizeof(text), "SNE V%X, V%X", x, y);
+    break;
+  case Op::LOAD_I:
+    std::snprintf(text, sizeof(text), "LD I, 0x%03X", nnn);
+    break;
+  case Op::JUMP_OFF_REGISTER:
+    std::snprintf(text, sizeof(text), "JP V0, 0x%03X", nnn);
+    break;
+  case Op::RAND:
+    std::snprintf(text, sizeof(text), "RND V%X, 0x%02X", x, nn);
+    break;
+  case Op::DRAW:
+    std::snprintf(text, sizeof(text), "DRW V%X, V%X, %u", x, y, n);
+    break;
+  case Op::SKIP_IF_PRESSED:
+    std::snprintf(text, sizeof(text), "SKP V%X", x);
+    break;
+  case Op::SKIP_IF_NOT_PRESSED:
+    std::snprintf(text, sizeof(text), "SKNP V%X", x);
+    break;
+  case Op::LOAD_FROM_DELAY_TIMER:
+    std::snprintf(text, sizeof(text), "LD V%X, DT", x);
+    break;
+  case Op::STORE_KEY_PRESS:
+    std::snprintf(text, sizeof(text), "LD V%X, K", x);
+    break;
+  case Op::SET_DELAY_TIMER:
+    std::snprintf(text, sizeof(text), "LD DT, V%X", x);
+    break;
+  case Op::SET_SOUND_TIMER:
+    std::snprintf(text, sizeof(text), "LD ST, V%X", x);
+    break;
+  case Op::ADD_I:
+    std::snprintf(text, sizeof(text), "ADD I, V%X", x);
+    break;
+  case Op::LOAD_SPRITE:
+    std::snprintf(text, sizeof(text), "LD F, V%X", x);
+    break;
+  case Op::WRITE_BINARY_CODED_DECIMAL:
+    std::snprintf(text, sizeof(text), "LD B, V%X", x);
+    break;
+  case Op::STORE_MEMORY_FROM_REGISTERS:
+    std::snprintf(text, sizeof(text), "LD [I], V%X", x);
+    break;
+  case Op::STORE_REGISTERS_FROM_MEMORY:
+    std::snprintf(text, sizeof(text), "LD V%X, [I]", x);
+    break;
+  case Op::SCROLL_DOWN:
+    std::snprintf(text, sizeof(text), "SCD %u", n);
+    break;
+  case Op::SCROLL_UP:
+    std::snprintf(text, sizeof(text), "SCU %u", n);
+    break;
+  case Op::SCROLL_RIGHT:
+    return "SCR";
+  case Op::SCROLL_LEFT:
+    return "SCL";
+  case Op::EXIT:
+    return "EXIT";
+  case Op::LOW_RESOLUTION:
+    return "LOW";
+  case Op::HIGH_RESOLUTION:
+    return "HIGH";
+  case Op::STORE_MEMORY_FROM_REGISTER_RANGE:
+    std::snprintf(text, sizeof(text), "SAVE V%X - V%X", x, y);
+    break;
+  case Op::STORE_REGISTER_RANGE_FROM_MEMORY:
+    std::snprintf(text, sizeof(text), "LOAD V%X - V%X", x, y);
+    break;
+  case Op::LOAD_I_LONG:
+    std::snprintf(text, sizeof(text), "LD I, 0x%04X", operand);
+    break;
+  case Op::SELECT_PLANES:
+    std::snprintf(text, sizeof(text), "PLANE %u", x);
+    break;
+  case Op::LOAD_AUDIO_PATTERN:
+    return "AUDIO";
+  case Op::LOAD_LARGE_SPRITE:
+    std::snprintf(text, sizeof(text), "LD HF, V%X", x);
+    break;
+  case Op::SET_PITCH:
+    std::snprintf(text, sizeof(text), "PITCH V%X", x);
+    break;
+  case Op::STORE_FLAGS_FROM_REGISTERS:
+    std::snprintf(text, sizeof(text), "LD R, V%X", x);
+    break;
+  case Op::STORE_REGISTERS_FROM_FLAGS:
+    std::snprintf(text, sizeof(text), "LD V%X, R", x);
+    break;
+  default:
+    std::snprintf(text, sizeof(text), "DW 0x%04X", instruction);
+  }
+  return text;
+}
+
+bool write_listing(std::ostream &out, std::span<const uint8_t> memory,
+                   const RomAnalysis &analysis, InstructionSet set,
+                   size_t first, size_t end) {
+  constexpr size_t DATA_PER_LINE = 8;
+  std::vector<uint8_t> starts(memory.size());
+  for (const RomAnalysis::Block &block : analysis.blocks) {
+    starts[block.start] = true;
+  }
+
+  char line[96];
+  size_t address = first;
+  while (address < end) {
+    if (analysis.is_instruction(address) && address + 1 < memory.size()) {
+      uint16_t raw = memory[address] << 8 | memory[address + 1];
+      bool long_load = set == InstructionSet::XO_CHIP && raw == 0xF000 &&
+                       address + 3 < memory.size();
+      uint16_t operand =
+          long_load ? memory[address + 2] << 8 | memory[address + 3] : 0;
+      bool overwritten = std::binary_search(analysis.overwritten.begin(),
+                                            analysis.overwritten.end(),
+                                            static_cast<uint16_t>(address));
+      char bytes[16];
+      if (long_load) {
+        std::snprintf(bytes, sizeof(bytes), "%04X %04X", raw, operand);
+      } else {
+        std::snprintf(bytes, sizeof(bytes), "%04X", raw);
+      }
+      std::snprintf(line, sizeof(line), "%s%04zX  %-9s  %s%s\n",
+                    starts[address] && address != first ? "\n" : "", address,
+                    bytes, disassemble(raw, set, operand).c_str(),
+                    overwritten ? " ; may be overwritten" : "");
+      out << line;
+      address += long_load ? 4 : 2;
+      continue;
+    }
+
+    // data runs until the next instruction
+    std::snprintf(line, sizeof(line), "%04zX  %-9s  DB", address, "");
+    out << line;
+    for (size_t i = 0; i < DATA_PER_LINE && address < end; i++, address++) {
+      if (i != 0 && analysis.is_instruction(address)) {
+        break;
+      }
+      std::snprintf(line, sizeof(line), "%s 0x%02X", i == 0 ? "" : ",",
+                    memory[address]);
+      out << line;
+    }
+    out << '\n';
+  }
+  return static_cast<bool>(out);
+}
@@ -0,0 +1,104 @@
+/// @file rom_analysis.hpp
+/// @brief static analysis of a loaded program: the control flow graph, the
+/// code and data it touches and whether it can write over its own code
+/// @author Abhay Manoj
+/// @date Oct 14 2026
+#pragma once
+
+#include "opcode.hpp"
+#include "quirks.hpp"
+#include <cstddef>
+#include <cstdint>
+#include <ostream>
+#include <span>
+#include <string>
+#include <vector>
+
+/// @brief the behaviours of a machine the analysis has to follow
+struct AnalysisQuirks {
+  InstructionSet instructions = InstructionSet::CHIP8;
+  bool jump_uses_vx = false;            // BNNN jumps to XNN + V_x
+  bool load_store_increments_i = false; // FX55 and FX65 move I past the range
+
+  /// @brief takes the behaviours from a quirk set
+  /// @tparam Quirks the quirks of the machine
+  /// @return the behaviours
+  template <Chip8Quirks Quirks> static constexpr AnalysisQuirks of() {
+    return {Quirks::INSTRUCTIONS, Quirks::JUMP_USES_VX,
+            Quirks::LOAD_STORE_INCREMENTS_I};
+  }
+};
+
+/// @brief where the analysis starts following the program
+struct AnalysisStart {
+  // the PC and the return addresses on the stack
+  std::vector<uint16_t> entries = {0x200};
+  bool at_reset = true; // the registers hold 0, otherwise nothing is known
+};
+
+/// @brief what following every path through a program found. registers are
+/// tracked as constants where they can be, and I as a range, so the bytes
+/// FX33, FX55 and 5XY2 may write are known without running the program
+struct RomAnalysis {
+  // the bits of each entry of bytes
+  static constexpr uint8_t INSTRUCTION = 1; // a reachable instruction starts
+  static constexpr uint8_t CODE = 2;        // part of a reachable instruction
+  static constexpr uint8_t READ = 4;        // DXYN, FX65, 5XY3 or F002 read
+  static constexpr uint8_t WRITTEN = 8;     // FX33, FX55 or 5XY2 may write
+
+  /// @brief a basic block, entered only at its start and left only at its
+  /// last instruction
+  struct Block {
+    uint16_t start = 0;
+    uint16_t end = 0;                 // one past the last instruction
+    std::vector<uint16_t> successors; // block starts control can go to
+  };
+
+  std::vector<uint8_t> bytes;        // the bits of every address
+  std::vector<Block> blocks;         // sorted by start
+  std::vector<uint16_t> overwritten; // instructions a write may reach
+  bool complete = true; // false if a BNNN target could not be worked out
+
+  /// @brief returns whether an instruction starts at an address
+  /// @param address the address
+  /// @return true if a reachable instruction starts there
+  bool is_instruction(uint16_t address) const {
+    return bytes[address & (bytes.size() - 1)] & INSTRUCTION;
+  }
+
+  /// @brief returns whether the program may change its own code. code no
+  /// path reaches is not looked at, so an incomplete graph never proves it
+  /// @return false only if no write can reach any reachable instruction
+  bool modifies_itself() const { return !complete || !overwritten.empty(); }
+};
+
+/// @brief follows every path through a program in memory
+/// @param memory the whole memory of the machine, a power of 2 bytes
+/// @param quirks the behaviours of the machine
+/// @param start where the paths begin
+/// @return what was found
+RomAnalysis analyze_rom(std::span<const uint8_t> memory,
+                        const AnalysisQuirks &quirks,
+                        const AnalysisStart &start = {});
+
+/// @brief disassembles one instruction in the usual assembler syntax
+/// @param instruction the 2 byte instruction
+/// @param set the instructions understood
+/// @param operand the 2 bytes after F000, the address it loads
+/// @return the text, such as "LD V0, 0x05"
+std::string disassemble(uint16_t instruction,
+                        InstructionSet set = InstructionSet::CHIP8,
+                        uint16_t operand = 0);
+
+/// @brief writes a listing of part of memory, an instruction per line where
+/// the analysis found code and the other bytes as data
+/// @param out the stream to write to
+/// @param memory the whole memory the analysis looked at
+/// @param analysis the result of analyze_rom on it
+/// @param set the instructions understood
+/// @param first the first address to list
+/// @param end one past the last address to list
+/// @return true if everything was written
+bool write_listing(std::ostream &out, std::span<const uint8_t> memory,
+                   const RomAnalysis &analysis, InstructionSet set,
+                   size_t first, size_t end);
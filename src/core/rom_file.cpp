@@ -0,0 +1,91 @@
+/// @file rom_file.cpp
+/// @brief implementation of the RomFile class
+/// @author Abhay Manoj
+/// @date Oct 14 2026
+#include "rom_file.hpp"
+#include <fstream>
+#include <utility>
+
+#if !defined(__EMSCRIPTEN__) && (defined(__unix__) || defined(__APPLE__))
+#define CHIP8_MMAP_ROMS
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+RomFile::~RomFile() { close(); }
+
+RomFile::RomFile(RomFile &&other) noexcept
+    : mapping(std::exchange(other.mapping, nullptr)),
+      size(std::exchange(other.size, 0)), buffer(std::move(other.buffer)) {}
+
+RomFile &RomFile::operator=(RomFile &&other) noexcept {
+  if (this != &other) {
+    close();
+    mapping = std::exchange(other.mapping, nullptr);
+    size = std::exchange(other.size, 0);
+    buffer = std::move(other.buffer);
+  }
+  return *this;
+}
+
+bool RomFile::open(const std::string &path) {
+  close();
+
+#ifdef CHIP8_MMAP_ROMS
+  int fd = ::open(path.c_str(), O_RDONLY);
+  if (fd < 0) {
+    return false;
+  }
+  struct stat info;
+  if (fstat(fd, &info) != 0 || info.st_size <= 0 ||
+      static_cast<size_t>(info.st_size) > MAX_SIZE) {
+    ::close(fd);
+    return false;
+  }
+  void *mapped = mmap(nullptr, info.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+  ::close(fd); // the mapping keeps the file alive
+  if (mapped == MAP_FAILED) {
+    return false;
+  }
+  mapping = mapped;
+  size = info.st_size;
+  return true;
+#else
+  std::ifstream file(path, std::ios::binary | std::ios::ate);
+  if (!file) {
+    return false;
+  }
+  std::streamoff length = file.tellg();
+  if (length <= 0 || static_cast<size_t>(length) > MAX_SIZE) {
+    return false;
+  }
+  buffer.resize(length);
+  file.seekg(0);
+  if (!file.read(reinterpret_cast<char *>(buffer.data()), length)) {
+    buffer.clear();
+    return false;
+  }
+  size = length;
+  return true;
+#endif
+}
+
+void RomFile::close() {
+#ifdef CHIP8_MMAP_ROMS
+  if (mapping != nullptr) {
+    munmap(mapping, size);
+  }
+#endif
+  mapping = nullptr;
+  size = 0;
+  buffer.clear();
+}
+
+std::span<const uint8_t> RomFile::get_bytes() const {
+  if (mapping != nullptr) {
+    return {static_cast<const uint8_t *>(mapping), size};
+  }
+  return {buffer.data(), size};
+}
@@ -0,0 +1,57 @@
+/// @file rom_file.hpp
+/// @brief declaration of the RomFile class
+/// @author Abhay Manoj
+/// @date Oct 14 2026
+#pragma once
+
+#include "chip8.hpp"
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <string>
+#include <vector>
+
+/// @brief a rom file opened read only. on POSIX the file is mapped so the
+/// bytes are read straight from the page cache, elsewhere (and under
+/// emscripten, whose embedded files already live in memory) it is read once
+/// into a buffer
+class RomFile {
+public:
+  /// @brief the largest rom that fits in memory after START, on XO-CHIP
+  /// which has the most memory
+  static constexpr size_t MAX_SIZE =
+      BasicChip8<XoChipQuirks>::MEMORY_SIZE - Chip8::START;
+
+private:
+  void *mapping = nullptr;     // the mapped file, nullptr if not mapped
+  size_t size = 0;             // the size of the rom in bytes
+  std::vector<uint8_t> buffer; // holds the rom where it is not mapped
+
+public:
+  RomFile() = default;
+  ~RomFile();
+
+  RomFile(const RomFile &) = delete;
+  RomFile &operator=(const RomFile &) = delete;
+
+  /// @brief takes over the file of another RomFile
+  /// @param other the file to take over, left closed
+  RomFile(RomFile &&other) noexcept;
+
+  /// @brief takes over the file of another RomFile
+  /// @param other the file to take over, left closed
+  /// @return this file
+  RomFile &operator=(RomFile &&other) noexcept;
+
+  /// @brief opens a rom, closing any rom opened before
+  /// @param path the path of the rom
+  /// @return true if the file could be read and is 1 to MAX_SIZE bytes
+  bool open(const std::string &path);
+
+  /// @brief releases the rom, get_bytes is empty afterwards
+  void close();
+
+  /// @brief returns the bytes of the rom
+  /// @return the bytes, valid until the file is closed
+  std::span<const uint8_t> get_bytes() const;
+};
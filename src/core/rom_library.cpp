@@ -0,0 +1,213 @@
+/// @file rom_library.cpp
+/// @brief implementation of the rom library index
+/// @author Abhay Manoj
+/// @date Oct 14 2026
+#include "rom_library.hpp"
+#include "byte_stream.hpp"
+#include "chip8.hpp"
+#include "input_movie.hpp"
+#include "rom_file.hpp"
+#include <algorithm>
+#include <cstring>
+#include <filesystem>
+#include <utility>
+
+/// @brief checks for an instruction only XO-CHIP has
+/// @param word the instruction
+/// @return true if it is 00DN, 5XY2, 5XY3, F000, FN01, F002 or FX3A
+static bool is_xo_chip(uint16_t word) {
+  return (word & 0xFFF0) == 0x00D0 || (word & 0xF00E) == 0x5002 ||
+         word == 0xF000 || (word & 0xF0FF) == 0xF001 || word == 0xF002 ||
+         (word & 0xF0FF) == 0xF03A;
+}
+
+/// @brief checks for an instruction SUPER-CHIP added
+/// @param word the instruction
+/// @return true if it is 00CN, 00FB - 00FF, DXY0, FX30, FX75 or FX85
+static bool is_super_chip(uint16_t word) {
+  return ((word & 0xFFF0) == 0x00C0 && word != 0x00C0) ||
+         (word >= 0x00FB && word <= 0x00FF) || (word & 0xF00F) == 0xD000 ||
+         (word & 0xF0FF) == 0xF030 || (word & 0xF0FF) == 0xF075 ||
+         (word & 0xF0FF) == 0xF085;
+}
+
+RomProfile detect_profile(std::span<const uint8_t> rom) {
+  // follow the control flow from START so sprite data is never decoded
+  std::vector<bool> visited(rom.size(), false);
+  std::vector<size_t> pending = {0};
+  RomProfile profile = RomProfile::CHIP8;
+
+  while (!pending.empty()) {
+    size_t offset = pending.back();
+    pending.pop_back();
+    if (offset + 1 >= rom.size() || visited[offset]) {
+      continue;
+    }
+    visited[offset] = true;
+
+    uint16_t word = (rom[offset] << 8) | rom[offset + 1];
+    if (is_xo_chip(word)) {
+      return RomProfile::XO_CHIP;
+    }
+    if (is_super_chip(word)) {
+      profile = RomProfile::SUPER_CHIP;
+    }
+
+    Instruction instruction = decode(word);
+    size_t target = instruction.nnn - Chip8::START; // wraps below START
+    switch (instruction.op) {
+    case Op::JUMP:
+      pending.push_back(target);
+      break;
+    case Op::CALL:
+      pending.push_back(target);
+      pending.push_back(offset + 2);
+      break;
+    case Op::RET:
+    case Op::JUMP_OFF_REGISTER: // the target is not known statically
+      break;
+    case Op::SKIP_NEXT_IF_EQUAL_BYTE:
+    case Op::SKIP_NEXT_IF_NOT_EQUAL_BYTE:
+    case Op::SKIP_NEXT_IF_EQUAL_REGISTERS:
+    case Op::SKIP_NEXT_IF_NOT_EQUAL_REGISTERS:
+    case Op::SKIP_IF_PRESSED:
+    case Op::SKIP_IF_NOT_PRESSED:
+      pending.push_back(offset + 2);
+      pending.push_back(offset + 4);
+      break;
+    default:
+      pending.push_back(offset + 2);
+    }
+  }
+  return profile;
+}
+
+/// @brief checks whether a file has one of the rom extensions
+/// @param path the path of the file
+/// @return true if scan should index the file
+static bool is_rom_path(const std::filesystem::path &path) {
+  std::string extension = path.extension().string();
+  return std::any_of(std::begin(RomLibrary::ROM_EXTENSIONS),
+                     std::end(RomLibrary::ROM_EXTENSIONS),
+                     [&](const char *rom) { return extension == rom; });
+}
+
+bool RomLibrary::scan(const std::string &directory) {
+  namespace fs = std::filesystem;
+  std::error_code error;
+  fs::recursive_directory_iterator it(directory, error);
+  if (error) {
+    return false;
+  }
+
+  std::vector<RomEntry> found;
+  size_t read = 0;
+  for (; it != fs::recursive_directory_iterator(); it.increment(error)) {
+    if (error) {
+      return false;
+    }
+    const fs::directory_entry &file = *it;
+    if (!file.is_regular_file(error) || !is_rom_path(file.path())) {
+      continue;
+    }
+
+    RomEntry entry;
+    entry.path = file.path().string();
+    entry.size = file.file_size(error);
+    entry.modified = file.last_write_time(error).time_since_epoch().count();
+    if (error) {
+      continue;
+    }
+
+    const RomEntry *cached = find(entry.path);
+    if (cached != nullptr && cached->size == entry.size &&
+        cached->modified == entry.modified) {
+      found.push_back(*cached);
+      continue;
+    }
+
+    // too large or unreadable files are left out
+    RomFile rom;
+    if (!rom.open(entry.path)) {
+      continue;
+    }
+    read++;
+    entry.hash = hash_rom(*Chip8::make_memory_image(rom.get_bytes()));
+    entry.profile = detect_profile(rom.get_bytes());
+    found.push_back(std::move(entry));
+  }
+
+  std::sort(found.begin(), found.end(),
+            [](const RomEntry &a, const RomEntry &b) { return a.path < b.path; });
+  entries = std::move(found);
+  paths.clear();
+  for (size_t i = 0; i < entries.size(); i++) {
+    paths.emplace(entries[i].path, i);
+  }
+  files_read = read;
+  return true;
+}
+
+const std::vector<RomEntry> &RomLibrary::get_entries() const { return entries; }
+
+const RomEntry *RomLibrary::find(const std::string &path) const {
+  auto it = paths.find(path);
+  return it != paths.end() ? &entries[it->second] : nullptr;
+}
+
+size_t RomLibrary::get_files_read() const { return files_read; }
+
+bool RomLibrary::write_index(std::ostream &out) const {
+  out.write(ROM_INDEX_MAGIC, sizeof(ROM_INDEX_MAGIC));
+  put_le(out, ROM_INDEX_VERSION, 4);
+  put_le(out, entries.size(), 4);
+
+  for (const RomEntry &entry : entries) {
+    put_le(out, entry.path.size(), 2);
+    out.write(entry.path.data(), entry.path.size());
+    put_le(out, entry.size, 8);
+    put_le(out, static_cast<uint64_t>(entry.modified), 8);
+    put_le(out, entry.hash, 8);
+    put_le(out, static_cast<uint8_t>(entry.profile), 1);
+  }
+  return static_cast<bool>(out);
+}
+
+bool RomLibrary::read_index(std::istream &in) {
+  char magic[sizeof(ROM_INDEX_MAGIC)];
+  if (!in.read(magic, sizeof(magic)) ||
+      std::memcmp(magic, ROM_INDEX_MAGIC, sizeof(magic)) != 0) {
+    return false;
+  }
+
+  uint64_t version, count;
+  if (!get_le(in, 4, version) || version != ROM_INDEX_VERSION ||
+      !get_le(in, 4, count)) {
+    return false;
+  }
+
+  std::vector<RomEntry> loaded;
+  std::unordered_map<std::string, size_t> loaded_paths;
+  for (uint64_t i = 0; i < count; i++) {
+    RomEntry entry;
+    uint64_t length, modified, profile;
+    if (!get_le(in, 2, length)) {
+      return false;
+    }
+    entry.path.resize(length);
+    if (!in.read(entry.path.data(), length) || !get_le(in, 8, entry.size) ||
+        !get_le(in, 8, modified) || !get_le(in, 8, entry.hash) ||
+        !get_le(in, 1, profile) ||
+        profile > static_cast<uint8_t>(RomProfile::XO_CHIP)) {
+      return false;
+    }
+    entry.modified = static_cast<int64_t>(modified);
+    entry.profile = static_cast<RomProfile>(profile);
+    loaded_paths.emplace(entry.path, loaded.size());
+    loaded.push_back(std::move(entry));
+  }
+
+  entries = std::move(loaded);
+  paths = std::move(loaded_paths);
+  return true;
+}
@@ -0,0 +1,85 @@
+/// @file rom_library.hpp
+/// @brief an index of the roms in a directory, cached between runs
+/// @author Abhay Manoj
+/// @date Oct 14 2026
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <istream>
+#include <ostream>
+#include <span>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+// an index file is a header followed by one record per rom: the path as a
+// 2 byte length and its bytes, then the size, modification time, hash and
+// profile. every value is little endian
+static constexpr char ROM_INDEX_MAGIC[4] = {'C', '8', 'R', 'I'};
+static constexpr uint32_t ROM_INDEX_VERSION = 1; // bump on any format change
+
+/// @brief the platform a rom appears to be written for
+enum class RomProfile : uint8_t {
+  CHIP8,      // only the original instructions
+  SUPER_CHIP, // uses scrolling, hi-res or the large font
+  XO_CHIP,    // uses bitplanes, long loads or audio patterns
+};
+
+/// @brief guesses the platform of a rom from the instructions reachable
+/// from START through jumps, calls and skips. code only reached through
+/// BNNN is not seen
+/// @param rom the bytes of the rom, loaded at Chip8::START
+/// @return the newest platform with a reachable instruction in the rom
+RomProfile detect_profile(std::span<const uint8_t> rom);
+
+/// @brief what the library knows about one rom file
+struct RomEntry {
+  std::string path;
+  uint64_t size = 0;     // bytes
+  int64_t modified = 0;  // the file time when the entry was made
+  uint64_t hash = 0;     // hash_rom of the rom loaded into memory
+  RomProfile profile = RomProfile::CHIP8;
+};
+
+/// @brief the roms in a directory tree. an index saved by one run lets the
+/// next scan skip every file whose size and modification time are unchanged
+class RomLibrary {
+  std::vector<RomEntry> entries;                 // sorted by path
+  std::unordered_map<std::string, size_t> paths; // index into entries
+  size_t files_read = 0; // files the last scan had to open
+
+public:
+  /// @brief the file extensions scan treats as roms
+  static constexpr const char *ROM_EXTENSIONS[] = {".ch8", ".c8", ".sc8",
+                                                   ".xo8"};
+
+  /// @brief finds every rom under a directory, reusing the entries of files
+  /// that have not changed and dropping the entries of files that are gone
+  /// @param directory the directory to search recursively
+  /// @return true if the directory could be read
+  bool scan(const std::string &directory);
+
+  /// @brief returns the rom entries
+  /// @return the entries, sorted by path
+  const std::vector<RomEntry> &get_entries() const;
+
+  /// @brief looks up the entry of a rom
+  /// @param path the path as it appears in the entries
+  /// @return the entry, nullptr if the library has none for the path
+  const RomEntry *find(const std::string &path) const;
+
+  /// @brief returns the number of files the last scan opened
+  /// @return the files that were new or had changed
+  size_t get_files_read() const;
+
+  /// @brief writes the entries as an index file
+  /// @param out the stream to write to
+  /// @return true if the whole index was written
+  bool write_index(std::ostream &out) const;
+
+  /// @brief replaces the entries with those of an index file
+  /// @param in the stream to read from
+  /// @return true if the index was valid, the entries are untouched if not
+  bool read_index(std::istream &in);
+};
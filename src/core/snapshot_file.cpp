@@ -0,0 +1,44 @@
+/// @file snapshot_file.cpp
+/// @brief implementation of the snapshot file format
+/// @author Abhay Manoj
+/// @date Oct 14 2026
+#include "snapshot_file.hpp"
+#include <cstring>
+
+/// @brief the header written before every snapshot
+struct SnapshotHeader {
+  char magic[4];
+  uint32_t version;
+  uint32_t size; // sizeof(Chip8::Snapshot), catches mismatched builds
+};
+
+bool write_snapshot(std::ostream &out, const Chip8::Snapshot &snapshot) {
+  SnapshotHeader header;
+  std::memcpy(header.magic, SNAPSHOT_MAGIC, sizeof(header.magic));
+  header.version = SNAPSHOT_VERSION;
+  header.size = sizeof(Chip8::Snapshot);
+
+  out.write(reinterpret_cast<const char *>(&header), sizeof(header));
+  out.write(reinterpret_cast<const char *>(&snapshot), sizeof(snapshot));
+  return static_cast<bool>(out);
+}
+
+bool read_snapshot(std::istream &in, Chip8::Snapshot &snapshot) {
+  SnapshotHeader header;
+  if (!in.read(reinterpret_cast<char *>(&header), sizeof(header))) {
+    return false;
+  }
+
+  if (std::memcmp(header.magic, SNAPSHOT_MAGIC, sizeof(header.magic)) != 0 ||
+      header.version != SNAPSHOT_VERSION ||
+      header.size != sizeof(Chip8::Snapshot)) {
+    return false;
+  }
+
+  Chip8::Snapshot loaded;
+  if (!in.read(reinterpret_cast<char *>(&loaded), sizeof(loaded))) {
+    return false;
+  }
+  snapshot = loaded;
+  return true;
+}
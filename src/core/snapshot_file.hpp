@@ -0,0 +1,27 @@
+/// @file snapshot_file.hpp
+/// @brief versioned binary format for saving Chip8 snapshots to disk
+/// @author Abhay Manoj
+/// @date Oct 14 2026
+#pragma once
+
+#include "chip8.hpp"
+#include <cstdint>
+#include <istream>
+#include <ostream>
+
+// a snapshot file is a 12 byte header followed by the raw Chip8::Snapshot,
+// all values are in host byte order (little endian on every supported target)
+static constexpr char SNAPSHOT_MAGIC[4] = {'C', '8', 'S', 'S'};
+static constexpr uint32_t SNAPSHOT_VERSION = 3; // bump on any layout change
+
+/// @brief writes a snapshot with its header
+/// @param out the stream to write to
+/// @param snapshot the snapshot to write
+/// @return true if the whole snapshot was written
+bool write_snapshot(std::ostream &out, const Chip8::Snapshot &snapshot);
+
+/// @brief reads a snapshot written by write_snapshot
+/// @param in the stream to read from
+/// @param snapshot filled with the snapshot, untouched on failure
+/// @return true if the header matched and the whole snapshot was read
+bool read_snapshot(std::istream &in, Chip8::Snapshot &snapshot);
@@ -0,0 +1,50 @@
+/// @file spsc_queue.hpp
+/// @brief a lock free queue with a single producer and a single consumer
+/// @author Abhay Manoj
+/// @date Oct 14 2026
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+
+/// @brief a bounded ring of values pushed by one thread and popped by
+/// another, without locks. each side only writes its own index
+/// @tparam T the type of the values
+/// @tparam Capacity the most values queued at once, a power of 2
+template <typename T, size_t Capacity> class SpscQueue {
+  static_assert(Capacity != 0 && (Capacity & (Capacity - 1)) == 0,
+                "the capacity must be a power of 2");
+  static constexpr size_t CACHE_LINE = 64;
+
+  std::array<T, Capacity> items{};
+  alignas(CACHE_LINE) std::atomic<size_t> head = 0; // next to pop
+  alignas(CACHE_LINE) std::atomic<size_t> tail = 0; // next to push
+
+public:
+  /// @brief adds a value, only for the producer
+  /// @param item the value
+  /// @return false if the queue is full and the value was dropped
+  bool push(const T &item) {
+    size_t next = tail.load(std::memory_order_relaxed);
+    if (next - head.load(std::memory_order_acquire) == Capacity) {
+      return false;
+    }
+    items[next % Capacity] = item;
+    tail.store(next + 1, std::memory_order_release);
+    return true;
+  }
+
+  /// @brief takes the oldest value, only for the consumer
+  /// @param item filled with the value
+  /// @return false if the queue is empty
+  bool pop(T &item) {
+    size_t next = head.load(std::memory_order_relaxed);
+    if (next == tail.load(std::memory_order_acquire)) {
+      return false;
+    }
+    item = items[next % Capacity];
+    head.store(next + 1, std::memory_order_release);
+    return true;
+  }
+};
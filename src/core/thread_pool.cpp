@@ -0,0 +1,106 @@
+/// @file thread_pool.cpp
+/// @brief implementation of the ThreadPool class
+/// @author Abhay Manoj
+/// @date Oct 14 2026
+#include "thread_pool.hpp"
+#include <algorithm>
+#include <utility>
+
+ThreadPool::ThreadPool(size_t thread_count) {
+  if (thread_count == 0) {
+    thread_count = std::max(1u, std::thread::hardware_concurrency());
+  }
+
+  for (size_t i = 0; i < thread_count; i++) {
+    queues.push_back(std::make_unique<WorkQueue>());
+  }
+
+  for (size_t i = 0; i < thread_count; i++) {
+    workers.emplace_back([this, i] { worker_loop(i); });
+  }
+}
+
+ThreadPool::~ThreadPool() {
+  wait();
+  {
+    std::lock_guard lock(state_mutex);
+    stopping = true;
+  }
+  work_available.notify_all();
+
+  for (auto &worker : workers) {
+    worker.join();
+  }
+}
+
+void ThreadPool::submit(Task task) {
+  // count the task before it is visible so a fast worker can't finish it
+  // before pending is raised
+  {
+    std::lock_guard lock(state_mutex);
+    pending++;
+    queued++;
+  }
+
+  size_t index = next_queue++ % queues.size();
+  {
+    std::lock_guard lock(queues[index]->mutex);
+    queues[index]->tasks.push_back(std::move(task));
+  }
+  work_available.notify_one();
+}
+
+void ThreadPool::wait() {
+  std::unique_lock lock(state_mutex);
+  all_done.wait(lock, [this] { return pending == 0; });
+}
+
+size_t ThreadPool::size() const { return workers.size(); }
+
+bool ThreadPool::try_pop(size_t index, Task &task) {
+  // own queue first, newest task is the most likely to be cache warm
+  {
+    WorkQueue &own = *queues[index];
+    std::lock_guard lock(own.mutex);
+    if (!own.tasks.empty()) {
+      task = std::move(own.tasks.back());
+      own.tasks.pop_back();
+      queued--;
+      return true;
+    }
+  }
+
+  // steal the oldest task from the other workers
+  for (size_t i = 1; i < queues.size(); i++) {
+    WorkQueue &victim = *queues[(index + i) % queues.size()];
+    std::lock_guard lock(victim.mutex);
+    if (!victim.tasks.empty()) {
+      task = std::move(victim.tasks.front());
+      victim.tasks.pop_front();
+      queued--;
+      return true;
+    }
+  }
+
+  return false;
+}
+
+void ThreadPool::worker_loop(size_t index) {
+  while (true) {
+    Task task;
+    if (try_pop(index, task)) {
+      task();
+      std::lock_guard lock(state_mutex);
+      if (--pending == 0) {
+        all_done.notify_all();
+      }
+      continue;
+    }
+
+    std::unique_lock lock(state_mutex);
+    work_available.wait(lock, [this] { return stopping || queued > 0; });
+    if (stopping && queued == 0) {
+      return;
+    }
+  }
+}
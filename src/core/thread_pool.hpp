@@ -0,0 +1,73 @@
+/// @file thread_pool.hpp
+/// @brief declaration of the ThreadPool class
+/// @author Abhay Manoj
+/// @date Oct 14 2026
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+/// @brief a fixed size work-stealing thread pool. every worker owns a queue,
+/// pops its own work from the back and steals from the front of the others
+class ThreadPool {
+public:
+  using Task = std::function<void()>;
+
+private:
+  /// @brief the per worker task queue
+  struct WorkQueue {
+    std::mutex mutex;
+    std::deque<Task> tasks;
+  };
+
+  std::vector<std::unique_ptr<WorkQueue>> queues;
+  std::vector<std::thread> workers;
+
+  std::mutex state_mutex;
+  std::condition_variable work_available;
+  std::condition_variable all_done;
+
+  std::atomic<size_t> next_queue = 0; // round robin target for submit
+  std::atomic<size_t> queued = 0;     // tasks sitting in a queue
+  size_t pending = 0;                 // tasks submitted but not finished
+  bool stopping = false;
+
+  /// @brief pops a task from the worker's own queue, or steals one
+  /// @param index the index of the worker looking for work
+  /// @param task filled with the task that was found
+  /// @return true if a task was found
+  bool try_pop(size_t index, Task &task);
+
+  /// @brief the loop each worker thread runs until the pool is destroyed
+  /// @param index the index of the worker
+  void worker_loop(size_t index);
+
+public:
+  /// @brief starts the worker threads
+  /// @param thread_count the number of workers, 0 uses every hardware thread
+  explicit ThreadPool(size_t thread_count = 0);
+
+  /// @brief finishes the queued work and joins the workers
+  ~ThreadPool();
+
+  ThreadPool(const ThreadPool &) = delete;
+  ThreadPool &operator=(const ThreadPool &) = delete;
+
+  /// @brief queues a task to run on one of the workers
+  /// @param task the task to run
+  void submit(Task task);
+
+  /// @brief blocks until every submitted task has finished
+  void wait();
+
+  /// @brief returns the number of worker threads
+  /// @return the number of worker threads
+  size_t size() const;
+};
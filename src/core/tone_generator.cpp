@@ -0,0 +1,55 @@
+/// @file tone_generator.cpp
+/// @brief implementation of the ToneGenerator class
+/// @author Abhay Manoj
+/// @date Oct 14 2026
+#include "tone_generator.hpp"
+
+static constexpr uint64_t NANOSECONDS_PER_SECOND = 1'000'000'000;
+
+ToneGenerator::ToneGenerator(uint32_t sample_rate, uint32_t frequency,
+                             float volume)
+    : sample_rate(sample_rate), frequency(frequency), volume(volume),
+      latency(DEFAULT_LATENCY) {}
+
+void ToneGenerator::set_buzzer(uint64_t time, bool on) {
+  edges.push({time, on});
+}
+
+void ToneGenerator::set_machine_time(uint64_t time) {
+  machine_time.store(time, std::memory_order_release);
+}
+
+void ToneGenerator::set_latency(uint64_t nanoseconds) {
+  latency = nanoseconds;
+}
+
+void ToneGenerator::render(float *out, size_t count) {
+  // the audio and host clocks drift apart, and a rewind or stall moves the
+  // machine. edges older than the new position apply at once
+  uint64_t now = machine_time.load(std::memory_order_acquire);
+  if (sample_time > now || now - sample_time > 2 * latency) {
+    sample_time = now > latency ? now - latency : 0;
+    sample_fraction = 0;
+  }
+
+  for (size_t i = 0; i < count; i++) {
+    while (has_next || (has_next = edges.pop(next))) {
+      if (next.time > sample_time) {
+        break;
+      }
+      on = next.on;
+      has_next = false;
+    }
+
+    // the phase keeps running while silent, so the wave never restarts
+    out[i] = on ? (phase < sample_rate / 2 ? volume : -volume) : 0.0f;
+    phase += frequency;
+    if (phase >= sample_rate) {
+      phase -= sample_rate;
+    }
+
+    sample_fraction += NANOSECONDS_PER_SECOND;
+    sample_time += sample_fraction / sample_rate;
+    sample_fraction %= sample_rate;
+  }
+}
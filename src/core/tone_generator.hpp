@@ -0,0 +1,78 @@
+/// @file tone_generator.hpp
+/// @brief declaration of the ToneGenerator class
+/// @author Abhay Manoj
+/// @date Oct 14 2026
+#pragma once
+
+#include "spsc_queue.hpp"
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
+/// @brief plays the buzzer of a machine as a square wave, generated sample
+/// by sample on the audio thread. the machine reports every buzzer edge
+/// stamped with the emulated time of the instruction or tick that caused it,
+/// and the audio clock trails the machine by a bounded latency, so the tone
+/// starts and stops on the right sample whatever the frame timing
+class ToneGenerator {
+public:
+  static constexpr uint32_t DEFAULT_FREQUENCY = 432;
+  static constexpr float DEFAULT_VOLUME = 0.3f;
+  // how far the audio trails the machine, a frame and an audio buffer
+  static constexpr uint64_t DEFAULT_LATENCY = 40'000'000;
+  static constexpr size_t EDGE_CAPACITY = 256; // edges between two renders
+
+private:
+  /// @brief the buzzer turning on or off
+  struct Edge {
+    uint64_t time = 0; // emulated nanoseconds
+    bool on = false;
+  };
+
+  uint32_t sample_rate;
+  uint32_t frequency;
+  float volume;
+  uint64_t latency;
+
+  // written by the machine thread
+  SpscQueue<Edge, EDGE_CAPACITY> edges;
+  std::atomic<uint64_t> machine_time = 0; // emulated time the machine reached
+
+  // owned by the audio thread
+  uint64_t sample_time = 0;     // emulated time of the next sample
+  uint64_t sample_fraction = 0; // of a nanosecond, in 1 / sample_rate
+  uint32_t phase = 0;           // in the wave period, in 1 / sample_rate
+  bool on = false;
+  Edge next;              // the first edge not applied yet
+  bool has_next = false;  // next holds an edge
+
+public:
+  /// @brief creates a silent generator
+  /// @param sample_rate the samples per second of the output
+  /// @param frequency the pitch of the tone in Hz
+  /// @param volume the amplitude of the square wave
+  explicit ToneGenerator(uint32_t sample_rate,
+                         uint32_t frequency = DEFAULT_FREQUENCY,
+                         float volume = DEFAULT_VOLUME);
+
+  /// @brief reports an edge of the buzzer, called by the machine. dropped if
+  /// the audio thread has stopped rendering
+  /// @param time the emulated time of the edge in nanoseconds
+  /// @param on true if the buzzer turned on
+  void set_buzzer(uint64_t time, bool on);
+
+  /// @brief reports how far the machine has run, called after every frame
+  /// @param time the emulated time in nanoseconds
+  void set_machine_time(uint64_t time);
+
+  /// @brief sets how far the audio trails the machine. the audio clock is
+  /// pulled back to this when it falls behind by twice as much, or gets
+  /// ahead of the machine
+  /// @param nanoseconds the latency
+  void set_latency(uint64_t nanoseconds);
+
+  /// @brief generates the next samples, called by the audio thread
+  /// @param out filled with the samples
+  /// @param count the number of samples
+  void render(float *out, size_t count);
+};
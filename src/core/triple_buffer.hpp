@@ -0,0 +1,51 @@
+/// @file triple_buffer.hpp
+/// @brief a lock free triple buffer for handing frames from one thread to
+/// another
+/// @author Abhay Manoj
+/// @date Oct 14 2026
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+
+/// @brief three copies of a value shared by one writer and one reader. the
+/// writer fills the back copy and publishes it, the reader takes the newest
+/// published copy. neither side ever waits, frames the reader is too slow for
+/// are dropped
+/// @tparam T the type of the value, copied in and out by the caller
+template <typename T> class TripleBuffer {
+  static constexpr uint8_t INDEX = 3; // the bits of middle naming a copy
+  static constexpr uint8_t FRESH = 4; // set while middle is unread
+  static constexpr size_t CACHE_LINE = 64;
+
+  std::array<T, 3> copies{};
+  alignas(CACHE_LINE) std::atomic<uint8_t> middle = 1; // the copy in between
+  alignas(CACHE_LINE) uint8_t back = 0;  // the copy the writer fills
+  alignas(CACHE_LINE) uint8_t front = 2; // the copy the reader holds
+
+public:
+  /// @brief returns the copy to fill, only for the writer
+  /// @return the back copy, still holding whatever it last held
+  T &get_back() { return copies[back]; }
+
+  /// @brief hands the back copy to the reader, only for the writer
+  void publish() {
+    back = middle.exchange(back | FRESH, std::memory_order_acq_rel) & INDEX;
+  }
+
+  /// @brief takes the newest published copy if there is one, only for the
+  /// reader
+  /// @return true if get_front changed
+  bool update() {
+    if ((middle.load(std::memory_order_relaxed) & FRESH) == 0) {
+      return false;
+    }
+    front = middle.exchange(front, std::memory_order_acq_rel) & INDEX;
+    return true;
+  }
+
+  /// @brief returns the copy the reader holds, only for the reader
+  /// @return the front copy
+  const T &get_front() const { return copies[front]; }
+};
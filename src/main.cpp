@@ -5,39 +5,248 @@
 
 #define SDL_MAIN_USE_CALLBACKS 1
 #include "core/chip8.hpp"
+#include "core/input_movie.hpp"
+#include "core/input_queue.hpp"
+#include "core/quirks.hpp"
+#include "core/rewind_buffer.hpp"
+#include "core/rom_file.hpp"
+#include "core/rom_library.hpp"
+#include "core/tone_generator.hpp"
+#include "core/triple_buffer.hpp"
 #include <SDL3/SDL.h>
 #include <SDL3/SDL_audio.h>
 #include <SDL3/SDL_init.h>
 #include <SDL3/SDL_main.h>
 #include <SDL3/SDL_rect.h>
 #include <SDL3/SDL_render.h>
-#include <cmath>
-#include <emscripten.h>
+#include <algorithm>
+#include <atomic>
+#include <cstdlib>
+#include <cstring>
 #include <fstream>
 #include <memory>
+#include <random>
+#include <span>
+#include <string>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include <variant>
+#include <vector>
+
+#ifdef __EMSCRIPTEN__
+#include <emscripten.h>
+#else
+#define EMSCRIPTEN_KEEPALIVE // only the web build exports functions to js
+#endif
 
 static constexpr size_t SCALING_FACTOR = 16;
 static constexpr size_t WINDOW_HEIGHT = Chip8::HEIGHT * SCALING_FACTOR;
 static constexpr size_t WINDOW_WIDTH = Chip8::WIDTH * SCALING_FACTOR;
 static constexpr size_t FRAME_RATE = 60;
 static constexpr size_t SAMPLE_RATE = 48000;
-static constexpr size_t SAMPLES = SAMPLE_RATE / FRAME_RATE;
-static constexpr size_t CYCLES_PER_FRAME = 10;
+static constexpr size_t AUDIO_CHUNK = 256; // samples generated at a time
+static constexpr uint64_t MAX_FRAME_TIME_NS = 100'000'000; // after a stall
+static constexpr size_t REWIND_BUDGET_MB = 8; // bytes of history, in MB
+static constexpr size_t MAX_REWIND_BUDGET_MB = 1024; // for --rewind-mb
+static constexpr uint64_t FRAME_NS = 1'000'000'000 / FRAME_RATE;
+static constexpr size_t INPUT_QUEUE_SIZE = 64; // key edges between frames
+static constexpr uint32_t MAX_TURBO_FRAMES = 1000;  // per host frame
+static constexpr uint64_t TURBO_BUDGET_NS = FRAME_NS * 3 / 4; // spent on them
+static constexpr size_t PLANE_WORDS = // display words in a hi-res plane
+    Chip8::HIRES_WIDTH / 64 * Chip8::HIRES_HEIGHT;
+
+/// @brief the quirk profiles the frontend can run, in the order of Machine
+enum class QuirkChoice {
+  DEFAULT, // DefaultQuirks
+  COSMAC_VIP,
+  CHIP48,
+  SUPER_CHIP,
+  XO_CHIP,
+  DETECT, // from the profile detect_profile finds in the rom
+};
+
+/// @brief a machine of any profile, indexed by QuirkChoice
+using Machine =
+    std::variant<Chip8, BasicChip8<CosmacVipQuirks>, BasicChip8<Chip48Quirks>,
+                 BasicChip8<SuperChipQuirks>, BasicChip8<XoChipQuirks>>;
+
+/// @brief a finished display, published by the core thread
+struct Frame {
+  std::array<uint64_t, PLANE_WORDS * Chip8::PLANE_COUNT> display{};
+  int width = Chip8::WIDTH;
+  int height = Chip8::HEIGHT;
+  uint64_t generation = 0; // the display generation it was copied at
+};
 
 /// @brief contains the window, renderer, and cpu
 struct AppState {
   SDL_Window *window = nullptr;
   SDL_Renderer *renderer = nullptr;
-  float audio_data[SAMPLES];
+  SDL_Texture *texture = nullptr; // the 128 x 64 display, scaled by the GPU
+  std::array<uint32_t, Chip8::HIRES_WIDTH * Chip8::HIRES_HEIGHT> pixels{};
+  uint64_t presented_generation = UINT64_MAX; // display generation on texture
+  uint64_t last_iterate_ns = 0;               // host time of the last frame
   SDL_AudioStream *stream = nullptr;
-  std::unique_ptr<Chip8> cpu;
+  ToneGenerator tone{SAMPLE_RATE, Chip8::FREQUENCY}; // fed by the machine
+  Machine cpu; // follows the profile of the loaded rom
+  QuirkChoice quirks = QuirkChoice::DETECT;
+  uint64_t seed = 0; // given to every machine the frontend makes
+  RewindBuffer rewind{REWIND_BUDGET_MB << 20}; // or --rewind-mb
+  InputQueue<INPUT_QUEUE_SIZE> inputs; // key edges for the machine
+  std::atomic<bool> rewinding = false; // backspace is held
+  std::atomic<bool> turbo = false;     // tab is held
+
+  // turbo runs this many emulated frames per host frame and shows the last,
+  // adaptive picks as many as fit in TURBO_BUDGET_NS. owned by the thread
+  // running the machine
+  bool adaptive_turbo = true;
+  uint32_t turbo_frames = 8;
+  bool muted = false; // the tone generator is detached during turbo
+  uint64_t rom_hash = 0;
+  std::string movie_path; // keypad input is recorded here if set
+  InputMovie movie;
   uint8_t r = 0xFF;
   uint8_t g = 0xFF;
   uint8_t b = 0xFF;
+
+  // with --threaded the core runs on its own thread and only these are shared
+  bool threaded = false;
+  std::thread core_thread;
+  std::atomic<bool> stopping = false;             // asks core_thread to return
+  TripleBuffer<Frame> frames;                     // displays for the renderer
+  uint64_t published_generation = UINT64_MAX;     // owned by core_thread
+
+  // wasm memory handed out to js by the exported functions
+  std::vector<uint8_t> rom_upload; // a rom js copies in for chip8_load_rom
+  std::vector<uint8_t> exported;   // the blob of chip8_snapshot
 };
 
 static AppState *global_state = nullptr;
 
+/// @brief parses the name of a quirk profile, as the runner names them
+/// @param name the name
+/// @param quirks filled with the profile
+/// @return false if the name is unknown
+static bool parse_quirks(const std::string &name, QuirkChoice &quirks) {
+  if (name == "default") {
+    quirks = QuirkChoice::DEFAULT;
+  } else if (name == "vip") {
+    quirks = QuirkChoice::COSMAC_VIP;
+  } else if (name == "chip48") {
+    quirks = QuirkChoice::CHIP48;
+  } else if (name == "schip") {
+    quirks = QuirkChoice::SUPER_CHIP;
+  } else if (name == "xochip") {
+    quirks = QuirkChoice::XO_CHIP;
+  } else if (name == "detect") {
+    quirks = QuirkChoice::DETECT;
+  } else {
+    return false;
+  }
+  return true;
+}
+
+/// @brief picks the profile a rom runs with
+/// @param quirks the choice on the command line
+/// @param bytes the rom
+/// @return the choice, with DETECT replaced by the profile of the rom
+static QuirkChoice rom_quirks(QuirkChoice quirks,
+                              std::span<const uint8_t> bytes) {
+  if (quirks != QuirkChoice::DETECT) {
+    return quirks;
+  }
+  switch (detect_profile(bytes)) {
+  case RomProfile::SUPER_CHIP:
+    return QuirkChoice::SUPER_CHIP;
+  case RomProfile::XO_CHIP:
+    return QuirkChoice::XO_CHIP;
+  default:
+    return QuirkChoice::DEFAULT;
+  }
+}
+
+/// @brief replaces the machine with one following a profile, seeded and
+/// heard like the last one. a machine of that profile already is kept
+/// @param state contains the current appstate
+/// @param quirks the profile, not DETECT
+static void set_profile(AppState *state, QuirkChoice quirks) {
+  if (state->cpu.index() == static_cast<size_t>(quirks)) {
+    return;
+  }
+  // the old machine can't turn its buzzer off once it is gone
+  std::visit(
+      [state](auto &cpu) {
+        state->tone.set_buzzer(cpu.get_emulated_time().count(), false);
+      },
+      state->cpu);
+
+  switch (quirks) {
+  case QuirkChoice::COSMAC_VIP:
+    state->cpu.emplace<BasicChip8<CosmacVipQuirks>>();
+    break;
+  case QuirkChoice::CHIP48:
+    state->cpu.emplace<BasicChip8<Chip48Quirks>>();
+    break;
+  case QuirkChoice::SUPER_CHIP:
+    state->cpu.emplace<BasicChip8<SuperChipQuirks>>();
+    break;
+  case QuirkChoice::XO_CHIP:
+    state->cpu.emplace<BasicChip8<XoChipQuirks>>();
+    break;
+  default:
+    state->cpu.emplace<Chip8>();
+    break;
+  }
+  std::visit(
+      [state](auto &cpu) {
+        cpu.set_seed(state->seed);
+        if (state->stream != nullptr && !state->muted) {
+          cpu.set_tone_generator(&state->tone);
+        }
+      },
+      state->cpu);
+}
+
+/// @brief starts a rom from reset on a machine of its profile, dropping the
+/// rewind history of the last one and restarting the movie if one is being
+/// recorded
+/// @param state contains the current appstate
+/// @param bytes the rom
+static void start_rom(AppState *state, std::span<const uint8_t> bytes) {
+  set_profile(state, rom_quirks(state->quirks, bytes));
+  state->rom_hash = hash_rom(*Chip8::make_memory_image(bytes));
+  std::visit(
+      [&](auto &cpu) {
+        using Type = std::decay_t<decltype(cpu)>;
+        cpu.reset();
+        cpu.load_memory_image(Type::make_memory_image(bytes));
+        state->rewind.clear();
+        if (!state->movie_path.empty()) {
+          state->movie = start_movie(cpu, state->rom_hash);
+        }
+      },
+      state->cpu);
+}
+
+/// @brief loads the rom from the system into the appstate
+/// @param appstate contains the current appstate
+/// @param file_path the path of the rom to load
+SDL_AppResult load_rom(void *appstate, const std::string &file_path) {
+  AppState *state = static_cast<AppState *>(appstate);
+  RomFile file;
+  if (!file.open(file_path)) {
+    return SDL_APP_FAILURE;
+  }
+
+  start_rom(state, file.get_bytes());
+  return SDL_APP_CONTINUE;
+}
+
+// the bridge to js. pointers point into wasm memory, so js reads them through
+// typed array views made on the spot, a memory growth replaces the buffer.
+// with --threaded the machine belongs to the core thread, only the display
+// of the frame on screen is handed out
 extern "C" {
 EMSCRIPTEN_KEEPALIVE
 void set_draw_color(int r, int g, int b) {
@@ -47,25 +256,169 @@ void set_draw_color(int r, int g, int b) {
     global_state->b = static_cast<uint8_t>(b);
   }
 }
+
+/// @brief returns the packed rows of a display plane, get_display_rows
+/// @param plane the plane, 0 or 1
+/// @return the rows, valid until the next frame
+EMSCRIPTEN_KEEPALIVE
+const uint64_t *chip8_display_rows(int plane) {
+  if (global_state == nullptr || plane < 0 || plane >= Chip8::PLANE_COUNT) {
+    return nullptr;
+  }
+  if (global_state->threaded) {
+    return &global_state->frames.get_front().display[plane * PLANE_WORDS];
+  }
+  return std::visit(
+      [plane](const auto &cpu) { return cpu.get_display_rows(plane).data(); },
+      global_state->cpu);
 }
 
-/// @brief loads the rom from the system into the appstate
+/// @brief returns the width of the display rows
+/// @return 64 or 128
+EMSCRIPTEN_KEEPALIVE
+int chip8_display_width() {
+  if (global_state == nullptr) {
+    return 0;
+  }
+  if (global_state->threaded) {
+    return global_state->frames.get_front().width;
+  }
+  return std::visit([](const auto &cpu) { return cpu.get_display_width(); },
+                    global_state->cpu);
+}
+
+/// @brief returns the height of the display rows
+/// @return 32 or 64
+EMSCRIPTEN_KEEPALIVE
+int chip8_display_height() {
+  if (global_state == nullptr) {
+    return 0;
+  }
+  if (global_state->threaded) {
+    return global_state->frames.get_front().height;
+  }
+  return std::visit([](const auto &cpu) { return cpu.get_display_height(); },
+                    global_state->cpu);
+}
+
+/// @brief returns V0 - VF in place
+/// @return the registers, nullptr with --threaded
+EMSCRIPTEN_KEEPALIVE
+const uint8_t *chip8_registers() {
+  if (global_state == nullptr || global_state->threaded) {
+    return nullptr;
+  }
+  return std::visit(
+      [](const auto &cpu) { return cpu.get_registers().data(); },
+      global_state->cpu);
+}
+
+/// @brief takes a snapshot into a blob js can copy out as a save state, or
+/// overwrite with one before chip8_restore_snapshot
+/// @return the blob of chip8_snapshot_size bytes, nullptr with --threaded
+EMSCRIPTEN_KEEPALIVE
+const uint8_t *chip8_snapshot() {
+  if (global_state == nullptr || global_state->threaded) {
+    return nullptr;
+  }
+  std::visit(
+      [](const auto &cpu) {
+        auto snapshot = cpu.snapshot();
+        const auto *bytes = reinterpret_cast<const uint8_t *>(&snapshot);
+        global_state->exported.assign(bytes, bytes + sizeof(snapshot));
+      },
+      global_state->cpu);
+  return global_state->exported.data();
+}
+
+/// @brief returns the size of the snapshot blob, which depends on the
+/// profile of the running machine
+/// @return the size of its Snapshot
+EMSCRIPTEN_KEEPALIVE
+size_t chip8_snapshot_size() {
+  if (global_state == nullptr) {
+    return 0;
+  }
+  return std::visit(
+      [](const auto &cpu) {
+        return sizeof(typename std::decay_t<decltype(cpu)>::Snapshot);
+      },
+      global_state->cpu);
+}
+
+/// @brief restores the machine from the snapshot blob
+/// @return false with --threaded or if the blob is not of the running
+/// profile
+EMSCRIPTEN_KEEPALIVE
+bool chip8_restore_snapshot() {
+  if (global_state == nullptr || global_state->threaded) {
+    return false;
+  }
+  return std::visit(
+      [](auto &cpu) {
+        using Snapshot = typename std::decay_t<decltype(cpu)>::Snapshot;
+        if (global_state->exported.size() != sizeof(Snapshot)) {
+          return false;
+        }
+        Snapshot snapshot;
+        std::memcpy(&snapshot, global_state->exported.data(),
+                    sizeof(snapshot));
+        cpu.restore(snapshot);
+        return true;
+      },
+      global_state->cpu);
+}
+
+/// @brief makes room for js to copy a rom into
+/// @param size the size of the rom
+/// @return the buffer, nullptr if the rom is too large
+EMSCRIPTEN_KEEPALIVE
+uint8_t *chip8_rom_buffer(size_t size) {
+  if (global_state == nullptr || size == 0 || size > RomFile::MAX_SIZE) {
+    return nullptr;
+  }
+  global_state->rom_upload.resize(size);
+  return global_state->rom_upload.data();
+}
+
+/// @brief starts the rom copied into chip8_rom_buffer, without reloading the
+/// module
+/// @return false with --threaded or if no rom was copied in
+EMSCRIPTEN_KEEPALIVE
+bool chip8_load_rom() {
+  if (global_state == nullptr || global_state->threaded ||
+      global_state->rom_upload.empty()) {
+    return false;
+  }
+  start_rom(global_state, global_state->rom_upload);
+  global_state->rom_upload.clear();
+  return true;
+}
+}
+
+/// @brief generates the samples the device asks for, on the audio thread.
+/// only what is needed is queued, so the stream never grows
 /// @param appstate contains the current appstate
-/// @param file_path the path of the rom to load
-SDL_AppResult load_rom(void *appstate, const std::string &file_path) {
+/// @param stream the stream to fill
+/// @param additional the bytes needed now
+/// @param total the bytes needed including what is already queued
+static void SDLCALL fill_audio(void *appstate, SDL_AudioStream *stream,
+                               int additional, int total) {
   AppState *state = static_cast<AppState *>(appstate);
-  std::ifstream file(file_path, std::ios::binary);
-  if (!file) {
-    return SDL_APP_FAILURE;
+  float samples[AUDIO_CHUNK];
+  size_t needed = additional / sizeof(float);
+  (void)total;
+  while (needed > 0) {
+    size_t count = std::min(needed, AUDIO_CHUNK);
+    state->tone.render(samples, count);
+    SDL_PutAudioStreamData(stream, samples,
+                           static_cast<int>(count * sizeof(float)));
+    needed -= count;
   }
-
-  auto rom = std::make_unique<std::array<uint8_t, Chip8::MEMORY_SIZE>>();
-  file.read(reinterpret_cast<char *>(rom->data()), rom->size());
-  state->cpu->load_into_memory(*rom);
-  return SDL_APP_CONTINUE;
 }
 
-/// @brief initializes the audio for the appstate
+/// @brief initializes the audio for the appstate, the tone is generated on
+/// demand by fill_audio
 /// @param appstate contains the current appstate
 bool setup_audio(void *appstate) {
   AppState *state = static_cast<AppState *>(appstate);
@@ -74,21 +427,142 @@ bool setup_audio(void *appstate) {
   spec.channels = 1;
   spec.freq = SAMPLE_RATE;
   state->stream = SDL_OpenAudioDeviceStream(SDL_AUDIO_DEVICE_DEFAULT_PLAYBACK,
-                                            &spec, nullptr, nullptr);
+                                            &spec, fill_audio, state);
 
   if (state->stream == NULL) {
     return false;
   }
 
-  int phase = 0;
-  for (size_t i = 0; i < SAMPLES; i++) {
-    float t = (float)phase / SAMPLE_RATE;
-    state->audio_data[i] =
-        fmod(t * Chip8::FREQUENCY, 1.0f) < 0.5f ? 0.3f : -0.3f;
-    phase++;
+  std::visit([state](auto &cpu) { cpu.set_tone_generator(&state->tone); },
+             state->cpu);
+  return SDL_ResumeAudioStreamDevice(state->stream);
+}
+
+/// @brief silences the buzzer for turbo, or brings it back. a buzzer at
+/// hundreds of times its speed is only noise
+/// @param state contains the current appstate
+/// @param muted true to silence it
+static void set_muted(AppState *state, bool muted) {
+  std::visit(
+      [state, muted](auto &cpu) {
+        if (muted) {
+          state->tone.set_buzzer(cpu.get_emulated_time().count(), false);
+        }
+        cpu.set_tone_generator(muted ? nullptr : &state->tone);
+      },
+      state->cpu);
+  state->muted = muted;
+}
+
+/// @brief picks the emulated frames for the next turbo host frame from how
+/// long the last ones took, halfway to the number that fills the budget so
+/// one slow frame doesn't swing it
+/// @param frames the frames just run
+/// @param spent the host nanoseconds they took
+/// @return the frames to run next
+static uint32_t adapt_turbo_frames(uint32_t frames, uint64_t spent) {
+  uint64_t per_frame = std::max<uint64_t>(spent / frames, 1);
+  uint64_t target = std::min<uint64_t>(TURBO_BUDGET_NS / per_frame,
+                                       MAX_TURBO_FRAMES);
+  return static_cast<uint32_t>(std::max<uint64_t>((frames + target) / 2, 1));
+}
+
+/// @brief advances the machine by one host frame, applying the queued key
+/// edges at the instants they happened, or steps it back one recorded frame
+/// while rewinding, on the thread running it. in turbo whole emulated frames
+/// run instead, with every timer tick, and only the last is displayed
+/// @tparam Quirks the profile of the machine
+/// @param state contains the current appstate
+/// @param cpu the machine of the appstate
+/// @param start the host time of the last frame
+/// @param elapsed the host nanoseconds since the last frame
+template <Chip8Quirks Quirks>
+static void run_frame(AppState *state, BasicChip8<Quirks> &cpu,
+                      uint64_t start, uint64_t elapsed) {
+  InputMovie *movie = state->movie_path.empty() ? nullptr : &state->movie;
+  bool turbo = state->turbo.load(std::memory_order_relaxed);
+  if (turbo != state->muted) {
+    set_muted(state, turbo);
+  }
+
+  // rewinding steps back one recorded frame per displayed frame, the edges
+  // meanwhile land on the restored state
+  typename BasicChip8<Quirks>::Snapshot snapshot;
+  if (state->rewinding.load(std::memory_order_relaxed) &&
+      state->rewind.pop(snapshot)) {
+    cpu.restore(snapshot);
+    if (movie) {
+      truncate_movie(*movie, cpu.get_emulated_time());
+    }
+    state->inputs.run_for(cpu, start, 0, movie);
+  } else if (turbo) {
+    // the edges land before the frames, there is no host time to map into
+    state->inputs.run_for(cpu, start, 0, movie);
+    uint64_t begin = SDL_GetTicksNS();
+    cpu.run_frames(state->turbo_frames);
+    if (state->adaptive_turbo) {
+      state->turbo_frames =
+          adapt_turbo_frames(state->turbo_frames, SDL_GetTicksNS() - begin);
+    }
+    state->rewind.push(cpu.snapshot());
+  } else {
+    state->inputs.run_for(cpu, start, elapsed, movie);
+    state->rewind.push(cpu.snapshot());
   }
+  state->tone.set_machine_time(cpu.get_emulated_time().count());
+}
 
-  return true;
+/// @brief runs a host frame on the machine of the appstate, see the above
+/// @param state contains the current appstate
+/// @param start the host time of the last frame
+/// @param elapsed the host nanoseconds since the last frame
+static void run_frame(AppState *state, uint64_t start, uint64_t elapsed) {
+  std::visit([&](auto &cpu) { run_frame(state, cpu, start, elapsed); },
+             state->cpu);
+}
+
+/// @brief copies the display into the back frame and hands it to the
+/// renderer, if it changed since the last one
+/// @param state contains the current appstate
+static void publish_frame(AppState *state) {
+  std::visit(
+      [state](const auto &cpu) {
+        if (cpu.get_display_generation() == state->published_generation) {
+          return;
+        }
+
+        Frame &frame = state->frames.get_back();
+        for (uint8_t plane = 0; plane < Chip8::PLANE_COUNT; plane++) {
+          auto rows = cpu.get_display_rows(plane);
+          std::copy(rows.begin(), rows.end(),
+                    &frame.display[plane * PLANE_WORDS]);
+        }
+        frame.width = cpu.get_display_width();
+        frame.height = cpu.get_display_height();
+        frame.generation = cpu.get_display_generation();
+        state->frames.publish();
+        state->published_generation = frame.generation;
+      },
+      state->cpu);
+}
+
+/// @brief the loop of the core thread: runs a frame along with the queued key
+/// edges and publishes it, then sleeps out the rest of the frame. a slow
+/// present on the render thread never delays it
+/// @param state contains the current appstate
+static void core_loop(AppState *state) {
+  uint64_t last = SDL_GetTicksNS();
+  while (!state->stopping.load(std::memory_order_acquire)) {
+    uint64_t now = SDL_GetTicksNS();
+    run_frame(state, last, std::min(now - last, MAX_FRAME_TIME_NS));
+    last = now;
+    publish_frame(state);
+
+    uint64_t spent = SDL_GetTicksNS() - now;
+    if (spent < FRAME_NS) {
+      SDL_DelayNS(FRAME_NS - spent);
+    }
+  }
 }
 
 /// @brief initializes SDL, the window and the renderer
@@ -96,19 +570,60 @@ bool setup_audio(void *appstate) {
 /// @param argc the number of arguments
 /// @param argv the arguments
 SDL_AppResult SDL_AppInit(void **appstate, int argc, char *argv[]) {
-  constexpr int NUM_ARGS = 2;
+  std::string movie_path;
+  bool threaded = false;
+  uint32_t turbo_frames = 0; // adaptive
+  QuirkChoice quirks = QuirkChoice::DETECT;
+  size_t rewind_mb = REWIND_BUDGET_MB;
+  bool valid = argc >= 2;
+  for (int i = 2; i < argc && valid; i++) {
+    std::string arg = argv[i];
+    if (arg == "--record" && i + 1 < argc) {
+      movie_path = argv[++i];
+    } else if (arg == "--threaded") {
+      threaded = true;
+    } else if (arg == "--quirks" && i + 1 < argc) {
+      valid = parse_quirks(argv[++i], quirks);
+    } else if (arg == "--rewind-mb" && i + 1 < argc) {
+      rewind_mb = std::strtoul(argv[++i], nullptr, 10);
+      valid = rewind_mb >= 1 && rewind_mb <= MAX_REWIND_BUDGET_MB;
+    } else if (arg == "--turbo" && i + 1 < argc) {
+      arg = argv[++i];
+      if (arg != "auto") {
+        turbo_frames = std::strtoul(arg.c_str(), nullptr, 10);
+        valid = turbo_frames >= 1 && turbo_frames <= MAX_TURBO_FRAMES;
+      }
+    } else {
+      valid = false;
+    }
+  }
 
-  if (argc != NUM_ARGS) {
-    SDL_Log("Usage: %s <rom path>", argv[0]);
+  if (!valid) {
+    SDL_Log("Usage: %s <rom path> [--record <movie path>] [--threaded] "
+            "[--turbo <1 - %u frames | auto>] "
+            "[--quirks <default|vip|chip48|schip|xochip|detect>] "
+            "[--rewind-mb <1 - %zu>]",
+            argv[0], MAX_TURBO_FRAMES, MAX_REWIND_BUDGET_MB);
     return SDL_APP_FAILURE;
   }
 
+#if defined(__EMSCRIPTEN__) && !defined(__EMSCRIPTEN_PTHREADS__)
+  // the core thread is a web worker, which only a -pthread build can start
+  if (threaded) {
+    SDL_Log("--threaded needs a build with -pthread");
+    return SDL_APP_FAILURE;
+  }
+#endif
+
   if (!SDL_Init(SDL_INIT_VIDEO | SDL_INIT_AUDIO)) {
     return SDL_APP_FAILURE;
   }
 
   AppState *state = new AppState();
-  state->cpu = std::make_unique<Chip8>();
+  state->quirks = quirks;
+  state->rewind = RewindBuffer(rewind_mb << 20);
+  state->seed = std::random_device{}(); // a new game every launch
+  std::get<Chip8>(state->cpu).set_seed(state->seed);
   *appstate = state;
   global_state = state;
 
@@ -120,18 +635,87 @@ SDL_AppResult SDL_AppInit(void **appstate, int argc, char *argv[]) {
     return SDL_APP_FAILURE;
   }
 
+  state->texture = SDL_CreateTexture(state->renderer, SDL_PIXELFORMAT_RGBA8888,
+                                     SDL_TEXTUREACCESS_STREAMING,
+                                     Chip8::HIRES_WIDTH, Chip8::HIRES_HEIGHT);
+  if (state->texture == nullptr) {
+    return SDL_APP_FAILURE;
+  }
+  SDL_SetTextureScaleMode(state->texture, SDL_SCALEMODE_NEAREST);
+
   if (load_rom(*appstate, argv[1]) != SDL_APP_CONTINUE) {
     return SDL_APP_FAILURE;
   }
 
+  if (!movie_path.empty()) {
+    state->movie_path = movie_path;
+    std::visit(
+        [state](const auto &cpu) {
+          state->movie = start_movie(cpu, state->rom_hash);
+        },
+        state->cpu);
+  }
+
   if (!setup_audio(*appstate)) {
     return SDL_APP_FAILURE;
   }
 
+  if (turbo_frames != 0) {
+    state->adaptive_turbo = false;
+    state->turbo_frames = turbo_frames;
+  }
+
   SDL_SetRenderVSync(state->renderer, 1);
+  state->last_iterate_ns = SDL_GetTicksNS();
+  if (threaded) {
+    state->threaded = true;
+    state->core_thread = std::thread(core_loop, state);
+  }
   return SDL_APP_CONTINUE;
 }
 
+/// @brief maps a keyboard key to the chip8 keypad
+/// @param key the key that changed
+/// @return the keypad button, -1 if the key is not mapped
+static int keypad_index(SDL_Keycode key) {
+  switch (key) {
+  case SDLK_1:
+    return 1;
+  case SDLK_2:
+    return 2;
+  case SDLK_3:
+    return 3;
+  case SDLK_4:
+    return 0xC;
+  case SDLK_Q:
+    return 4;
+  case SDLK_W:
+    return 5;
+  case SDLK_E:
+    return 6;
+  case SDLK_R:
+    return 0xD;
+  case SDLK_A:
+    return 7;
+  case SDLK_S:
+    return 8;
+  case SDLK_D:
+    return 9;
+  case SDLK_F:
+    return 0xE;
+  case SDLK_Z:
+    return 0xA;
+  case SDLK_X:
+    return 0;
+  case SDLK_C:
+    return 0xB;
+  case SDLK_V:
+    return 0xF;
+  default:
+    return -1;
+  }
+}
+
 /// @brief handles the outcome of events, like exits, and keyboard inputs
 /// @param appstate contains the current appstate
 /// @param event the event that has occurred
@@ -145,86 +729,104 @@ SDL_AppResult SDL_AppEvent(void *appstate, SDL_Event *event) {
   }
 
   AppState *state = static_cast<AppState *>(appstate);
-  auto &cpu = state->cpu;
 
   if (event->type == SDL_EVENT_KEY_DOWN || event->type == SDL_EVENT_KEY_UP) {
-    bool is_pressed = event->type == SDL_EVENT_KEY_DOWN;
-    switch (event->key.key) {
-    case SDLK_1:
-      cpu->set_keypad(1, is_pressed);
-      break;
-    case SDLK_2:
-      cpu->set_keypad(2, is_pressed);
-      break;
-    case SDLK_3:
-      cpu->set_keypad(3, is_pressed);
-      break;
-    case SDLK_4:
-      cpu->set_keypad(0xC, is_pressed);
-      break;
-    case SDLK_Q:
-      cpu->set_keypad(4, is_pressed);
-      break;
-    case SDLK_W:
-      cpu->set_keypad(5, is_pressed);
-      break;
-    case SDLK_E:
-      cpu->set_keypad(6, is_pressed);
-      break;
-    case SDLK_R:
-      cpu->set_keypad(0xD, is_pressed);
-      break;
-    case SDLK_A:
-      cpu->set_keypad(7, is_pressed);
-      break;
-    case SDLK_S:
-      cpu->set_keypad(8, is_pressed);
-      break;
-    case SDLK_D:
-      cpu->set_keypad(9, is_pressed);
-      break;
-    case SDLK_F:
-      cpu->set_keypad(0xE, is_pressed);
-      break;
-    case SDLK_Z:
-      cpu->set_keypad(0xA, is_pressed);
-      break;
-    case SDLK_X:
-      cpu->set_keypad(0, is_pressed);
-      break;
-    case SDLK_C:
-      cpu->set_keypad(0xB, is_pressed);
-      break;
-    case SDLK_V:
-      cpu->set_keypad(0xF, is_pressed);
-      break;
+    bool pressed = event->type == SDL_EVENT_KEY_DOWN;
+    if (event->key.key == SDLK_BACKSPACE) {
+      state->rewinding.store(pressed, std::memory_order_relaxed);
+      return SDL_APP_CONTINUE;
+    }
+    if (event->key.key == SDLK_TAB) {
+      state->turbo.store(pressed, std::memory_order_relaxed);
+      return SDL_APP_CONTINUE;
+    }
+    int key = keypad_index(event->key.key);
+    if (key < 0 || event->key.repeat) {
+      return SDL_APP_CONTINUE;
+    }
+
+    // the timestamp is on the clock of SDL_GetTicksNS, which frames are
+    // measured with. a full queue means the machine has stalled
+    if (!state->inputs.push(event->key.timestamp, key, pressed)) {
+      SDL_Log("dropped a key change, the machine is behind");
     }
   }
   return SDL_APP_CONTINUE;
 }
 
-/// @brief draws the content of the display buffer to the SDL window
+/// @brief converts display rows to pixels and uploads them to the texture.
+/// the texture is always hi-res, a lo-res pixel covers 2 x 2 of it
+/// @param state contains the current appstate
+/// @param plane_0 the rows of the first plane
+/// @param plane_1 the rows of the second plane
+/// @param width the width of the display
+/// @param first the first row to upload
+/// @param end one past the last row to upload
+static void upload_rows(AppState *state, std::span<const uint64_t> plane_0,
+                        std::span<const uint64_t> plane_1, int width, int first,
+                        int end) {
+  // by the planes a pixel is set in, white is tinted by the color mod
+  constexpr uint32_t COLORS[] = {0x000000FF, 0xFFFFFFFF, 0xAAAAAAFF,
+                                 0x555555FF};
+  int scale = Chip8::HIRES_WIDTH / width;
+  int words = width / 64;
+
+  for (int i = first; i < end; i++) {
+    uint32_t *line = &state->pixels[i * scale * Chip8::HIRES_WIDTH];
+    for (int j = 0; j < width; j++) {
+      int word = i * words + j / 64;
+      int shift = 63 - j % 64;
+      uint32_t color = COLORS[(plane_0[word] >> shift & 1) |
+                              (plane_1[word] >> shift & 1) << 1];
+      std::fill_n(&line[j * scale], scale, color);
+    }
+    if (scale == 2) {
+      std::copy_n(line, Chip8::HIRES_WIDTH, line + Chip8::HIRES_WIDTH);
+    }
+  }
+
+  SDL_Rect rect = {0, first * scale, Chip8::HIRES_WIDTH, (end - first) * scale};
+  SDL_UpdateTexture(state->texture, &rect,
+                    &state->pixels[rect.y * Chip8::HIRES_WIDTH],
+                    Chip8::HIRES_WIDTH * sizeof(uint32_t));
+}
+
+/// @brief uploads the display rows changed since the last frame to the
+/// texture and draws it scaled to the SDL window. with --threaded the newest
+/// frame the core published is uploaded whole instead
 /// @param appstate contains the current appstate
 static void draw_to_screen(void *appstate) {
   AppState *state = static_cast<AppState *>(appstate);
-  const auto &display_buffer = state->cpu->get_display_buffer();
-  std::array<SDL_FRect, Chip8::WIDTH * Chip8::HEIGHT> pixels;
-  size_t pixel_count = 0;
-
-  for (size_t i = 0; i < Chip8::HEIGHT; i++) {
-    size_t offset = i * Chip8::WIDTH;
-    for (size_t j = 0; j < Chip8::WIDTH; j++) {
-      if (display_buffer[j + offset]) {
-        pixels[pixel_count++] = {(float)j * SCALING_FACTOR,
-                                 (float)i * SCALING_FACTOR,
-                                 (float)SCALING_FACTOR, (float)SCALING_FACTOR};
-      }
+
+  if (state->threaded) {
+    // the core only publishes changed displays
+    if (state->frames.update()) {
+      const Frame &frame = state->frames.get_front();
+      std::span<const uint64_t> display = frame.display;
+      upload_rows(state, display.first(PLANE_WORDS),
+                  display.subspan(PLANE_WORDS), frame.width, 0, frame.height);
+      state->presented_generation = frame.generation;
     }
+  } else {
+    std::visit(
+        [state](auto &cpu) {
+          if (cpu.get_display_generation() == state->presented_generation) {
+            return;
+          }
+          Chip8::DirtyRows dirty = cpu.get_dirty_rows();
+          if (dirty.first < dirty.end) {
+            upload_rows(state, cpu.get_display_rows(0),
+                        cpu.get_display_rows(1), cpu.get_display_width(),
+                        dirty.first, dirty.end);
+          }
+          cpu.clear_dirty_rows();
+          state->presented_generation = cpu.get_display_generation();
+        },
+        state->cpu);
   }
 
-  SDL_SetRenderDrawColor(state->renderer, state->r, state->g, state->b,
-                         SDL_ALPHA_OPAQUE);
-  SDL_RenderFillRects(state->renderer, pixels.data(), pixel_count);
+  SDL_SetTextureColorMod(state->texture, state->r, state->g, state->b);
+  SDL_RenderTexture(state->renderer, state->texture, nullptr, nullptr);
 }
 
 /// @brief performs one 'tick' of the application
@@ -233,22 +835,15 @@ SDL_AppResult SDL_AppIterate(void *appstate) {
   AppState *state = static_cast<AppState *>(appstate);
   SDL_SetRenderDrawColor(state->renderer, 0, 0, 0, SDL_ALPHA_OPAQUE);
   SDL_RenderClear(state->renderer);
-  uint8_t delay_register = state->cpu->get_DT();
-  uint8_t sound_register = state->cpu->get_ST();
-
-  if (delay_register > 0) {
-    state->cpu->set_DT(delay_register - 1);
-  }
 
-  if (sound_register != 0 && state->stream != nullptr) {
-    SDL_PutAudioStreamData(state->stream, state->audio_data,
-                           sizeof(state->audio_data));
-    state->cpu->set_ST(state->cpu->get_ST() - 1);
+  // emulated time follows host time, whatever the display refresh rate
+  if (!state->threaded) {
+    uint64_t now = SDL_GetTicksNS();
+    run_frame(state, state->last_iterate_ns,
+              std::min(now - state->last_iterate_ns, MAX_FRAME_TIME_NS));
+    state->last_iterate_ns = now;
   }
 
-  for (size_t i = 0; i < CYCLES_PER_FRAME; i++) {
-    state->cpu->cycle();
-  }
   draw_to_screen(appstate);
   SDL_RenderPresent(state->renderer);
   return SDL_APP_CONTINUE;
@@ -264,6 +859,22 @@ void SDL_AppQuit(void *appstate, SDL_AppResult result) {
   }
 
   AppState *state = static_cast<AppState *>(appstate);
+  if (state->threaded) {
+    state->stopping.store(true, std::memory_order_release);
+    state->core_thread.join();
+  }
+  if (!state->movie_path.empty()) {
+    truncate_movie(state->movie,
+                   std::visit([](const auto &cpu) {
+                     return cpu.get_emulated_time();
+                   }, state->cpu));
+    std::ofstream file(state->movie_path, std::ios::binary);
+    if (!file || !write_movie(file, state->movie)) {
+      SDL_Log("could not write movie %s", state->movie_path.c_str());
+    }
+  }
+
+  SDL_DestroyTexture(state->texture);
   SDL_DestroyRenderer(state->renderer);
   SDL_DestroyWindow(state->window);
   SDL_DestroyAudioStream(state->stream);
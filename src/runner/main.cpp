@@ -0,0 +1,551 @@
+/// @file main.cpp
+/// @brief headless batch runner, executes many Chip8 instances in parallel
+/// @author Abhay Manoj
+/// @date Oct 14 2026
+
+#include "core/chip8.hpp"
+#include "core/hash.hpp"
+#include "core/input_movie.hpp"
+#include "core/rom_analysis.hpp"
+#include "core/rom_file.hpp"
+#include "core/rom_library.hpp"
+#include "core/thread_pool.hpp"
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <memory>
+#include <span>
+#include <string>
+#include <vector>
+
+/// @brief the quirk profiles the runner can build machines with
+enum class QuirkChoice {
+  DEFAULT, // DefaultQuirks
+  COSMAC_VIP,
+  CHIP48,
+  SUPER_CHIP,
+  XO_CHIP,
+  DETECT, // from the profile detect_profile finds in each rom
+};
+
+/// @brief the budgets and inputs of a batch
+struct Options {
+  std::vector<std::string> rom_paths;
+  size_t instances = 1;
+  size_t frames = 600;
+  size_t cycles_per_frame = 10;
+  size_t threads = 0;
+  uint64_t seed = Chip8::DEFAULT_SEED;
+  Chip8::Engine engine = Chip8::Engine::INTERPRETER;
+  QuirkChoice quirks = QuirkChoice::DEFAULT;
+  bool idle_skipping = true; // fast forward idle loops and key waits
+  std::string movie_path; // replaces the frame budget and seed if set
+  InputMovie movie;
+  std::string library_path; // every rom in it is run as well
+  std::string index_path;   // caches the library between runs
+  std::string profile_path; // directory for the profiles of instance 0
+  bool disassemble = false;  // list the roms instead of running them
+};
+
+/// @brief a rom loaded once and shared between all of its instances
+struct Rom {
+  std::string path;
+  std::shared_ptr<const Chip8::MemoryImage> memory; // read in place by all
+  // the 64 KB image XO-CHIP machines read, nullptr if none runs the rom
+  std::shared_ptr<const BasicChip8<XoChipQuirks>::MemoryImage> xo_memory;
+  uint64_t hash = 0;                      // see hash_rom
+  RomProfile profile = RomProfile::CHIP8; // see detect_profile
+  size_t size = 0;                        // bytes of the rom file
+};
+
+/// @brief the outcome of one instance
+struct RunResult {
+  uint64_t cycles = 0;
+  uint64_t idle_cycles = 0; // of cycles, fast forwarded instead of executed
+  double seconds = 0;
+  uint64_t hash = 0;
+  Chip8Fault fault = Chip8Fault::NONE; // what stopped the program, if anything
+};
+
+/// @brief prints the usage of the runner
+/// @param program the name of the executable
+static void print_usage(const char *program) {
+  std::fprintf(stderr,
+               "Usage: %s [options] <rom path>...\n"
+               "  --instances N         instances per rom (default 1)\n"
+               "  --frames N            frames to run per instance "
+               "(default 600)\n"
+               "  --cycles-per-frame N  cycles between timer ticks "
+               "(default 10)\n"
+               "  --threads N           worker threads (default: all cores)\n"
+               "  --seed N              seed of every instance (default 0)\n"
+               "  --engine NAME         interpreter, cache or recompiler "
+               "(default interpreter)\n"
+               "  --quirks NAME         default, vip, chip48, schip, xochip or "
+               "detect (default default)\n"
+               "  --no-idle-skip        execute idle loops and key waits "
+               "instruction by instruction\n"
+               "  --movie PATH          replay an input movie instead of "
+               "running frames\n"
+               "  --library DIR         also run every rom under a directory\n"
+               "  --index PATH          cache of the library, read and "
+               "updated\n"
+               "  --disassemble         list the code and data of each rom "
+               "instead of running it\n"
+#ifdef CHIP8_PROFILING
+               "  --profile DIR         write the profile of the first "
+               "instance of each rom\n"
+#endif
+               ,
+               program);
+}
+
+/// @brief parses the name of an execution engine
+/// @param name the name given on the command line
+/// @param engine filled with the matching engine
+/// @return true if the name is a known engine
+static bool parse_engine(const char *name, Chip8::Engine &engine) {
+  if (std::strcmp(name, "interpreter") == 0) {
+    engine = Chip8::Engine::INTERPRETER;
+  } else if (std::strcmp(name, "cache") == 0) {
+    engine = Chip8::Engine::DECODE_CACHE;
+  } else if (std::strcmp(name, "recompiler") == 0) {
+    engine = Chip8::Engine::RECOMPILER;
+  } else {
+    return false;
+  }
+  return true;
+}
+
+/// @brief parses the name of a quirk profile
+/// @param name the name given on the command line
+/// @param quirks filled with the matching profile
+/// @return true if the name is a known profile
+static bool parse_quirks(const char *name, QuirkChoice &quirks) {
+  if (std::strcmp(name, "default") == 0) {
+    quirks = QuirkChoice::DEFAULT;
+  } else if (std::strcmp(name, "vip") == 0) {
+    quirks = QuirkChoice::COSMAC_VIP;
+  } else if (std::strcmp(name, "chip48") == 0) {
+    quirks = QuirkChoice::CHIP48;
+  } else if (std::strcmp(name, "schip") == 0) {
+    quirks = QuirkChoice::SUPER_CHIP;
+  } else if (std::strcmp(name, "xochip") == 0) {
+    quirks = QuirkChoice::XO_CHIP;
+  } else if (std::strcmp(name, "detect") == 0) {
+    quirks = QuirkChoice::DETECT;
+  } else {
+    return false;
+  }
+  return true;
+}
+
+/// @brief parses the command line into options
+/// @param argc the number of arguments
+/// @param argv the arguments
+/// @param options filled with the parsed options
+/// @return true if the arguments were valid
+static bool parse_options(int argc, char *argv[], Options &options) {
+  for (int i = 1; i < argc; i++) {
+    const char *arg = argv[i];
+    size_t *target = nullptr;
+
+    if (std::strcmp(arg, "--instances") == 0) {
+      target = &options.instances;
+    } else if (std::strcmp(arg, "--frames") == 0) {
+      target = &options.frames;
+    } else if (std::strcmp(arg, "--cycles-per-frame") == 0) {
+      target = &options.cycles_per_frame;
+    } else if (std::strcmp(arg, "--threads") == 0) {
+      target = &options.threads;
+    } else if (std::strcmp(arg, "--seed") == 0) {
+      if (++i >= argc) {
+        return false;
+      }
+      // 64 bits wherever size_t is narrower
+      options.seed = std::strtoull(argv[i], nullptr, 10);
+      continue;
+    } else if (std::strcmp(arg, "--engine") == 0) {
+      if (++i >= argc || !parse_engine(argv[i], options.engine)) {
+        return false;
+      }
+      continue;
+    } else if (std::strcmp(arg, "--quirks") == 0) {
+      if (++i >= argc || !parse_quirks(argv[i], options.quirks)) {
+        return false;
+      }
+      continue;
+    } else if (std::strcmp(arg, "--no-idle-skip") == 0) {
+      options.idle_skipping = false;
+      continue;
+    } else if (std::strcmp(arg, "--disassemble") == 0) {
+      options.disassemble = true;
+      continue;
+    } else if (std::strcmp(arg, "--movie") == 0) {
+      if (++i >= argc) {
+        return false;
+      }
+      options.movie_path = argv[i];
+      continue;
+    } else if (std::strcmp(arg, "--library") == 0) {
+      if (++i >= argc) {
+        return false;
+      }
+      options.library_path = argv[i];
+      continue;
+    } else if (std::strcmp(arg, "--index") == 0) {
+      if (++i >= argc) {
+        return false;
+      }
+      options.index_path = argv[i];
+      continue;
+#ifdef CHIP8_PROFILING
+    } else if (std::strcmp(arg, "--profile") == 0) {
+      if (++i >= argc) {
+        return false;
+      }
+      options.profile_path = argv[i];
+      continue;
+#endif
+    } else if (std::strncmp(arg, "--", 2) == 0) {
+      return false;
+    } else {
+      options.rom_paths.emplace_back(arg);
+      continue;
+    }
+
+    if (++i >= argc) {
+      return false;
+    }
+    *target = std::strtoull(argv[i], nullptr, 10);
+  }
+
+  return !options.rom_paths.empty() || !options.library_path.empty();
+}
+
+/// @brief maps a rom and copies it into the memory images its machines use
+/// @param path the path of the rom to load
+/// @param quirks the quirks the rom will run with
+/// @param rom filled with the loaded rom
+/// @return true if the rom could be read and fits in memory
+static bool load_rom(const std::string &path, QuirkChoice quirks, Rom &rom) {
+  RomFile file;
+  if (!file.open(path)) {
+    return false;
+  }
+
+  rom.path = path;
+  rom.size = file.get_bytes().size();
+  rom.memory = Chip8::make_memory_image(file.get_bytes());
+  rom.hash = hash_rom(*rom.memory);
+  rom.profile = detect_profile(file.get_bytes());
+  if (quirks == QuirkChoice::XO_CHIP ||
+      (quirks == QuirkChoice::DETECT && rom.profile == RomProfile::XO_CHIP)) {
+    rom.xo_memory =
+        BasicChip8<XoChipQuirks>::make_memory_image(file.get_bytes());
+  }
+  return true;
+}
+
+/// @brief scans the library directory and adds its roms to the rom paths,
+/// reusing and then updating the index file if one is given
+/// @param options the options to add the roms to
+/// @return true if the directory could be read
+static bool add_library(Options &options) {
+  RomLibrary library;
+  if (!options.index_path.empty()) {
+    std::ifstream in(options.index_path, std::ios::binary);
+    if (in && !library.read_index(in)) {
+      std::fprintf(stderr, "warning: ignoring invalid index %s\n",
+                   options.index_path.c_str());
+    }
+  }
+
+  if (!library.scan(options.library_path)) {
+    return false;
+  }
+  std::fprintf(stderr, "library: %zu roms, %zu read\n",
+               library.get_entries().size(), library.get_files_read());
+
+  if (!options.index_path.empty()) {
+    std::ofstream out(options.index_path, std::ios::binary);
+    if (!out || !library.write_index(out)) {
+      std::fprintf(stderr, "warning: could not write index %s\n",
+                   options.index_path.c_str());
+    }
+  }
+
+  for (const RomEntry &entry : library.get_entries()) {
+    options.rom_paths.push_back(entry.path);
+  }
+  return true;
+}
+
+/// @brief hashes the observable state of the machine
+/// @param cpu the machine to hash
+/// @return the hash of the display, registers, stack and timers
+template <Chip8Quirks Quirks>
+static uint64_t state_hash(const BasicChip8<Quirks> &cpu) {
+  std::span<const uint64_t> display_rows = cpu.get_display_rows();
+  const auto &registers = cpu.get_registers();
+  const auto &stack = cpu.get_stack();
+  const uint16_t words[] = {cpu.get_I(), cpu.get_PC(), cpu.get_SP(),
+                            cpu.get_DT(), cpu.get_ST()};
+
+  uint64_t hash = fnv1a(display_rows.data(), display_rows.size_bytes());
+  if constexpr (Quirks::INSTRUCTIONS == InstructionSet::XO_CHIP) {
+    std::span<const uint64_t> plane = cpu.get_display_rows(1);
+    hash = fnv1a(plane.data(), plane.size_bytes(), hash);
+  }
+  hash = fnv1a(registers.data(), registers.size(), hash);
+  hash = fnv1a(stack.data(), sizeof(stack), hash);
+  return fnv1a(words, sizeof(words), hash);
+}
+
+#ifdef CHIP8_PROFILING
+/// @brief writes the profile of a machine as <rom name>.json and
+/// <rom name>.folded into the profile directory
+/// @param rom the rom the machine ran
+/// @param cpu the machine
+/// @param options holds the profile directory
+template <Chip8Quirks Quirks>
+static void write_profile(const Rom &rom, const BasicChip8<Quirks> &cpu,
+                          const Options &options) {
+  std::filesystem::path base = std::filesystem::path(options.profile_path) /
+                               std::filesystem::path(rom.path).stem();
+  std::ofstream json(base.string() + ".json");
+  std::ofstream folded(base.string() + ".folded");
+  if (!json || !cpu.get_profiler().write_json(json) || !folded ||
+      !cpu.get_profiler().write_folded(folded)) {
+    std::fprintf(stderr, "warning: could not write the profile %s\n",
+                 base.string().c_str());
+  }
+}
+#endif
+
+/// @brief returns the image of a rom that fits the memory of a machine
+/// @tparam Quirks the quirks of the machine
+/// @param rom the rom
+/// @return the 64 KB image for XO-CHIP, the 4 KB one otherwise
+template <Chip8Quirks Quirks> static auto rom_image(const Rom &rom) {
+  if constexpr (BasicChip8<Quirks>::MEMORY_SIZE == Chip8::MEMORY_SIZE) {
+    return rom.memory;
+  } else {
+    return rom.xo_memory;
+  }
+}
+
+/// @brief runs one instance of a rom for the frame budget
+/// @tparam Quirks the quirks of the machine to run it on
+/// @param rom the rom to run
+/// @param instance the index of the instance
+/// @param options the budgets to run with
+/// @return the outcome of the run
+template <Chip8Quirks Quirks>
+static RunResult run_machine(const Rom &rom, size_t instance,
+                             const Options &options) {
+  BasicChip8<Quirks> cpu(rom_image<Quirks>(rom));
+  cpu.set_engine(options.engine);
+  cpu.set_seed(options.seed);
+  cpu.set_idle_skipping(options.idle_skipping);
+  RunResult result;
+
+  cpu.set_instruction_rate(options.cycles_per_frame * Chip8::TIMER_RATE);
+
+  auto start = std::chrono::steady_clock::now();
+  if (options.movie_path.empty()) {
+    cpu.run_frames(options.frames);
+  } else {
+    play_movie(cpu, options.movie);
+  }
+  auto end = std::chrono::steady_clock::now();
+
+  result.cycles = cpu.get_cycle_count();
+  result.idle_cycles = cpu.get_idle_cycles();
+  result.seconds = std::chrono::duration<double>(end - start).count();
+  result.hash = state_hash(cpu);
+  result.fault = cpu.get_fault();
+#ifdef CHIP8_PROFILING
+  if (instance == 0 && !options.profile_path.empty()) {
+    write_profile(rom, cpu, options);
+  }
+#else
+  (void)instance;
+#endif
+  return result;
+}
+
+/// @brief picks the quirks a rom runs with
+/// @param rom the rom
+/// @param quirks the choice on the command line
+/// @return the choice, with DETECT replaced by the profile of the rom
+static QuirkChoice rom_quirks(const Rom &rom, QuirkChoice quirks) {
+  if (quirks != QuirkChoice::DETECT) {
+    return quirks;
+  }
+  switch (rom.profile) {
+  case RomProfile::SUPER_CHIP:
+    return QuirkChoice::SUPER_CHIP;
+  case RomProfile::XO_CHIP:
+    return QuirkChoice::XO_CHIP;
+  default:
+    return QuirkChoice::DEFAULT;
+  }
+}
+
+/// @brief runs one instance of a rom on a machine with the chosen quirks
+/// @param rom the rom to run
+/// @param instance the index of the instance
+/// @param options the budgets and quirks to run with
+/// @return the outcome of the run
+static RunResult run_instance(const Rom &rom, size_t instance,
+                              const Options &options) {
+  switch (rom_quirks(rom, options.quirks)) {
+  case QuirkChoice::COSMAC_VIP:
+    return run_machine<CosmacVipQuirks>(rom, instance, options);
+  case QuirkChoice::CHIP48:
+    return run_machine<Chip48Quirks>(rom, instance, options);
+  case QuirkChoice::SUPER_CHIP:
+    return run_machine<SuperChipQuirks>(rom, instance, options);
+  case QuirkChoice::XO_CHIP:
+    return run_machine<XoChipQuirks>(rom, instance, options);
+  default:
+    return run_machine<DefaultQuirks>(rom, instance, options);
+  }
+}
+
+/// @brief analyzes a rom and prints its listing, headed by a summary
+/// @tparam Quirks the quirks of the machine the rom runs on
+/// @param rom the rom
+/// @return true if the listing was written
+template <Chip8Quirks Quirks> static bool write_analysis(const Rom &rom) {
+  auto image = rom_image<Quirks>(rom);
+  RomAnalysis analysis = analyze_rom(*image, AnalysisQuirks::of<Quirks>());
+  const char *verdict = "never writes its own code";
+  if (!analysis.complete) {
+    verdict = "jumps through BNNN where the analysis can't follow";
+  } else if (analysis.modifies_itself()) {
+    verdict = "may write its own code";
+  }
+  std::printf("; %s: %zu blocks, %s\n", rom.path.c_str(),
+              analysis.blocks.size(), verdict);
+  return write_listing(std::cout, *image, analysis, Quirks::INSTRUCTIONS,
+                       Chip8::START, Chip8::START + rom.size);
+}
+
+/// @brief prints the listing of a rom for the chosen quirks
+/// @param rom the rom
+/// @param options the quirks to analyze with
+/// @return true if the listing was written
+static bool disassemble_rom(const Rom &rom, const Options &options) {
+  switch (rom_quirks(rom, options.quirks)) {
+  case QuirkChoice::COSMAC_VIP:
+    return write_analysis<CosmacVipQuirks>(rom);
+  case QuirkChoice::CHIP48:
+    return write_analysis<Chip48Quirks>(rom);
+  case QuirkChoice::SUPER_CHIP:
+    return write_analysis<SuperChipQuirks>(rom);
+  case QuirkChoice::XO_CHIP:
+    return write_analysis<XoChipQuirks>(rom);
+  default:
+    return write_analysis<DefaultQuirks>(rom);
+  }
+}
+
+int main(int argc, char *argv[]) {
+  Options options;
+  if (!parse_options(argc, argv, options)) {
+    print_usage(argv[0]);
+    return 1;
+  }
+
+  if (!options.library_path.empty() && !add_library(options)) {
+    std::fprintf(stderr, "could not read library %s\n",
+                 options.library_path.c_str());
+    return 1;
+  }
+
+  if (!options.movie_path.empty()) {
+    std::ifstream file(options.movie_path, std::ios::binary);
+    if (!file || !read_movie(file, options.movie)) {
+      std::fprintf(stderr, "could not read movie %s\n",
+                   options.movie_path.c_str());
+      return 1;
+    }
+  }
+
+  std::vector<Rom> roms(options.rom_paths.size());
+  for (size_t i = 0; i < roms.size(); i++) {
+    if (!load_rom(options.rom_paths[i], options.quirks, roms[i])) {
+      std::fprintf(stderr, "could not open %s\n", options.rom_paths[i].c_str());
+      return 1;
+    }
+    if (!options.movie_path.empty() && roms[i].hash != options.movie.rom_hash) {
+      std::fprintf(stderr, "warning: the movie was not recorded on %s\n",
+                   options.rom_paths[i].c_str());
+    }
+  }
+
+  if (options.disassemble) {
+    for (const Rom &rom : roms) {
+      if (!disassemble_rom(rom, options)) {
+        return 1;
+      }
+      std::cout << '\n';
+    }
+    return 0;
+  }
+
+  std::vector<RunResult> results(roms.size() * options.instances);
+  auto start = std::chrono::steady_clock::now();
+  {
+    ThreadPool pool(options.threads);
+    for (size_t r = 0; r < roms.size(); r++) {
+      for (size_t i = 0; i < options.instances; i++) {
+        RunResult *result = &results[r * options.instances + i];
+        const Rom *rom = &roms[r];
+        pool.submit([result, rom, i, &options] {
+          *result = run_instance(*rom, i, options);
+        });
+      }
+    }
+    pool.wait();
+  }
+  auto end = std::chrono::steady_clock::now();
+
+  // the rate counts executed instructions only, idle skipping would
+  // otherwise inflate it with the cycles it fast forwards
+  uint64_t total_cycles = 0;
+  uint64_t total_executed = 0;
+  std::printf("rom,instance,cycles,idle_cycles,seconds,"
+              "instructions_per_second,hash,fault\n");
+  for (size_t r = 0; r < roms.size(); r++) {
+    for (size_t i = 0; i < options.instances; i++) {
+      const RunResult &result = results[r * options.instances + i];
+      uint64_t executed = result.cycles - result.idle_cycles;
+      double ips = result.seconds > 0 ? executed / result.seconds : 0;
+      total_cycles += result.cycles;
+      total_executed += executed;
+      std::printf("%s,%zu,%llu,%llu,%.6f,%.0f,%016llx,%s\n",
+                  roms[r].path.c_str(), i,
+                  static_cast<unsigned long long>(result.cycles),
+                  static_cast<unsigned long long>(result.idle_cycles),
+                  result.seconds, ips,
+                  static_cast<unsigned long long>(result.hash),
+                  fault_name(result.fault));
+    }
+  }
+
+  double seconds = std::chrono::duration<double>(end - start).count();
+  std::fprintf(stderr,
+               "%zu runs, %llu cycles, %llu instructions executed in %.3fs, "
+               "%.0f/s\n",
+               results.size(), static_cast<unsigned long long>(total_cycles),
+               static_cast<unsigned long long>(total_executed), seconds,
+               seconds > 0 ? total_executed / seconds : 0);
+  return 0;
+}
@@ -0,0 +1,164 @@
+/// @file c_api_test.cpp
+/// @brief Tests for the C interface of the shared library
+/// @author Abhay Manoj
+/// @date Oct 14 2026
+
+#include "chip8_c.h"
+#include "core/chip8.hpp"
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <gtest/gtest.h>
+#include <iterator>
+#include <string>
+#include <vector>
+
+class CApiTest : public ::testing::Test {
+protected:
+  std::vector<uint8_t> rom;
+
+  /// @brief reads a bundled rom
+  void SetUp() override {
+    std::ifstream file(std::string(CHIP8_ROM_DIR) + "/pong.ch8",
+                       std::ios::binary);
+    rom.assign(std::istreambuf_iterator<char>(file), {});
+    ASSERT_FALSE(rom.empty());
+  }
+
+  /// @brief creates a machine running the rom
+  /// @param seed the seed of the machine
+  /// @return the machine
+  chip8_machine *create(uint64_t seed) {
+    chip8_machine *machine = chip8_create(CHIP8_QUIRKS_DEFAULT);
+    chip8_set_seed(machine, seed);
+    chip8_load(machine, rom.data(), rom.size());
+    return machine;
+  }
+
+  /// @brief returns the display of a machine as one byte a pixel
+  /// @param machine the machine
+  /// @return the pixels
+  static std::vector<uint8_t> pixels(chip8_machine *machine) {
+    int width = 0;
+    int height = 0;
+    const uint8_t *framebuffer = chip8_framebuffer(machine, &width, &height);
+    return std::vector<uint8_t>(framebuffer, framebuffer + width * height);
+  }
+};
+
+// unknown profiles and engines are refused, a program too large for memory
+// is not loaded
+TEST_F(CApiTest, RejectsBadArguments) {
+  EXPECT_EQ(chip8_api_version(), CHIP8_C_API_VERSION);
+  EXPECT_EQ(chip8_create(5), nullptr);
+
+  chip8_machine *machine = chip8_create(CHIP8_QUIRKS_SCHIP);
+  ASSERT_NE(machine, nullptr);
+  EXPECT_FALSE(chip8_set_engine(machine, 3));
+  std::vector<uint8_t> large(Chip8::MEMORY_SIZE - Chip8::START + 1);
+  EXPECT_FALSE(chip8_load(machine, large.data(), large.size()));
+  EXPECT_TRUE(chip8_load(machine, large.data(), large.size() - 1));
+  EXPECT_EQ(chip8_display_rows(machine, 2), nullptr);
+  chip8_destroy(machine);
+  chip8_destroy(nullptr);
+}
+
+// a machine behind the interface runs exactly like a Chip8
+TEST_F(CApiTest, RunsLikeChip8) {
+  chip8_machine *machine = create(7);
+  ASSERT_TRUE(chip8_set_engine(machine, CHIP8_ENGINE_RECOMPILER));
+  Chip8 cpu(Chip8::make_memory_image(rom));
+  cpu.set_seed(7);
+
+  for (int frame = 0; frame < 300; frame++) {
+    bool pressed = frame % 40 < 15;
+    chip8_set_key(machine, 1, pressed);
+    cpu.set_keypad(1, pressed);
+    chip8_step_frames(machine, 1);
+    cpu.run_frames(1);
+  }
+  chip8_step_cycles(machine, 1000);
+  cpu.run(1000);
+
+  EXPECT_EQ(pixels(machine), cpu.get_display_buffer());
+  EXPECT_EQ(std::memcmp(chip8_display_rows(machine, 0),
+                        cpu.get_display_rows(0).data(),
+                        cpu.get_display_rows(0).size_bytes()),
+            0);
+  EXPECT_EQ(std::memcmp(chip8_registers(machine), cpu.get_registers().data(),
+                        Chip8::REGISTER_COUNT),
+            0);
+  EXPECT_EQ(chip8_cycle_count(machine), cpu.get_cycle_count());
+  EXPECT_EQ(chip8_fault(machine), CHIP8_FAULT_NONE);
+  chip8_destroy(machine);
+}
+
+// a snapshot restores the state it was taken in, and a damaged or foreign
+// one is refused without touching the machine
+TEST_F(CApiTest, SnapshotsRoundTrip) {
+  chip8_machine *machine = create(1);
+  chip8_step_frames(machine, 60);
+  std::vector<uint8_t> saved(chip8_snapshot_size(machine));
+  EXPECT_FALSE(chip8_snapshot(machine, saved.data(), saved.size() - 1));
+  ASSERT_TRUE(chip8_snapshot(machine, saved.data(), saved.size()));
+  std::vector<uint8_t> expected = pixels(machine);
+  uint64_t cycles = chip8_cycle_count(machine);
+
+  chip8_step_frames(machine, 60);
+  ASSERT_TRUE(chip8_restore(machine, saved.data(), saved.size()));
+  EXPECT_EQ(pixels(machine), expected);
+  EXPECT_EQ(chip8_cycle_count(machine), cycles);
+  uint64_t generation = chip8_display_generation(machine);
+  chip8_step_frames(machine, 60);
+  EXPECT_GT(chip8_display_generation(machine), generation);
+
+  chip8_step_frames(machine, 10);
+  uint64_t before = chip8_cycle_count(machine);
+  Chip8::Snapshot damaged;
+  std::memcpy(&damaged, saved.data(), sizeof(damaged));
+  damaged.SP = Chip8::STACK_SIZE + 1;
+  EXPECT_FALSE(chip8_restore(machine, &damaged, sizeof(damaged)));
+  EXPECT_FALSE(chip8_restore(machine, saved.data(), saved.size() - 1));
+  EXPECT_EQ(chip8_cycle_count(machine), before);
+
+  chip8_machine *xo = chip8_create(CHIP8_QUIRKS_XOCHIP);
+  EXPECT_FALSE(chip8_restore(xo, saved.data(), saved.size()));
+  chip8_destroy(xo);
+  chip8_destroy(machine);
+}
+
+// stepping many machines in one call, with or without a pool, ends where
+// stepping each one does
+TEST_F(CApiTest, StepManyMatchesStepFrames) {
+  constexpr size_t COUNT = 37;
+  std::vector<chip8_machine *> batched;
+  std::vector<chip8_machine *> pooled;
+  std::vector<chip8_machine *> single;
+  for (size_t i = 0; i < COUNT; i++) {
+    batched.push_back(create(i));
+    pooled.push_back(create(i));
+    single.push_back(create(i));
+    chip8_set_key(batched[i], i % 16, true);
+    chip8_set_key(pooled[i], i % 16, true);
+    chip8_set_key(single[i], i % 16, true);
+  }
+
+  chip8_pool *pool = chip8_pool_create(4);
+  for (int round = 0; round < 5; round++) {
+    chip8_step_many(nullptr, batched.data(), COUNT, 20);
+    chip8_step_many(pool, pooled.data(), COUNT, 20);
+    for (chip8_machine *machine : single) {
+      chip8_step_frames(machine, 20);
+    }
+  }
+  chip8_pool_destroy(pool);
+
+  for (size_t i = 0; i < COUNT; i++) {
+    EXPECT_EQ(pixels(batched[i]), pixels(single[i])) << i;
+    EXPECT_EQ(pixels(pooled[i]), pixels(single[i])) << i;
+    EXPECT_EQ(chip8_cycle_count(pooled[i]), chip8_cycle_count(single[i]));
+    chip8_destroy(batched[i]);
+    chip8_destroy(pooled[i]);
+    chip8_destroy(single[i]);
+  }
+}
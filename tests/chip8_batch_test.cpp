@@ -0,0 +1,79 @@
+/// @file chip8_batch_test.cpp
+/// @brief Tests for the Chip8Batch class against separate Chip8 instances
+/// @author Abhay Manoj
+/// @date Oct 14 2026
+
+#include "core/chip8.hpp"
+#include "core/chip8_batch.hpp"
+#include <array>
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <gtest/gtest.h>
+#include <memory>
+#include <string>
+#include <vector>
+
+using Memory = std::array<uint8_t, Chip8::MEMORY_SIZE>;
+
+static constexpr size_t LANES = 24;
+
+/// @brief reads a bundled rom into a memory image
+/// @param name the file name of the rom in the roms directory
+/// @return the memory image, nullptr if the rom could not be read
+static std::unique_ptr<Memory> load_rom(const std::string &name) {
+  std::ifstream file(std::string(CHIP8_ROM_DIR) + "/" + name,
+                     std::ios::binary);
+  if (!file) {
+    return nullptr;
+  }
+  auto memory = std::make_unique<Memory>();
+  file.read(reinterpret_cast<char *>(memory->data() + Chip8::START),
+            memory->size() - Chip8::START);
+  return memory;
+}
+
+/// @brief compares two snapshots byte for byte
+static bool same(const Chip8::Snapshot &a, const Chip8::Snapshot &b) {
+  return std::memcmp(&a, &b, sizeof(a)) == 0;
+}
+
+class Chip8BatchTest : public ::testing::TestWithParam<const char *> {};
+
+// every lane ends in the same state as a Chip8 given the same seed and keys
+TEST_P(Chip8BatchTest, LanesMatchSeparateMachines) {
+  auto memory = load_rom(GetParam());
+  ASSERT_NE(memory, nullptr);
+
+  Chip8Batch batch(LANES, *memory);
+  std::vector<Chip8> machines(LANES, Chip8(*memory));
+  for (size_t lane = 0; lane < LANES; lane++) {
+    batch.set_seed(lane, lane);
+    machines[lane].set_seed(lane);
+  }
+
+  // each lane holds a different key at different times so the lanes split
+  for (int frame = 0; frame < 600; frame++) {
+    for (size_t lane = 0; lane < LANES; lane++) {
+      uint8_t key = (frame / 20 + lane) % 16;
+      uint8_t status = (frame + lane * 7) % 30 < 12;
+      batch.set_keypad(lane, key, status);
+      machines[lane].set_keypad(key, status);
+    }
+    batch.run_frames(1);
+    for (Chip8 &cpu : machines) {
+      cpu.run_frames(1);
+    }
+  }
+
+  EXPECT_EQ(batch.get_cycle_count(), machines[0].get_cycle_count());
+  for (size_t lane = 0; lane < LANES; lane++) {
+    EXPECT_TRUE(same(batch.get_lane(lane).snapshot(),
+                     machines[lane].snapshot()))
+        << "lane " << lane;
+  }
+}
+
+INSTANTIATE_TEST_SUITE_P(Roms, Chip8BatchTest,
+                         ::testing::Values("breakout.ch8", "flight-runner.ch8",
+                                           "pong.ch8", "tetris.ch8"));
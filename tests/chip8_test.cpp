@@ -3,10 +3,15 @@
 /// @author Abhay Manoj
 /// @date Feb 19 2026
 
-#include "../src/chip8.hpp"
+#include "core/chip8.hpp"
+#include "core/snapshot_file.hpp"
 #include <algorithm>
 #include <cstdint>
+#include <cstring>
 #include <gtest/gtest.h>
+#include <sstream>
+#include <string>
+#include <vector>
 
 class Chip8Test : public ::testing::Test {
 protected:
@@ -43,6 +48,26 @@ TEST_F(Chip8Test, LoadFontDataWorks) {
   EXPECT_EQ(cpu.get_register(4), 0x90);
 }
 
+// program bytes land at their own addresses up to the end of memory, the
+// ones below START are ignored so the font is kept
+TEST_F(Chip8Test, LoadIntoMemoryKeepsAddresses) {
+  std::fill(memory.begin(), memory.begin() + Chip8::START, 0xEE);
+  memory[Chip8::MEMORY_SIZE - 1] = 0x5A;
+  load(Chip8::START, 0xAF, 0xFF);     // I = 0xFFF
+  load(Chip8::START + 2, 0xF0, 0x65); // V0 = [I]
+  load(Chip8::START + 4, 0xA0, 0x32); // I = the sprite of A
+  load(Chip8::START + 6, 0xF1, 0x65); // V0 - V1 = [I]
+  cpu.load_into_memory(memory);
+  cpu.cycle();
+  cpu.cycle();
+  EXPECT_EQ(cpu.get_register(0), 0x5A);
+
+  cpu.cycle();
+  cpu.cycle();
+  EXPECT_EQ(cpu.get_register(0), 0xF0);
+  EXPECT_EQ(cpu.get_register(1), 0x90);
+}
+
 // sys sets the PC to 0xFFF
 TEST_F(Chip8Test, SysSetsPCToAddress) {
   load(Chip8::START, 0x0F, 0xFF);
@@ -97,6 +122,72 @@ TEST_F(Chip8Test, CallAddsToStackAndChangesPC) {
   EXPECT_EQ(cpu.get_stack()[cpu.get_SP() - 1], Chip8::START + 2);
 }
 
+// a call with every stack level in use stops the machine on it
+TEST_F(Chip8Test, CallOnFullStackFaults) {
+  load(Chip8::START, 0x22, 0x00); // calls itself forever
+  cpu.load_into_memory(memory);
+  for (auto engine : {Chip8::Engine::INTERPRETER, Chip8::Engine::DECODE_CACHE,
+                      Chip8::Engine::RECOMPILER}) {
+    cpu.reset();
+    cpu.load_into_memory(memory);
+    cpu.set_engine(engine);
+    cpu.run(100);
+    EXPECT_EQ(cpu.get_fault(), Chip8::Fault::STACK_OVERFLOW);
+    EXPECT_EQ(cpu.get_SP(), Chip8::STACK_SIZE);
+    EXPECT_EQ(cpu.get_PC(), Chip8::START);
+    EXPECT_EQ(cpu.get_cycle_count(), 100u);
+  }
+  cpu.reset();
+  EXPECT_EQ(cpu.get_fault(), Chip8::Fault::NONE);
+}
+
+// a return with nothing on the stack stops the machine on it
+TEST_F(Chip8Test, RetOnEmptyStackFaults) {
+  load(Chip8::START, 0x60, 0x05);
+  load(Chip8::START + 2, 0x00, 0xEE);
+  cpu.load_into_memory(memory);
+  cpu.run(10);
+  EXPECT_EQ(cpu.get_fault(), Chip8::Fault::STACK_UNDERFLOW);
+  EXPECT_EQ(cpu.get_PC(), Chip8::START + 2);
+  EXPECT_EQ(cpu.get_SP(), 0);
+  EXPECT_EQ(cpu.get_register(0), 0x05);
+  EXPECT_STREQ(fault_name(cpu.get_fault()), "stack_underflow");
+}
+
+// instructions no platform defines are skipped by every engine
+TEST_F(Chip8Test, UnknownInstructionsDoNothing) {
+  load(Chip8::START, 0x81, 0x29);
+  load(Chip8::START + 2, 0x60, 0x07);
+  for (auto engine : {Chip8::Engine::INTERPRETER, Chip8::Engine::DECODE_CACHE,
+                      Chip8::Engine::RECOMPILER}) {
+    cpu.reset();
+    cpu.load_into_memory(memory);
+    cpu.set_engine(engine);
+    cpu.run(2);
+    EXPECT_EQ(cpu.get_PC(), Chip8::START + 4);
+    EXPECT_EQ(cpu.get_register(0), 0x07);
+  }
+}
+
+// an arithmetic instruction on VF leaves the flag in it, not the result
+TEST_F(Chip8Test, FlagWinsOverResultInVf) {
+  load(Chip8::START, 0x6F, 0xFF);     // VF = FF
+  load(Chip8::START + 2, 0x8F, 0xFE); // VF <<= 1, carries 1
+  cpu.load_into_memory(memory);
+  cpu.run(2);
+  EXPECT_EQ(cpu.get_register(0xF), 1);
+}
+
+// only the low nibble of the register picks the key
+TEST_F(Chip8Test, SkipIfPressedUsesLowNibble) {
+  load(Chip8::START, 0x60, 0x15);
+  load(Chip8::START + 2, 0xE0, 0x9E);
+  cpu.load_into_memory(memory);
+  cpu.set_keypad(0x5, 1);
+  cpu.run(2);
+  EXPECT_EQ(cpu.get_PC(), Chip8::START + 6);
+}
+
 // skips the next instruction of the content of register and byte are equal
 TEST_F(Chip8Test, SkipNextIfEqualByteWorks) {
   load(Chip8::START, 0x60, 0xFF);
@@ -317,6 +408,42 @@ TEST_F(Chip8Test, RandomNumberAndByteWorks) {
   EXPECT_LE(cpu.get_register(0), 0x0F);
 }
 
+/// @brief runs CXFF a number of times and collects the results
+/// @param cpu the machine to run, reset with a looping CXFF program
+/// @param count the number of random bytes to generate
+/// @return the generated bytes
+static std::vector<uint8_t> random_bytes(Chip8 &cpu, int count) {
+  std::vector<uint8_t> bytes;
+  for (int i = 0; i < count; i++) {
+    cpu.run(2);
+    bytes.push_back(cpu.get_register(0));
+  }
+  return bytes;
+}
+
+// the same seed replays the same sequence, a different one does not
+TEST_F(Chip8Test, RandomNumbersFollowSeed) {
+  load(Chip8::START, 0xC0, 0xFF);
+  load(Chip8::START + 2, 0x12, 0x00);
+  cpu.load_into_memory(memory);
+
+  cpu.set_seed(1234);
+  std::vector<uint8_t> first = random_bytes(cpu, 64);
+  cpu.set_seed(1234);
+  EXPECT_EQ(random_bytes(cpu, 64), first);
+  cpu.set_seed(4321);
+  EXPECT_NE(random_bytes(cpu, 64), first);
+
+  // reset reuses the seed, restore picks up the generator mid sequence
+  cpu.reset();
+  cpu.load_into_memory(memory);
+  EXPECT_EQ(cpu.get_seed(), 4321);
+  Chip8::Snapshot saved = cpu.snapshot();
+  std::vector<uint8_t> after_reset = random_bytes(cpu, 64);
+  cpu.restore(saved);
+  EXPECT_EQ(random_bytes(cpu, 64), after_reset);
+}
+
 // draws an n byte sprite starting at (V_x, V_y), will wrap around
 TEST_F(Chip8Test, DrawUpdatesDisplayBufferProperly) {
   load(Chip8::START, 0x60, 0x3F);
@@ -336,7 +463,7 @@ TEST_F(Chip8Test, DrawUpdatesDisplayBufferProperly) {
     cpu.cycle();
   }
 
-  std::array<uint8_t, Chip8::WIDTH * Chip8::HEIGHT> expected{};
+  std::vector<uint8_t> expected(Chip8::WIDTH * Chip8::HEIGHT);
 
   /// Sprite A is 0xF0, 0x90, 0xF0, 0x90, 0x90
   expected[31 * 64 + 0] = 1;
@@ -359,6 +486,13 @@ TEST_F(Chip8Test, DrawUpdatesDisplayBufferProperly) {
   expected[3 * 64 + 63] = 1;
 
   EXPECT_EQ(expected, cpu.get_display_buffer());
+
+  // the in place form clears what the buffer held and needs room for it all
+  std::vector<uint8_t> buffer(expected.size(), 0xFF);
+  EXPECT_TRUE(cpu.get_display_buffer(buffer));
+  EXPECT_EQ(expected, buffer);
+  std::vector<uint8_t> small(expected.size() - 1);
+  EXPECT_FALSE(cpu.get_display_buffer(small));
 }
 
 // draws the same sprite on top of itself, should all be empty, and vf = 1
@@ -430,6 +564,29 @@ TEST_F(Chip8Test, ExecutionStopsUntilKeyPressed) {
   EXPECT_EQ(cpu.get_PC(), Chip8::START + 2);
 }
 
+// the PC holds on FX0A for as long as no key is down, and the cycle the key
+// is taken in only moves it past the wait
+TEST_F(Chip8Test, WaitForKeyHoldsPC) {
+  load(Chip8::START, 0xF0, 0x0A);
+  load(Chip8::START + 2, 0x61, 0x05);
+  cpu.load_into_memory(memory);
+  for (int i = 0; i < 5; i++) {
+    cpu.cycle();
+    EXPECT_EQ(cpu.get_PC(), Chip8::START);
+  }
+  EXPECT_EQ(cpu.get_register(1), 0);
+
+  cpu.set_keypad(0x7, 1);
+  cpu.cycle();
+  EXPECT_EQ(cpu.get_register(0), 0x7);
+  EXPECT_EQ(cpu.get_register(1), 0);
+  EXPECT_EQ(cpu.get_PC(), Chip8::START + 2);
+
+  cpu.cycle();
+  EXPECT_EQ(cpu.get_register(1), 0x05);
+  EXPECT_EQ(cpu.get_PC(), Chip8::START + 4);
+}
+
 TEST_F(Chip8Test, SetDelayTimerFromRegisterWorks) {
   load(Chip8::START, 0x60, 0xFF);
   load(Chip8::START + 2, 0xF0, 0x15);
@@ -528,3 +685,296 @@ TEST_F(Chip8Test, StoreMemoryIntoRegistersWorks) {
   EXPECT_EQ(cpu.get_register(0), 0x32);
   EXPECT_EQ(cpu.get_register(1), 0x14);
 }
+
+// the decode cache runs the same program as the interpreter
+TEST_F(Chip8Test, DecodeCacheExecutesInstructions) {
+  load(Chip8::START, 0x60, 0xFF);
+  load(Chip8::START + 2, 0x61, 0x02);
+  load(Chip8::START + 4, 0x80, 0x14);
+  load(Chip8::START + 6, 0x12, 0x04);
+  cpu.set_engine(Chip8::Engine::DECODE_CACHE);
+  cpu.load_into_memory(memory);
+
+  // the add at START + 4 runs twice, the second time from the cache
+  for (uint8_t i = 0; i < 5; i++) {
+    cpu.cycle();
+  }
+
+  EXPECT_EQ(cpu.get_register(0), 0x03);
+  EXPECT_EQ(cpu.get_register(0xF), 0x00);
+  EXPECT_EQ(cpu.get_PC(), Chip8::START + 6);
+}
+
+// FX55 overwriting a cached instruction makes the new one execute
+TEST_F(Chip8Test, DecodeCacheSeesSelfModifyingCode) {
+  load(Chip8::START, 0x12, 0x06);      // jump to START + 6
+  load(Chip8::START + 2, 0xA2, 0x06);  // I = START + 6
+  load(Chip8::START + 4, 0xF1, 0x55);  // overwrite START + 6 with V0, V1
+  load(Chip8::START + 6, 0x63, 0x05);  // V3 = 5, becomes V3 = 9
+  load(Chip8::START + 8, 0x60, 0x63);  // V0 = 0x63
+  load(Chip8::START + 10, 0x61, 0x09); // V1 = 0x09
+  load(Chip8::START + 12, 0x12, 0x02); // jump to START + 2
+  cpu.set_engine(Chip8::Engine::DECODE_CACHE);
+  cpu.load_into_memory(memory);
+
+  for (uint8_t i = 0; i < 5; i++) {
+    cpu.cycle();
+  }
+  EXPECT_EQ(cpu.get_register(3), 0x05);
+
+  for (uint8_t i = 0; i < 3; i++) {
+    cpu.cycle();
+  }
+  EXPECT_EQ(cpu.get_register(3), 0x09);
+}
+
+// the recompiler stops inside a block once the cycle budget runs out
+TEST_F(Chip8Test, RecompilerRunsExactCycleCount) {
+  load(Chip8::START, 0x60, 0x01);
+  load(Chip8::START + 2, 0x70, 0x01);
+  load(Chip8::START + 4, 0x70, 0x01);
+  load(Chip8::START + 6, 0x12, 0x02);
+  cpu.set_engine(Chip8::Engine::RECOMPILER);
+  cpu.load_into_memory(memory);
+
+  cpu.run(2);
+  EXPECT_EQ(cpu.get_register(0), 0x02);
+  EXPECT_EQ(cpu.get_PC(), Chip8::START + 4);
+
+  // finishes the first block, then loops through the second one twice
+  cpu.run(8);
+  EXPECT_EQ(cpu.get_register(0), 0x07);
+  EXPECT_EQ(cpu.get_PC(), Chip8::START + 2);
+}
+
+// FX55 overwriting a translated block makes the new instruction execute
+TEST_F(Chip8Test, RecompilerSeesSelfModifyingCode) {
+  load(Chip8::START, 0x12, 0x06);      // jump to START + 6
+  load(Chip8::START + 2, 0xA2, 0x06);  // I = START + 6
+  load(Chip8::START + 4, 0xF1, 0x55);  // overwrite START + 6 with V0, V1
+  load(Chip8::START + 6, 0x63, 0x05);  // V3 = 5, becomes V3 = 9
+  load(Chip8::START + 8, 0x60, 0x63);  // V0 = 0x63
+  load(Chip8::START + 10, 0x61, 0x09); // V1 = 0x09
+  load(Chip8::START + 12, 0x12, 0x02); // jump to START + 2
+  cpu.set_engine(Chip8::Engine::RECOMPILER);
+  cpu.load_into_memory(memory);
+
+  cpu.run(5);
+  EXPECT_EQ(cpu.get_register(3), 0x05);
+
+  cpu.run(3);
+  EXPECT_EQ(cpu.get_register(3), 0x09);
+}
+
+// draw records the rows it wrote and changes the display generation
+TEST_F(Chip8Test, DrawMarksDirtyRows) {
+  load(Chip8::START, 0x60, 0x08);
+  load(Chip8::START + 2, 0x61, 0x04);
+  load(Chip8::START + 4, 0xD0, 0x15);
+  cpu.load_into_memory(memory);
+  cpu.clear_dirty_rows();
+  uint64_t generation = cpu.get_display_generation();
+
+  for (uint8_t i = 0; i < 3; i++) {
+    cpu.cycle();
+  }
+
+  Chip8::DirtyRows dirty = cpu.get_dirty_rows();
+  EXPECT_EQ(dirty.first, 4);
+  EXPECT_EQ(dirty.end, 9);
+  EXPECT_NE(cpu.get_display_generation(), generation);
+
+  cpu.clear_dirty_rows();
+  dirty = cpu.get_dirty_rows();
+  EXPECT_GE(dirty.first, dirty.end);
+}
+
+// one emulated second runs the instruction rate and ticks the timers 60 times
+TEST_F(Chip8Test, RunForFollowsEmulatedTime) {
+  load(Chip8::START, 0x12, 0x00);
+  cpu.load_into_memory(memory);
+  cpu.set_DT(100);
+
+  cpu.run_for(std::chrono::seconds(1));
+
+  EXPECT_EQ(cpu.get_cycle_count(), Chip8::DEFAULT_INSTRUCTION_RATE);
+  EXPECT_EQ(cpu.get_DT(), 100 - Chip8::TIMER_RATE);
+}
+
+// splitting the time into slices gives the same result as one call
+TEST_F(Chip8Test, RunForIsIndependentOfSliceLength) {
+  load(Chip8::START, 0x12, 0x00);
+  cpu.load_into_memory(memory);
+  cpu.set_instruction_rate(1000);
+  cpu.set_DT(255);
+
+  // 7 ms slices, a 144 Hz display would be close to this
+  for (int i = 0; i < 500; i++) {
+    cpu.run_for(std::chrono::microseconds(7000));
+  }
+
+  EXPECT_EQ(cpu.get_cycle_count(), 3500);
+  EXPECT_EQ(cpu.get_DT(), 255 - 3.5 * Chip8::TIMER_RATE);
+}
+
+// a frame is a tenth of the default rate followed by a timer tick
+TEST_F(Chip8Test, RunFramesTicksTimersOncePerFrame) {
+  load(Chip8::START, 0x12, 0x00);
+  cpu.load_into_memory(memory);
+  cpu.set_ST(5);
+
+  cpu.run_frames(3);
+
+  EXPECT_EQ(cpu.get_cycle_count(), 30);
+  EXPECT_EQ(cpu.get_ST(), 2);
+}
+
+// fast forwarding a loop that polls DT ends in the same state as running it
+TEST_F(Chip8Test, IdleSkippingMatchesExecution) {
+  load(Chip8::START, 0x60, 0x3C);      // V0 = 60
+  load(Chip8::START + 2, 0xF0, 0x15);  // DT = V0
+  load(Chip8::START + 4, 0xF1, 0x07);  // V1 = DT
+  load(Chip8::START + 6, 0x31, 0x00);  // skip the jump once DT is 0
+  load(Chip8::START + 8, 0x12, 0x04);  // back to the poll
+  load(Chip8::START + 10, 0x72, 0x01); // V2 += 1
+  load(Chip8::START + 12, 0x12, 0x00); // start over
+
+  for (auto engine : {Chip8::Engine::INTERPRETER, Chip8::Engine::DECODE_CACHE,
+                      Chip8::Engine::RECOMPILER}) {
+    Chip8 skipping(memory), executing(memory);
+    skipping.set_engine(engine);
+    executing.set_engine(engine);
+    executing.set_idle_skipping(false);
+    skipping.set_instruction_rate(6000); // long enough frames to skip
+    executing.set_instruction_rate(6000);
+
+    skipping.run_frames(200);
+    executing.run_frames(200);
+
+    Chip8::Snapshot a = skipping.snapshot(), b = executing.snapshot();
+    EXPECT_EQ(std::memcmp(&a, &b, sizeof(a)), 0);
+    EXPECT_EQ(skipping.get_register(2), 3);
+    EXPECT_GT(skipping.get_idle_cycles(), 15000);
+    EXPECT_EQ(executing.get_idle_cycles(), 0);
+  }
+}
+
+// waiting in FX0A is skipped until a key is pressed
+TEST_F(Chip8Test, IdleSkippingWaitsForKey) {
+  load(Chip8::START, 0xF3, 0x0A); // V3 = the next key
+  cpu.load_into_memory(memory);
+
+  cpu.run(1000);
+  EXPECT_EQ(cpu.get_cycle_count(), 1000);
+  EXPECT_EQ(cpu.get_idle_cycles(), 999);
+  EXPECT_EQ(cpu.get_PC(), Chip8::START);
+
+  cpu.set_keypad(0x7, 1);
+  cpu.run(1);
+  EXPECT_EQ(cpu.get_register(3), 0x7);
+  EXPECT_EQ(cpu.get_PC(), Chip8::START + 2);
+}
+
+// a tap that goes down and up between two instructions still wakes FX0A, with
+// the first key that went down
+TEST_F(Chip8Test, KeyTapWakesWait) {
+  load(Chip8::START, 0xF3, 0x0A); // V3 = the next key
+
+  for (auto engine : {Chip8::Engine::INTERPRETER, Chip8::Engine::DECODE_CACHE,
+                      Chip8::Engine::RECOMPILER}) {
+    cpu.reset();
+    cpu.load_into_memory(memory);
+    cpu.set_engine(engine);
+    cpu.set_keypad(0x2, 1); // before the wait, so not latched
+    cpu.set_keypad(0x2, 0);
+    cpu.run(10);
+    cpu.set_keypad(0x9, 1);
+    cpu.set_keypad(0x4, 1);
+    cpu.set_keypad(0x9, 0);
+    cpu.run(1);
+    EXPECT_EQ(cpu.get_register(3), 0x9);
+    EXPECT_EQ(cpu.get_PC(), Chip8::START + 2);
+    cpu.set_keypad(0x4, 0);
+  }
+}
+
+// a loop that changes a register on every pass is executed
+TEST_F(Chip8Test, IdleSkippingRunsBusyLoops) {
+  load(Chip8::START, 0x70, 0x01);     // V0 += 1
+  load(Chip8::START + 2, 0x12, 0x00); // loop
+  cpu.load_into_memory(memory);
+
+  cpu.run(100);
+  EXPECT_EQ(cpu.get_register(0), 50);
+  EXPECT_EQ(cpu.get_idle_cycles(), 0);
+}
+
+// restoring a snapshot rewinds every part of the machine, including memory
+TEST_F(Chip8Test, RestoreRewindsToSnapshot) {
+  load(Chip8::START, 0x60, 0x2A);     // V0 = 0x2A
+  load(Chip8::START + 2, 0xA3, 0x00); // I = 0x300
+  load(Chip8::START + 4, 0xF0, 0x33); // bcd of V0 at I
+  load(Chip8::START + 6, 0x12, 0x00);
+  cpu.load_into_memory(memory);
+  cpu.set_engine(Chip8::Engine::RECOMPILER);
+
+  Chip8::Snapshot saved = cpu.snapshot();
+  cpu.run(4);
+  uint64_t generation = cpu.get_display_generation();
+  ASSERT_EQ(cpu.snapshot().memory[0x301], 4);
+
+  cpu.restore(saved);
+  EXPECT_EQ(cpu.get_PC(), Chip8::START);
+  EXPECT_EQ(cpu.get_register(0x0), 0);
+  EXPECT_EQ(cpu.get_cycle_count(), 0);
+  EXPECT_GT(cpu.get_display_generation(), generation);
+  EXPECT_EQ(cpu.snapshot().memory[0x301], 0);
+  EXPECT_EQ(cpu.snapshot().memory, saved.memory);
+
+  // the restored machine runs the same as the original did
+  cpu.run(4);
+  EXPECT_EQ(cpu.get_register(0x0), 0x2A);
+  EXPECT_EQ(cpu.get_I(), 0x300);
+}
+
+// a snapshot written to a stream reads back identically
+TEST_F(Chip8Test, SnapshotFileRoundTrips) {
+  load(Chip8::START, 0x6F, 0x11);
+  cpu.load_into_memory(memory);
+  cpu.run(1);
+  Chip8::Snapshot saved = cpu.snapshot();
+
+  std::stringstream stream;
+  ASSERT_TRUE(write_snapshot(stream, saved));
+
+  Chip8::Snapshot loaded{};
+  ASSERT_TRUE(read_snapshot(stream, loaded));
+  EXPECT_EQ(std::memcmp(&saved, &loaded, sizeof(saved)), 0);
+}
+
+// a stream that is not a snapshot is rejected
+TEST_F(Chip8Test, SnapshotFileRejectsBadHeader) {
+  std::stringstream stream("not a snapshot");
+  Chip8::Snapshot loaded{};
+  EXPECT_FALSE(read_snapshot(stream, loaded));
+}
+
+// a file of the version before the display moved into Chip8Extension is
+// rejected, even when the rest of its header matches
+TEST_F(Chip8Test, SnapshotFileRejectsOldVersion) {
+  load(Chip8::START, 0x6F, 0x11);
+  cpu.load_into_memory(memory);
+  cpu.run(1);
+
+  std::stringstream written;
+  ASSERT_TRUE(write_snapshot(written, cpu.snapshot()));
+  std::string bytes = written.str();
+  uint32_t old_version = 2;
+  std::memcpy(&bytes[sizeof(SNAPSHOT_MAGIC)], &old_version,
+              sizeof(old_version));
+
+  std::stringstream stream(bytes);
+  Chip8::Snapshot loaded{}, untouched{};
+  EXPECT_FALSE(read_snapshot(stream, loaded));
+  EXPECT_EQ(std::memcmp(&loaded, &untouched, sizeof(loaded)), 0);
+}
@@ -0,0 +1,97 @@
+/// @file engine_check_test.cpp
+/// @brief Tests for the differential runs of the execution engines
+/// @author Abhay Manoj
+/// @date Oct 14 2026
+
+#include "core/chip8.hpp"
+#include "core/engine_check.hpp"
+#include <cstdint>
+#include <fstream>
+#include <gtest/gtest.h>
+#include <iterator>
+#include <random>
+#include <string>
+#include <vector>
+
+/// @brief prints a mismatch for a failed check
+/// @param mismatch the mismatch
+/// @return the description
+static std::string describe(const EngineMismatch &mismatch) {
+  return mismatch.engine + " differs in " + mismatch.field + " after step " +
+         std::to_string(mismatch.step);
+}
+
+// the header picks the steps, the seed and the edges, the rest is code
+TEST(EngineCheckTest, ParsesCases) {
+  const uint8_t data[] = {
+      0x03, 0x09, 1, 0, 0, 0, 0, 0, 0, 0, // 4 cycles a step, 10 steps, seed 1
+      0x02,                               // 2 edges
+      0x04, 0x1A,                         // A down before step 4
+      0x0D, 0x0A,                         // A up before step 3
+      0x12, 0x00,                         // the program
+  };
+  EngineCheckCase test = parse_check_case(data);
+  EXPECT_EQ(test.step_cycles, 4u);
+  EXPECT_EQ(test.steps, 10u);
+  EXPECT_EQ(test.seed, 1u);
+  ASSERT_EQ(test.events.size(), 2u);
+  EXPECT_EQ(test.events[0].time, 4u);
+  EXPECT_EQ(test.events[0].key, 0xA);
+  EXPECT_TRUE(test.events[0].pressed);
+  EXPECT_EQ(test.events[1].time, 3u);
+  EXPECT_FALSE(test.events[1].pressed);
+  EXPECT_EQ(test.program, std::vector<uint8_t>({0x12, 0x00}));
+
+  EXPECT_EQ(parse_check_case(std::span(data, 3)).program.size(), 3u);
+}
+
+// the bundled roms agree on every engine while keys are pressed
+TEST(EngineCheckTest, RomsAgree) {
+  for (const char *name : {"breakout.ch8", "flight-runner.ch8", "pong.ch8",
+                           "tetris.ch8"}) {
+    std::ifstream file(std::string(CHIP8_ROM_DIR) + "/" + name,
+                       std::ios::binary);
+    ASSERT_TRUE(file) << name;
+    EngineCheckCase test;
+    test.program.assign(std::istreambuf_iterator<char>(file), {});
+    test.step_cycles = 37;
+    test.steps = 100;
+    for (uint32_t step = 0; step < test.steps; step += 9) {
+      uint8_t key = step % 16;
+      test.events.push_back({step, key, true});
+      test.events.push_back({step + 4, key, false});
+    }
+
+    EngineMismatch mismatch;
+    EXPECT_TRUE(check_engines<DefaultQuirks>(test, mismatch))
+        << name << ": " << describe(mismatch);
+  }
+}
+
+/// @brief checks made up programs on one profile
+/// @param cases the number of programs
+/// @param seed seeds the generator of the programs
+template <Chip8Quirks Quirks> static void check_random(int cases, int seed) {
+  std::mt19937 generator(seed);
+  for (int i = 0; i < cases; i++) {
+    std::vector<uint8_t> data(64 + generator() % 192);
+    for (uint8_t &byte : data) {
+      byte = generator();
+    }
+    // keep the runs short, the engines disagree within a few steps
+    data[1] %= 32;
+    EngineCheckCase test = parse_check_case(data);
+    EngineMismatch mismatch;
+    ASSERT_TRUE(check_engines<Quirks>(test, mismatch))
+        << "case " << i << ": " << describe(mismatch);
+  }
+}
+
+// random bytes as code reach faults, self modification and odd jumps
+TEST(EngineCheckTest, RandomProgramsAgree) {
+  check_random<DefaultQuirks>(60, 1);
+  check_random<CosmacVipQuirks>(20, 2);
+  check_random<Chip48Quirks>(20, 3);
+  check_random<SuperChipQuirks>(20, 4);
+  check_random<XoChipQuirks>(20, 5);
+}
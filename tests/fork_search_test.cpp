@@ -0,0 +1,133 @@
+/// @file fork_search_test.cpp
+/// @brief Tests for the ForkSearch class against machines run one by one
+/// @author Abhay Manoj
+/// @date Oct 14 2026
+
+#include "core/chip8.hpp"
+#include "core/fork_search.hpp"
+#include "core/thread_pool.hpp"
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <gtest/gtest.h>
+#include <iterator>
+#include <string>
+#include <vector>
+
+using Search = ForkSearch<DefaultQuirks>;
+
+/// @brief builds a machine running a bundled rom
+/// @param name the file name of the rom in the roms directory
+/// @return the machine, running nothing if the rom could not be read
+static Chip8 load_rom(const std::string &name) {
+  std::ifstream file(std::string(CHIP8_ROM_DIR) + "/" + name,
+                     std::ios::binary);
+  std::vector<uint8_t> program(std::istreambuf_iterator<char>(file), {});
+  return Chip8(Chip8::make_memory_image(program));
+}
+
+/// @brief compares two snapshots byte for byte, apart from the display
+/// generation that keeps counting across restores
+static bool same(Chip8::Snapshot a, Chip8::Snapshot b) {
+  a.display_generation = b.display_generation = 0;
+  return std::memcmp(&a, &b, sizeof(a)) == 0;
+}
+
+/// @brief runs a branch the slow way, on a machine of its own
+/// @param state the state to start from
+/// @param keys the keys held through each frame
+/// @param frames the frames to run
+/// @return the machine after the last frame
+static Chip8 replay(const Chip8::Snapshot &state,
+                    const Search::KeySequence &keys, uint32_t frames) {
+  Chip8 cpu;
+  cpu.restore(state);
+  uint16_t held = 0;
+  for (uint32_t frame = 0; frame < frames; frame++) {
+    uint16_t next = keys[std::min<size_t>(frame, keys.size() - 1)];
+    for (uint8_t key = 0; key < 16; key++) {
+      if ((held ^ next) >> key & 1) {
+        cpu.set_keypad(key, next >> key & 1);
+      }
+    }
+    held = next;
+    cpu.run_frames(1);
+  }
+  return cpu;
+}
+
+/// @brief makes branches that each hold a different key from some frame
+/// @param count the number of branches
+/// @return the branches
+static std::vector<Search::KeySequence> branches(size_t count) {
+  std::vector<Search::KeySequence> result(count);
+  for (size_t i = 0; i < count; i++) {
+    result[i].assign(i % 5, 0);
+    result[i].push_back(1 << (i % 16));
+    result[i].push_back(0);
+    result[i].push_back(1 << ((i * 7) % 16));
+  }
+  return result;
+}
+
+// every child ends where a machine restored from the checkpoint and given
+// the same keys does, on every engine
+TEST(ForkSearchTest, ChildrenMatchReplays) {
+  ThreadPool pool(4);
+  for (auto engine : {Chip8::Engine::INTERPRETER, Chip8::Engine::DECODE_CACHE,
+                      Chip8::Engine::RECOMPILER}) {
+    for (const char *name : {"breakout.ch8", "pong.ch8", "tetris.ch8"}) {
+      Chip8 parent = load_rom(name);
+      parent.set_engine(engine);
+      parent.run_frames(90);
+
+      Search search(pool, parent);
+      std::vector<Search::KeySequence> keys = branches(11);
+      std::vector<Search::Result> results = search.fork(keys, 40);
+      ASSERT_EQ(results.size(), keys.size());
+      for (size_t i = 0; i < keys.size(); i++) {
+        Chip8 reference = replay(parent.snapshot(), keys[i], 40);
+        EXPECT_TRUE(same(results[i].state, reference.snapshot()))
+            << name << " branch " << i;
+        EXPECT_EQ(results[i].frame, reference.get_display_buffer());
+      }
+    }
+  }
+}
+
+// children only copy the pages they write, the rest stays shared
+TEST(ForkSearchTest, ChildrenShareMemory) {
+  ThreadPool pool(2);
+  Chip8 parent = load_rom("pong.ch8");
+  parent.run_frames(60);
+
+  Search search(pool, parent);
+  for (const Search::Result &result : search.fork(branches(4), 60)) {
+    EXPECT_LE(result.private_memory, 2 * PagedMemory::PAGE_SIZE);
+  }
+}
+
+// a child's state continues the search, and the reward and display changes
+// are counted every frame
+TEST(ForkSearchTest, ForksFromChildren) {
+  ThreadPool pool(3);
+  Chip8 parent = load_rom("breakout.ch8");
+  parent.run_frames(30);
+
+  Search search(pool, parent);
+  auto frames = [](const Chip8 &) { return 1.0; };
+  std::vector<Search::KeySequence> first = {{0x10}, {0x40}};
+  std::vector<Search::Result> results = search.fork(first, 20, frames);
+  EXPECT_EQ(results[0].reward, 20);
+  EXPECT_GT(results[0].display_changes, 0u);
+
+  search.set_checkpoint(results[1].state);
+  std::vector<Search::KeySequence> second = {{0x40, 0}};
+  Search::Result next = search.fork(second, 20).front();
+
+  Search::KeySequence whole(20, 0x40);
+  whole.push_back(0);
+  Chip8 reference = replay(parent.snapshot(), whole, 40);
+  EXPECT_TRUE(same(next.state, reference.snapshot()));
+}
@@ -0,0 +1,176 @@
+/// @file golden_test.cpp
+/// @brief Golden frame hashes and a throughput gate for the bundled roms
+/// @author Abhay Manoj
+/// @date Oct 14 2026
+
+#include "core/chip8.hpp"
+#include "core/hash.hpp"
+#include "core/input_movie.hpp"
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <gtest/gtest.h>
+#include <iterator>
+#include <string>
+#include <vector>
+
+static constexpr int CHECKPOINTS = 10;
+static constexpr std::chrono::nanoseconds CHECKPOINT_INTERVAL =
+    std::chrono::seconds(1);
+static constexpr uint64_t SEED = 0xC8;
+static constexpr uint64_t THROUGHPUT_CYCLES = 2'000'000;
+
+/// @brief the display hashes a rom must reach at each checkpoint
+struct Golden {
+  const char *rom;
+  std::array<uint64_t, CHECKPOINTS> hashes;
+};
+
+// regenerate with CHIP8_PRINT_GOLDEN=1 after a change meant to alter what
+// the roms draw, and say why in the commit
+static const Golden GOLDEN[] = {
+    {"breakout.ch8",
+     {0x54ABA90BF696023Eull, 0x86695605603C44C7ull, 0xA5B5C959C26BF582ull,
+      0x763F53F22AF46F31ull, 0xF3C9FB623A9888BFull, 0xF3C9FB623A9888BFull,
+      0xBCC8FFFF01261604ull, 0xBCC8FFFF01261604ull, 0x820EB153E7DC1EBDull,
+      0x1EFCFCE4FA87ACD5ull}},
+    {"flight-runner.ch8",
+     {0x99690FFEDCD9E357ull, 0x0F05A231D43B99EBull, 0x347ABFF49A6F3FEBull,
+      0x67AB72977730E2DBull, 0xC4B72CC85F8F12DBull, 0x5B4EE56E977580DBull,
+      0xF624AEEE21F968DBull, 0xE864C5DF0AAE2ECEull, 0xE864C5DF0AAE2ECEull,
+      0xE864C5DF0AAE2ECEull}},
+    {"ibm.ch8",
+     {0x1F1D341CAB07E169ull, 0x1F1D341CAB07E169ull, 0x1F1D341CAB07E169ull,
+      0x1F1D341CAB07E169ull, 0x1F1D341CAB07E169ull, 0x1F1D341CAB07E169ull,
+      0x1F1D341CAB07E169ull, 0x1F1D341CAB07E169ull, 0x1F1D341CAB07E169ull,
+      0x1F1D341CAB07E169ull}},
+    {"pong.ch8",
+     {0xC26AB6F1993746E9ull, 0x766E6DFCE501285Aull, 0x0E6DC00752D40962ull,
+      0xC5C17301EA380CBDull, 0xE0C43F0C7E6B2926ull, 0xF80827F473C3C3A2ull,
+      0x1E7CB65D671602FCull, 0xD22546D96A53493Dull, 0x471A0E0CC28FC1D5ull,
+      0x4FEDF559377B5BA5ull}},
+    {"tetris.ch8",
+     {0xE1ABB00D7FF18463ull, 0x3770888B5E215463ull, 0x6BD9C6AE39614C63ull,
+      0x781163BDB7DF2063ull, 0xE76770945D257DF1ull, 0x93318846AEE9B7B5ull,
+      0xFAB7662F148532C5ull, 0x144ED797875573F1ull, 0xA93FA6936E128FF1ull,
+      0x38DEC93C27AC97B5ull}},
+};
+
+/// @brief reads a bundled rom
+/// @param name the file name of the rom in the roms directory
+/// @return the program, empty if it could not be read
+static std::vector<uint8_t> read_rom(const std::string &name) {
+  std::ifstream file(std::string(CHIP8_ROM_DIR) + "/" + name,
+                     std::ios::binary);
+  return std::vector<uint8_t>(std::istreambuf_iterator<char>(file), {});
+}
+
+/// @brief makes the movie every rom is played with. it taps and holds the
+/// keys the bundled games use, at uneven times so the games take different
+/// paths
+/// @param image the memory image of the rom
+/// @return the movie
+static InputMovie make_movie(const Chip8::MemoryImage &image) {
+  InputMovie movie;
+  movie.seed = SEED;
+  movie.rom_hash = hash_rom(image);
+
+  const uint8_t keys[] = {0x4, 0x6, 0x1, 0x5, 0xC, 0x7, 0xD, 0x4};
+  uint64_t time = 200'000'000;
+  for (int i = 0; i < 40; i++) {
+    uint8_t key = keys[i % std::size(keys)];
+    uint64_t hold = 50'000'000 + i % 7 * 40'000'000;
+    movie.events.push_back({time, key, true});
+    movie.events.push_back({time + hold, key, false});
+    time += hold + 30'000'000 + i % 3 * 70'000'000;
+  }
+  movie.length = (CHECKPOINTS * CHECKPOINT_INTERVAL).count();
+  return movie;
+}
+
+/// @brief plays the movie of a rom and hashes the display at every
+/// checkpoint
+/// @param rom the program
+/// @param engine the engine to run it on
+/// @return the hash at each checkpoint
+static std::array<uint64_t, CHECKPOINTS> play(const std::vector<uint8_t> &rom,
+                                               Chip8::Engine engine) {
+  auto image = Chip8::make_memory_image(rom);
+  InputMovie movie = make_movie(*image);
+  Chip8 cpu(image);
+  cpu.set_engine(engine);
+  cpu.set_seed(movie.seed);
+  cpu.set_instruction_rate(movie.instruction_rate);
+
+  std::array<uint64_t, CHECKPOINTS> hashes{};
+  size_t next = 0;
+  for (int checkpoint = 0; checkpoint < CHECKPOINTS; checkpoint++) {
+    auto time = (checkpoint + 1) * CHECKPOINT_INTERVAL;
+    for (; next < movie.events.size() &&
+           movie.events[next].time <= static_cast<uint64_t>(time.count());
+         next++) {
+      cpu.run_until(std::chrono::nanoseconds(movie.events[next].time));
+      cpu.set_keypad(movie.events[next].key, movie.events[next].pressed);
+    }
+    cpu.run_until(time);
+    std::vector<uint8_t> display = cpu.get_display_buffer();
+    hashes[checkpoint] = fnv1a(display.data(), display.size());
+  }
+  return hashes;
+}
+
+// every engine draws the recorded frames of every rom
+TEST(GoldenTest, FrameHashesMatch) {
+  bool print = std::getenv("CHIP8_PRINT_GOLDEN") != nullptr;
+  for (const Golden &golden : GOLDEN) {
+    std::vector<uint8_t> rom = read_rom(golden.rom);
+    ASSERT_FALSE(rom.empty()) << golden.rom;
+    if (print) {
+      std::printf("    {\"%s\", {", golden.rom);
+      for (uint64_t hash : play(rom, Chip8::Engine::INTERPRETER)) {
+        std::printf("0x%016llXull, ", static_cast<unsigned long long>(hash));
+      }
+      std::printf("}},\n");
+      continue;
+    }
+
+    for (auto engine : {Chip8::Engine::INTERPRETER, Chip8::Engine::DECODE_CACHE,
+                        Chip8::Engine::RECOMPILER}) {
+      std::array<uint64_t, CHECKPOINTS> hashes = play(rom, engine);
+      for (int checkpoint = 0; checkpoint < CHECKPOINTS; checkpoint++) {
+        EXPECT_EQ(hashes[checkpoint], golden.hashes[checkpoint])
+            << golden.rom << " engine " << static_cast<int>(engine)
+            << " second " << checkpoint + 1;
+      }
+    }
+  }
+}
+
+// each engine keeps above CHIP8_MIN_IPS instructions a second on every rom,
+// with idle skipping off so only executed instructions count
+TEST(GoldenTest, ThroughputAboveGate) {
+  for (const Golden &golden : GOLDEN) {
+    std::vector<uint8_t> rom = read_rom(golden.rom);
+    ASSERT_FALSE(rom.empty()) << golden.rom;
+    for (auto engine : {Chip8::Engine::INTERPRETER, Chip8::Engine::DECODE_CACHE,
+                        Chip8::Engine::RECOMPILER}) {
+      Chip8 cpu(Chip8::make_memory_image(rom));
+      cpu.set_engine(engine);
+      cpu.set_idle_skipping(false);
+      auto start = std::chrono::steady_clock::now();
+      cpu.run(THROUGHPUT_CYCLES);
+      std::chrono::duration<double> seconds =
+          std::chrono::steady_clock::now() - start;
+      double ips = THROUGHPUT_CYCLES / seconds.count();
+
+      std::string name = std::string(golden.rom) + "_engine_" +
+                         std::to_string(static_cast<int>(engine));
+      RecordProperty(name, std::to_string(static_cast<uint64_t>(ips)));
+      EXPECT_GE(ips, CHIP8_MIN_IPS) << name;
+    }
+  }
+}
@@ -0,0 +1,107 @@
+/// @file input_movie_test.cpp
+/// @brief Tests for input movie recording and replay
+/// @author Abhay Manoj
+/// @date Oct 14 2026
+
+#include "core/chip8.hpp"
+#include "core/input_movie.hpp"
+#include <array>
+#include <cstdint>
+#include <cstring>
+#include <gtest/gtest.h>
+#include <sstream>
+
+class InputMovieTest : public ::testing::Test {
+protected:
+  std::array<uint8_t, Chip8::MEMORY_SIZE> memory{};
+
+  /// @brief loads a program whose display depends on key 5, the random
+  /// generator and the delay timer
+  void SetUp() override {
+    const uint8_t program[] = {
+        0x60, 0x05, // V0 = 5
+        0xE0, 0x9E, // skip if key V0 is pressed
+        0x12, 0x08, // jump past the increment
+        0x71, 0x01, // V1 += 1
+        0xC2, 0x0F, // V2 = rand & 0xF
+        0xF2, 0x29, // I = sprite of V2
+        0xD1, 0x25, // draw at V1, V2
+        0xF3, 0x07, // V3 = DT
+        0x33, 0x00, // skip if V3 == 0
+        0x12, 0x02, // loop
+        0x63, 0x03, // V3 = 3
+        0xF3, 0x15, // DT = V3
+        0x12, 0x02, // loop
+    };
+    std::memcpy(memory.data() + Chip8::START, program, sizeof(program));
+  }
+
+  /// @brief compares two snapshots byte for byte
+  static bool same(const Chip8::Snapshot &a, const Chip8::Snapshot &b) {
+    return std::memcmp(&a, &b, sizeof(a)) == 0;
+  }
+
+  /// @brief records a session with uneven frame times and key presses
+  /// @param cpu the machine to record, left at the end of the session
+  /// @return the recorded movie
+  InputMovie record(Chip8 &cpu) {
+    cpu.set_seed(99);
+    InputMovie movie = start_movie(cpu, hash_rom(memory));
+    for (int frame = 0; frame < 300; frame++) {
+      if (frame % 37 == 0 || frame % 41 == 0) {
+        bool pressed = frame % 37 == 0;
+        record_key(movie, cpu, 5, pressed);
+        cpu.set_keypad(5, pressed);
+      }
+      cpu.run_for(std::chrono::microseconds(9000 + frame % 13 * 1000));
+    }
+    truncate_movie(movie, cpu.get_emulated_time());
+    return movie;
+  }
+};
+
+// a replay reaches exactly the state the recorded session ended in
+TEST_F(InputMovieTest, ReplayMatchesRecording) {
+  Chip8 recorded(memory);
+  InputMovie movie = record(recorded);
+  ASSERT_FALSE(movie.events.empty());
+
+  Chip8 replayed(memory);
+  replayed.set_engine(Chip8::Engine::RECOMPILER);
+  play_movie(replayed, movie);
+  EXPECT_TRUE(same(replayed.snapshot(), recorded.snapshot()));
+}
+
+// a movie written to a stream reads back identically
+TEST_F(InputMovieTest, MovieFileRoundTrips) {
+  Chip8 cpu(memory);
+  InputMovie movie = record(cpu);
+
+  std::stringstream stream;
+  ASSERT_TRUE(write_movie(stream, movie));
+  InputMovie loaded;
+  ASSERT_TRUE(read_movie(stream, loaded));
+
+  EXPECT_EQ(loaded.seed, movie.seed);
+  EXPECT_EQ(loaded.instruction_rate, movie.instruction_rate);
+  EXPECT_EQ(loaded.rom_hash, movie.rom_hash);
+  EXPECT_EQ(loaded.length, movie.length);
+  ASSERT_EQ(loaded.events.size(), movie.events.size());
+  for (size_t i = 0; i < movie.events.size(); i++) {
+    EXPECT_EQ(loaded.events[i].time, movie.events[i].time);
+    EXPECT_EQ(loaded.events[i].key, movie.events[i].key);
+    EXPECT_EQ(loaded.events[i].pressed, movie.events[i].pressed);
+  }
+}
+
+// a truncated file is rejected
+TEST_F(InputMovieTest, MovieFileRejectsTruncation) {
+  Chip8 cpu(memory);
+  std::stringstream stream;
+  ASSERT_TRUE(write_movie(stream, record(cpu)));
+
+  std::string bytes = stream.str();
+  std::stringstream truncated(bytes.substr(0, bytes.size() - 1));
+  InputMovie loaded;
+  EXPECT_FALSE(read_movie(truncated, loaded));
+}
@@ -0,0 +1,112 @@
+/// @file input_queue_test.cpp
+/// @brief Tests for applying timestamped key edges to a running machine
+/// @author Abhay Manoj
+/// @date Oct 14 2026
+
+#include "core/chip8.hpp"
+#include "core/input_movie.hpp"
+#include "core/input_queue.hpp"
+#include <array>
+#include <chrono>
+#include <cstdint>
+#include <cstring>
+#include <gtest/gtest.h>
+
+static constexpr uint64_t HOST_START = 5'000'000'000; // host clock at reset
+static constexpr uint64_t FRAME_NS = 16'666'666;
+
+class InputQueueTest : public ::testing::Test {
+protected:
+  std::array<uint8_t, Chip8::MEMORY_SIZE> memory{};
+  InputQueue<16> queue;
+
+  /// @brief loads a program that draws the digit of every key it waits for
+  void SetUp() override {
+    const uint8_t program[] = {
+        0xF3, 0x0A, // V3 = the next key
+        0xF3, 0x29, // I = sprite of V3
+        0xD4, 0x45, // draw at V4, V4
+        0x74, 0x05, // V4 += 5
+        0x12, 0x00, // loop
+    };
+    std::memcpy(memory.data() + Chip8::START, program, sizeof(program));
+  }
+};
+
+// each edge is applied at its offset into the span, not at a frame boundary
+TEST_F(InputQueueTest, EdgesLandAtTheirOffset) {
+  Chip8 cpu(memory);
+  InputMovie movie = start_movie(cpu, hash_rom(memory));
+  ASSERT_TRUE(queue.push(HOST_START + 5'000'000, 0x5, true));
+  ASSERT_TRUE(queue.push(HOST_START + 9'000'000, 0x5, false));
+
+  queue.run_for(cpu, HOST_START, FRAME_NS, &movie);
+  ASSERT_EQ(movie.events.size(), 2u);
+  EXPECT_EQ(movie.events[0].time, 5'000'000u);
+  EXPECT_EQ(movie.events[1].time, 9'000'000u);
+  EXPECT_EQ(cpu.get_emulated_time(), std::chrono::nanoseconds(FRAME_NS));
+  EXPECT_EQ(cpu.get_register(3), 0x5);
+}
+
+// edges from before the span land at its start and those after at its end
+TEST_F(InputQueueTest, EdgesOutsideTheSpanAreClamped) {
+  Chip8 cpu(memory);
+  InputMovie movie = start_movie(cpu, hash_rom(memory));
+  ASSERT_TRUE(queue.push(HOST_START - 1'000, 0x1, true));
+  ASSERT_TRUE(queue.push(HOST_START + 2 * FRAME_NS, 0x1, false));
+
+  queue.run_for(cpu, HOST_START, FRAME_NS, &movie);
+  ASSERT_EQ(movie.events.size(), 2u);
+  EXPECT_EQ(movie.events[0].time, 0u);
+  EXPECT_EQ(movie.events[1].time, FRAME_NS);
+}
+
+// a tap far shorter than an instruction still wakes FX0A
+TEST_F(InputQueueTest, ShortTapWakesWait) {
+  Chip8 cpu(memory);
+  ASSERT_TRUE(queue.push(HOST_START + 4'000'000, 0xA, true));
+  ASSERT_TRUE(queue.push(HOST_START + 4'000'001, 0xA, false));
+
+  queue.run_for(cpu, HOST_START, FRAME_NS);
+  EXPECT_EQ(cpu.get_register(3), 0xA);
+  EXPECT_EQ(cpu.get_register(4), 5);
+  EXPECT_EQ(cpu.get_PC(), Chip8::START);
+}
+
+// unthrottled the span has no known length, so the edges are applied first
+TEST_F(InputQueueTest, UnthrottledAppliesEdgesFirst) {
+  Chip8 cpu(memory);
+  cpu.set_throttled(false);
+  InputMovie movie = start_movie(cpu, hash_rom(memory));
+  ASSERT_TRUE(queue.push(HOST_START + 100, 0x3, true));
+
+  queue.run_for(cpu, HOST_START, 1'000'000, &movie);
+  ASSERT_EQ(movie.events.size(), 1u);
+  EXPECT_EQ(movie.events[0].time, 0u);
+  EXPECT_GT(cpu.get_emulated_time().count(), 0);
+}
+
+// a session fed through the queue replays to exactly the same state
+TEST_F(InputQueueTest, ReplayMatchesQueuedSession) {
+  Chip8 recorded(memory);
+  InputMovie movie = start_movie(recorded, hash_rom(memory));
+  uint64_t host = HOST_START;
+  for (int frame = 0; frame < 120; frame++) {
+    if (frame % 7 == 0) {
+      uint64_t time = host + 1'000'000 + frame * 97'000;
+      ASSERT_TRUE(queue.push(time, frame % 16, true));
+      ASSERT_TRUE(queue.push(time + 300, frame % 16, false));
+    }
+    queue.run_for(recorded, host, FRAME_NS, &movie);
+    host += FRAME_NS;
+  }
+  truncate_movie(movie, recorded.get_emulated_time());
+  ASSERT_EQ(movie.events.size(), 36u);
+
+  Chip8 replayed(memory);
+  replayed.set_engine(Chip8::Engine::RECOMPILER);
+  play_movie(replayed, movie);
+  Chip8::Snapshot a = recorded.snapshot(), b = replayed.snapshot();
+  EXPECT_EQ(std::memcmp(&a, &b, sizeof(a)), 0);
+  EXPECT_GT(recorded.get_register(4), 0); // some taps came during FX0A
+}
@@ -0,0 +1,138 @@
+/// @file paged_memory_test.cpp
+/// @brief Tests for the PagedMemory class and machines sharing an image
+/// @author Abhay Manoj
+/// @date Oct 14 2026
+
+#include "core/chip8.hpp"
+#include "core/paged_memory.hpp"
+#include "core/quirks.hpp"
+#include <array>
+#include <cstdint>
+#include <cstring>
+#include <gtest/gtest.h>
+#include <memory>
+#include <vector>
+
+// a write copies only the page it lands in, the image stays untouched
+TEST(PagedMemoryTest, WriteCopiesOnlyItsPage) {
+  auto image = std::make_shared<PagedMemory::Image>();
+  (*image)[0x305] = 7;
+  PagedMemory memory(image);
+  EXPECT_EQ(memory[0x305], 7);
+  EXPECT_EQ(memory.get_private_pages(), 0);
+
+  memory.write(0x305, 9);
+  memory.write(0x3FF, 1);
+  EXPECT_EQ(memory[0x305], 9);
+  EXPECT_EQ(memory.get_private_pages(), 1);
+  EXPECT_EQ((*image)[0x305], 7);
+}
+
+// a copy starts with the bytes of the original, later writes stay apart
+TEST(PagedMemoryTest, CopiesAreIndependent) {
+  PagedMemory original;
+  original.write(0x10, 1);
+  PagedMemory copy = original;
+  EXPECT_EQ(copy[0x10], 1);
+
+  copy.write(0x10, 2);
+  EXPECT_EQ(original[0x10], 1);
+  EXPECT_EQ(copy[0x10], 2);
+
+  original.write(0x10, 3);
+  EXPECT_EQ(original[0x10], 3);
+  EXPECT_EQ(copy[0x10], 2);
+}
+
+// addresses past the end wrap around to the start
+TEST(PagedMemoryTest, AddressesWrap) {
+  PagedMemory memory;
+  memory.write(PagedMemory::SIZE + 4, 5);
+  EXPECT_EQ(memory[4], 5);
+  EXPECT_EQ(memory[PagedMemory::SIZE + 4], 5);
+}
+
+// without wrapping, addresses past the end read zeros and drop writes
+TEST(PagedMemoryTest, GuardPagesDropWrites) {
+  BasicPagedMemory<4096, false> memory;
+  memory.write(4, 5);
+  memory.write(4096 + 4, 6);
+  memory.write(0xFFFF, 7);
+  EXPECT_EQ(memory[4], 5);
+  EXPECT_EQ(memory[4096 + 4], 0);
+  EXPECT_EQ(memory[0xFFFF], 0);
+  EXPECT_EQ(memory.get_private_pages(), 1);
+
+  BasicPagedMemory<4096, false> copy = memory;
+  EXPECT_EQ(copy[4], 5);
+  EXPECT_EQ(copy[4096 + 4], 0);
+}
+
+// FX55 running off the top of the address space of a profile without
+// wrapping drops the tail instead of storing it at 0
+TEST(PagedMemoryTest, StoresPastTheTableAreDropped) {
+  using Chip48 = BasicChip8<Chip48Quirks>;
+  auto image = Chip48::make_memory_image();
+  const uint8_t program[] = {
+      0xFF, 0x55, // store V0-VF at I
+  };
+  std::memcpy(image->data() + Chip48::START, program, sizeof(program));
+  const Chip48::MemoryImage flat = *image;
+
+  Chip48 cpu(image);
+  Chip48::Snapshot state = cpu.snapshot();
+  state.V.fill(0xAB);
+  state.I = 0xFFF8;
+  cpu.restore(state);
+  cpu.run(1);
+
+  EXPECT_EQ(cpu.snapshot().memory, flat);
+  EXPECT_EQ(cpu.get_private_memory(), 0);
+}
+
+// assigning bytes that match the image gives the private pages back
+TEST(PagedMemoryTest, AssignReturnsMatchingPagesToImage) {
+  auto image = std::make_shared<PagedMemory::Image>();
+  PagedMemory memory(image);
+  memory.write(0x200, 1);
+  memory.write(0x900, 1);
+
+  PagedMemory::Image contents;
+  memory.copy_to(contents);
+  contents[0x200] = 0;
+  memory.assign(contents);
+  EXPECT_EQ(memory.get_private_pages(), 1);
+  EXPECT_EQ(memory[0x200], 0);
+  EXPECT_EQ(memory[0x900], 1);
+
+  memory.assign(*image);
+  EXPECT_EQ(memory.get_private_pages(), 0);
+}
+
+// machines sharing one image each copy only the page they write, and run
+// exactly like machines with their own memory
+TEST(PagedMemoryTest, MachinesShareOneImage) {
+  auto image = Chip8::make_memory_image();
+  const uint8_t program[] = {
+      0x70, 0x01, // V0 += 1
+      0xA3, 0x00, // I = 0x300
+      0xF0, 0x33, // bcd of V0 at I
+      0x12, 0x00, // jump to start
+  };
+  std::memcpy(image->data() + Chip8::START, program, sizeof(program));
+  const Chip8::MemoryImage flat = *image;
+
+  std::vector<Chip8> machines(4, Chip8(image));
+  Chip8 reference(flat);
+  for (Chip8 &cpu : machines) {
+    EXPECT_EQ(cpu.get_private_memory(), 0);
+    cpu.run(400);
+    EXPECT_EQ(cpu.get_private_memory(), PagedMemory::PAGE_SIZE);
+  }
+  reference.run(400);
+
+  EXPECT_EQ(*image, flat);
+  for (const Chip8 &cpu : machines) {
+    EXPECT_EQ(cpu.snapshot().memory, reference.snapshot().memory);
+  }
+}
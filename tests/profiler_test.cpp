@@ -0,0 +1,121 @@
+/// @file profiler_test.cpp
+/// @brief Tests for the Profiler class
+/// @author Abhay Manoj
+/// @date Oct 14 2026
+
+#include "core/chip8.hpp"
+#include "core/profiler.hpp"
+#include <cstdint>
+#include <gtest/gtest.h>
+#include <sstream>
+#include <string>
+
+// instructions are counted by opcode and by address
+TEST(ProfilerTest, CountsOpsAndAddresses) {
+  Profiler profiler;
+  profiler.count_instruction(0x200, Op::LOAD_I);
+  profiler.count_instruction(0x202, Op::DRAW);
+  profiler.count_instruction(0x200, Op::LOAD_I);
+
+  EXPECT_EQ(profiler.get_instructions(), 3);
+  EXPECT_EQ(profiler.get_op_count(Op::LOAD_I), 2);
+  EXPECT_EQ(profiler.get_op_count(Op::DRAW), 1);
+  EXPECT_EQ(profiler.get_pc_count(0x200), 2);
+  EXPECT_EQ(profiler.get_pc_count(0x204), 0);
+
+  profiler.clear();
+  EXPECT_EQ(profiler.get_instructions(), 0);
+  EXPECT_EQ(profiler.get_pc_count(0x200), 0);
+}
+
+// the folded stacks attribute instructions to the chain of calls they ran in
+TEST(ProfilerTest, FoldsCallStacks) {
+  Profiler profiler;
+  profiler.count_instruction(0x200, Op::CALL);
+  profiler.enter(0x300);
+  profiler.count_instruction(0x300, Op::CALL);
+  profiler.enter(0x400);
+  profiler.count_instruction(0x400, Op::RET);
+  profiler.leave();
+  profiler.count_instruction(0x302, Op::RET);
+  profiler.leave();
+  profiler.leave(); // an unmatched return stays at the root
+  profiler.count_instruction(0x202, Op::JUMP);
+
+  std::ostringstream folded;
+  ASSERT_TRUE(profiler.write_folded(folded));
+  EXPECT_EQ(folded.str(), "0x200 2\n"
+                          "0x200;0x300 2\n"
+                          "0x200;0x300;0x400 1\n");
+}
+
+// the json lists the totals, the opcodes that ran and the hottest addresses
+TEST(ProfilerTest, WritesJson) {
+  Profiler profiler;
+  profiler.count_instruction(0x210, Op::STORE_KEY_PRESS);
+  profiler.count_frame(true);
+  profiler.count_frame(false);
+  profiler.count_draw(100);
+
+  std::ostringstream json;
+  ASSERT_TRUE(profiler.write_json(json));
+  EXPECT_NE(json.str().find("\"blocked_frames\": 1"), std::string::npos);
+  EXPECT_NE(json.str().find("\"STORE_KEY_PRESS\": 1"), std::string::npos);
+  EXPECT_NE(json.str().find("\"pc\": \"0x210\""), std::string::npos);
+  EXPECT_EQ(json.str().find("\"DRAW\""), std::string::npos);
+}
+
+#ifdef CHIP8_PROFILING
+// every engine feeds the profiler the same counts
+TEST(ProfilerTest, EnginesProfileAlike) {
+  std::array<uint8_t, Chip8::MEMORY_SIZE> memory{};
+  const uint8_t program[] = {
+      0x22, 0x06, // call 0x206
+      0x12, 0x00, // jump to start
+      0x00, 0x00, // padding
+      0xD0, 0x15, // draw at 0x206
+      0x00, 0xEE, // return
+  };
+  std::copy(std::begin(program), std::end(program),
+            memory.begin() + Chip8::START);
+
+  for (auto engine : {Chip8::Engine::INTERPRETER, Chip8::Engine::DECODE_CACHE,
+                      Chip8::Engine::RECOMPILER}) {
+    Chip8 cpu(memory);
+    cpu.set_engine(engine);
+    cpu.run(400);
+    const Profiler &profiler = cpu.get_profiler();
+    EXPECT_EQ(profiler.get_instructions(), 400);
+    EXPECT_EQ(profiler.get_op_count(Op::DRAW), 100);
+    EXPECT_EQ(profiler.get_draw_calls(), 100);
+    EXPECT_EQ(profiler.get_pc_count(0x206), 100);
+  }
+}
+
+// instructions fast forwarded through an idle loop are counted as executed
+TEST(ProfilerTest, IdleSkippingProfilesAlike) {
+  std::array<uint8_t, Chip8::MEMORY_SIZE> memory{};
+  const uint8_t program[] = {
+      0x60, 0xFF, // V0 = 255
+      0xF0, 0x15, // DT = V0
+      0xF1, 0x07, // V1 = DT
+      0x31, 0x00, // skip the jump once DT is 0
+      0x12, 0x04, // back to the poll
+  };
+  std::copy(std::begin(program), std::end(program),
+            memory.begin() + Chip8::START);
+
+  Chip8 skipping(memory), executing(memory);
+  skipping.set_instruction_rate(6000);
+  executing.set_instruction_rate(6000);
+  executing.set_idle_skipping(false);
+  skipping.run_frames(10);
+  executing.run_frames(10);
+
+  ASSERT_GT(skipping.get_idle_cycles(), 0);
+  std::ostringstream a, b;
+  ASSERT_TRUE(skipping.get_profiler().write_json(a));
+  ASSERT_TRUE(executing.get_profiler().write_json(b));
+  EXPECT_EQ(a.str(), b.str());
+}
+#endif
@@ -0,0 +1,166 @@
+/// @file quirks_test.cpp
+/// @brief Tests for the quirk profiles of BasicChip8
+/// @author Abhay Manoj
+/// @date Oct 14 2026
+
+#include "core/chip8.hpp"
+#include <cstdint>
+#include <gtest/gtest.h>
+#include <initializer_list>
+#include <vector>
+
+/// @brief builds a machine with instructions from START onwards
+/// @tparam Machine the type of the machine
+/// @param instructions the instructions to load
+/// @param data bytes placed after the instructions
+/// @return the machine
+template <typename Machine>
+static Machine machine(std::initializer_list<uint16_t> instructions,
+                       std::initializer_list<uint8_t> data = {}) {
+  std::vector<uint8_t> program;
+  for (uint16_t instruction : instructions) {
+    program.push_back(instruction >> 8);
+    program.push_back(instruction & 0xFF);
+  }
+  program.insert(program.end(), data.begin(), data.end());
+  return Machine(Machine::make_memory_image(program));
+}
+
+// 8XY6 and 8XYE shift V_y into V_x on the VIP, V_x in place otherwise
+TEST(QuirksTest, ShiftSource) {
+  std::initializer_list<uint16_t> program = {0x6005, 0x6181, 0x8016, 0x6005,
+                                             0x801E};
+
+  auto vip = machine<BasicChip8<CosmacVipQuirks>>(program);
+  vip.run(3);
+  EXPECT_EQ(vip.get_register(0), 0x40);
+  EXPECT_EQ(vip.get_register(0xF), 1);
+  vip.run(2);
+  EXPECT_EQ(vip.get_register(0), 0x02);
+  EXPECT_EQ(vip.get_register(0xF), 1);
+
+  auto cpu = machine<Chip8>(program);
+  cpu.run(3);
+  EXPECT_EQ(cpu.get_register(0), 0x02);
+  EXPECT_EQ(cpu.get_register(0xF), 1);
+  cpu.run(2);
+  EXPECT_EQ(cpu.get_register(0), 0x0A);
+  EXPECT_EQ(cpu.get_register(0xF), 0);
+}
+
+// BXNN adds V_x on CHIP-48 and SUPER-CHIP, V_0 everywhere else
+TEST(QuirksTest, JumpOffset) {
+  std::initializer_list<uint16_t> program = {0x6010, 0x6220, 0xB230};
+
+  auto schip = machine<BasicChip8<SuperChipQuirks>>(program);
+  schip.run(3);
+  EXPECT_EQ(schip.get_PC(), 0x250);
+
+  auto chip48 = machine<BasicChip8<Chip48Quirks>>(program);
+  chip48.run(3);
+  EXPECT_EQ(chip48.get_PC(), 0x250);
+
+  auto cpu = machine<Chip8>(program);
+  cpu.run(3);
+  EXPECT_EQ(cpu.get_PC(), 0x240);
+}
+
+// FX55 and FX65 leave I past the registers on the VIP and XO-CHIP
+TEST(QuirksTest, LoadStoreIncrementsI) {
+  std::initializer_list<uint16_t> program = {0xA300, 0xF255, 0xF165};
+
+  auto xo = machine<BasicChip8<XoChipQuirks>>(program);
+  xo.run(2);
+  EXPECT_EQ(xo.get_I(), 0x303);
+  xo.run(1);
+  EXPECT_EQ(xo.get_I(), 0x305);
+
+  auto cpu = machine<Chip8>(program);
+  cpu.run(3);
+  EXPECT_EQ(cpu.get_I(), 0x300);
+}
+
+// 8XY1 - 8XY3 clear V_F only on the VIP
+TEST(QuirksTest, LogicResetsVf) {
+  for (uint16_t logic : {0x8011, 0x8012, 0x8013}) {
+    std::initializer_list<uint16_t> program = {0x6F07, 0x6003, 0x6106, logic};
+
+    auto vip = machine<BasicChip8<CosmacVipQuirks>>(program);
+    vip.run(4);
+    EXPECT_EQ(vip.get_register(0xF), 0);
+
+    auto cpu = machine<Chip8>(program);
+    cpu.run(4);
+    EXPECT_EQ(cpu.get_register(0xF), 7);
+  }
+}
+
+// a sprite over the corner is cut off when clipping and wraps otherwise
+TEST(QuirksTest, SpriteClipping) {
+  // two full 8 pixel rows at x = 60, y = 31
+  std::initializer_list<uint16_t> program = {0x603C, 0x611F, 0xA208, 0xD012};
+  std::initializer_list<uint8_t> sprite = {0xFF, 0xFF};
+
+  auto schip = machine<BasicChip8<SuperChipQuirks>>(program, sprite);
+  schip.run(4);
+  EXPECT_EQ(schip.get_display_rows()[31], 0xFull);
+  EXPECT_EQ(schip.get_display_rows()[0], 0ull);
+
+  auto xo = machine<BasicChip8<XoChipQuirks>>(program, sprite);
+  xo.run(4);
+  EXPECT_EQ(xo.get_display_rows()[31], 0xF00000000000000Full);
+  EXPECT_EQ(xo.get_display_rows()[0], 0xF00000000000000Full);
+}
+
+// FX33 at the end of memory wraps to 0, except on CHIP-48 and SUPER-CHIP
+// where the bytes past it are dropped and read back as zeros
+TEST(QuirksTest, MemoryWraps) {
+  std::initializer_list<uint16_t> program = {0x6080, 0xAFFF, 0xF033, 0xF265};
+
+  auto schip = machine<BasicChip8<SuperChipQuirks>>(program);
+  schip.run(4);
+  EXPECT_EQ(schip.get_register(0), 1);
+  EXPECT_EQ(schip.get_register(1), 0);
+  EXPECT_EQ(schip.get_register(2), 0);
+  EXPECT_EQ(schip.snapshot().memory[0], 0xF0);
+
+  auto cpu = machine<Chip8>(program);
+  cpu.run(4);
+  EXPECT_EQ(cpu.get_register(1), 2);
+  EXPECT_EQ(cpu.get_register(2), 8);
+  EXPECT_EQ(cpu.snapshot().memory[0], 2);
+}
+
+// a store that wraps to 0 replaces the code there on every engine
+TEST(QuirksTest, WrappedWritesReachCode) {
+  std::initializer_list<uint16_t> program = {
+      0x6112, 0x6210, 0xAFFF, 0xF255, 0x1000, // 0x000 = jump to 0x210
+      0x0000, 0x0000, 0x0000,                 // padding up to 0x210
+      0x6216, 0xF255, 0x1000,                 // 0x000 = jump to 0x216
+      0x6301, 0x1218,
+  };
+
+  for (auto engine : {Chip8::Engine::INTERPRETER, Chip8::Engine::DECODE_CACHE,
+                      Chip8::Engine::RECOMPILER}) {
+    auto cpu = machine<Chip8>(program);
+    cpu.set_engine(engine);
+    cpu.run(20);
+    EXPECT_EQ(cpu.get_register(3), 1);
+    EXPECT_EQ(cpu.get_PC(), 0x218);
+  }
+}
+
+// every engine follows the quirks
+TEST(QuirksTest, EnginesAgree) {
+  std::initializer_list<uint16_t> program = {0x6005, 0x6181, 0x8016,
+                                             0xA300, 0xF155, 0x1200};
+
+  for (auto engine : {Chip8::Engine::INTERPRETER, Chip8::Engine::DECODE_CACHE,
+                      Chip8::Engine::RECOMPILER}) {
+    auto vip = machine<BasicChip8<CosmacVipQuirks>>(program);
+    vip.set_engine(engine);
+    vip.run(5);
+    EXPECT_EQ(vip.get_register(0), 0x40);
+    EXPECT_EQ(vip.get_I(), 0x302);
+  }
+}
@@ -0,0 +1,116 @@
+/// @file rewind_buffer_test.cpp
+/// @brief Tests for the RewindBuffer class
+/// @author Abhay Manoj
+/// @date Oct 14 2026
+
+#include "core/chip8.hpp"
+#include "core/rewind_buffer.hpp"
+#include <array>
+#include <cstdint>
+#include <cstring>
+#include <gtest/gtest.h>
+#include <vector>
+
+class RewindBufferTest : public ::testing::Test {
+protected:
+  Chip8 cpu;
+
+  /// @brief loads a program that counts V0 up and writes it to memory
+  void SetUp() override {
+    std::array<uint8_t, Chip8::MEMORY_SIZE> memory{};
+    const uint8_t program[] = {
+        0x70, 0x01, // V0 += 1
+        0xA3, 0x00, // I = 0x300
+        0xF0, 0x33, // bcd of V0 at I
+        0x12, 0x00, // jump to start
+    };
+    std::memcpy(memory.data() + Chip8::START, program, sizeof(program));
+    cpu.load_into_memory(memory);
+  }
+
+  /// @brief compares two snapshots byte for byte
+  static bool same(const Chip8::Snapshot &a, const Chip8::Snapshot &b) {
+    return std::memcmp(&a, &b, sizeof(a)) == 0;
+  }
+};
+
+// frames come back newest first, exactly as they were recorded
+TEST_F(RewindBufferTest, PopReturnsFramesInReverse) {
+  RewindBuffer rewind(1 << 20, 8);
+  std::vector<Chip8::Snapshot> recorded;
+
+  for (int i = 0; i < 20; i++) {
+    cpu.run_frames(1);
+    recorded.push_back(cpu.snapshot());
+    rewind.push(recorded.back());
+  }
+  ASSERT_EQ(rewind.size(), recorded.size());
+
+  Chip8::Snapshot snapshot;
+  for (size_t i = recorded.size(); i-- > 0;) {
+    ASSERT_TRUE(rewind.pop(snapshot));
+    EXPECT_TRUE(same(snapshot, recorded[i])) << "frame " << i;
+  }
+  EXPECT_FALSE(rewind.pop(snapshot));
+}
+
+// the oldest frames are dropped to stay within the budget
+TEST_F(RewindBufferTest, StaysWithinBudget) {
+  constexpr size_t BUDGET = 4 * sizeof(Chip8::Snapshot);
+  RewindBuffer rewind(BUDGET, 4);
+
+  for (int i = 0; i < 1000; i++) {
+    cpu.run_frames(1);
+    rewind.push(cpu.snapshot());
+    EXPECT_LE(rewind.get_bytes_used(), BUDGET);
+  }
+
+  Chip8::Snapshot snapshot;
+  ASSERT_TRUE(rewind.pop(snapshot));
+  EXPECT_TRUE(same(snapshot, cpu.snapshot()));
+}
+
+// a frame that barely changes costs far less than a full snapshot
+TEST_F(RewindBufferTest, DeltasAreSmall) {
+  RewindBuffer rewind(1 << 20);
+  rewind.push(cpu.snapshot());
+  size_t keyframe_bytes = rewind.get_bytes_used();
+
+  cpu.run_frames(1);
+  rewind.push(cpu.snapshot());
+  EXPECT_LT(rewind.get_bytes_used() - keyframe_bytes, 128);
+}
+
+// XO-CHIP snapshots, longer than a run can count, come back exactly, and a
+// snapshot of another profile starts the history over
+TEST_F(RewindBufferTest, RecordsOtherProfiles) {
+  using XoChip = BasicChip8<XoChipQuirks>;
+  std::array<uint8_t, XoChip::MEMORY_SIZE> memory{};
+  const uint8_t program[] = {
+      0x70, 0x01,             // V0 += 1
+      0xF0, 0x00, 0xFF, 0x00, // I = 0xFF00
+      0xF0, 0x33,             // bcd of V0 at I
+      0x12, 0x00,             // jump to start
+  };
+  std::memcpy(memory.data() + XoChip::START, program, sizeof(program));
+  XoChip xo(memory);
+
+  RewindBuffer rewind(1 << 20, 8);
+  rewind.push(cpu.snapshot());
+  std::vector<XoChip::Snapshot> recorded;
+  for (int i = 0; i < 10; i++) {
+    xo.run_frames(1);
+    recorded.push_back(xo.snapshot());
+    rewind.push(recorded.back());
+  }
+  EXPECT_EQ(rewind.size(), recorded.size());
+
+  Chip8::Snapshot other;
+  EXPECT_FALSE(rewind.pop(other));
+  XoChip::Snapshot snapshot;
+  for (size_t i = recorded.size(); i-- > 0;) {
+    ASSERT_TRUE(rewind.pop(snapshot));
+    EXPECT_EQ(std::memcmp(&snapshot, &recorded[i], sizeof(snapshot)), 0)
+        << "frame " << i;
+  }
+}
@@ -0,0 +1,181 @@
+/// @file rom_analysis_test.cpp
+/// @brief Tests for the static analysis of programs
+/// @author Abhay Manoj
+/// @date Oct 14 2026
+
+#include "core/chip8.hpp"
+#include "core/rom_analysis.hpp"
+#include <cstdint>
+#include <gtest/gtest.h>
+#include <initializer_list>
+#include <sstream>
+#include <vector>
+
+/// @brief builds a memory image with instructions from START onwards
+/// @param instructions the instructions to load
+/// @param data bytes placed after the instructions
+/// @return the image
+static std::shared_ptr<Chip8::MemoryImage>
+image(std::initializer_list<uint16_t> instructions,
+      std::initializer_list<uint8_t> data = {}) {
+  std::vector<uint8_t> program;
+  for (uint16_t instruction : instructions) {
+    program.push_back(instruction >> 8);
+    program.push_back(instruction & 0xFF);
+  }
+  program.insert(program.end(), data.begin(), data.end());
+  return Chip8::make_memory_image(program);
+}
+
+/// @brief analyzes an image as the default machine runs it
+/// @param memory the image
+/// @return the analysis
+static RomAnalysis analyze(const Chip8::MemoryImage &memory) {
+  return analyze_rom(memory, AnalysisQuirks::of<DefaultQuirks>());
+}
+
+// jumps, calls, returns and skips split the code into basic blocks
+TEST(RomAnalysisTest, BuildsControlFlowGraph) {
+  auto memory = image({
+      0x6000, // 200 V0 = 0
+      0x3001, // 202 skip if V0 == 1
+      0x120A, // 204 jump to 20A
+      0x2210, // 206 call 210
+      0x1208, // 208 halt
+      0x1206, // 20A jump to 206
+      0x0000, // 20C
+      0x0000, // 20E
+      0x00EE, // 210 return
+  });
+  RomAnalysis analysis = analyze(*memory);
+
+  struct Expected {
+    uint16_t start;
+    uint16_t end;
+    std::vector<uint16_t> successors;
+  };
+  std::vector<Expected> expected = {
+      {0x200, 0x204, {0x204, 0x206}}, {0x204, 0x206, {0x20A}},
+      {0x206, 0x208, {0x210}},        {0x208, 0x20A, {0x208}},
+      {0x20A, 0x20C, {0x206}},        {0x210, 0x212, {0x208}},
+  };
+  ASSERT_EQ(analysis.blocks.size(), expected.size());
+  for (size_t i = 0; i < expected.size(); i++) {
+    EXPECT_EQ(analysis.blocks[i].start, expected[i].start);
+    EXPECT_EQ(analysis.blocks[i].end, expected[i].end);
+    EXPECT_EQ(analysis.blocks[i].successors, expected[i].successors);
+  }
+  EXPECT_FALSE(analysis.is_instruction(0x20C));
+  EXPECT_TRUE(analysis.complete);
+}
+
+// a sprite after the code is read as data and never decoded
+TEST(RomAnalysisTest, SeparatesCodeAndData) {
+  auto memory = image({0xA206, 0xD013, 0x1204}, {0x12, 0x00, 0xFF});
+  RomAnalysis analysis = analyze(*memory);
+
+  for (uint16_t address = 0x200; address < 0x206; address++) {
+    EXPECT_TRUE(analysis.bytes[address] & RomAnalysis::CODE);
+  }
+  for (uint16_t address = 0x206; address < 0x209; address++) {
+    EXPECT_FALSE(analysis.bytes[address] & RomAnalysis::CODE);
+    EXPECT_TRUE(analysis.bytes[address] & RomAnalysis::READ);
+  }
+  EXPECT_FALSE(analysis.is_instruction(0x206)); // 1200 is never reached
+}
+
+// FX33 and FX55 through an I loaded just before write only the data
+TEST(RomAnalysisTest, ProvesDataWrites) {
+  auto memory = image({0x6005, 0xA300, 0xF033, 0xA310, 0xF255, 0x1202});
+  RomAnalysis analysis = analyze(*memory);
+
+  EXPECT_FALSE(analysis.modifies_itself());
+  EXPECT_TRUE(analysis.bytes[0x302] & RomAnalysis::WRITTEN);
+  EXPECT_FALSE(analysis.bytes[0x303] & RomAnalysis::WRITTEN);
+  EXPECT_TRUE(analysis.bytes[0x312] & RomAnalysis::WRITTEN);
+}
+
+// a write that can land on an instruction flags it
+TEST(RomAnalysisTest, FlagsSelfModifyingCode) {
+  auto memory = image({0x1206, 0xA206, 0xF155, 0x6305, 0x6063, 0x6109,
+                       0x1202});
+  RomAnalysis analysis = analyze(*memory);
+
+  EXPECT_TRUE(analysis.modifies_itself());
+  EXPECT_EQ(analysis.overwritten, std::vector<uint16_t>({0x206}));
+}
+
+// I moved by a register the analysis can't pin may reach anything
+TEST(RomAnalysisTest, UnknownOffsetsReachEverything) {
+  auto memory = image({0xC0FF, 0xA300, 0xF01E, 0xF033, 0x1206});
+  RomAnalysis analysis = analyze(*memory);
+
+  EXPECT_TRUE(analysis.bytes[0x3FF] & RomAnalysis::WRITTEN);
+  EXPECT_FALSE(analysis.bytes[0x2FF] & RomAnalysis::WRITTEN);
+  EXPECT_FALSE(analysis.modifies_itself());
+}
+
+// returns reach every call site, with the registers of the routine
+TEST(RomAnalysisTest, FollowsReturns) {
+  auto memory = image({0x220A, 0xF033, 0x1204, 0x0000, 0x0000, 0xA300,
+                       0x00EE});
+  RomAnalysis analysis = analyze(*memory);
+
+  EXPECT_TRUE(analysis.bytes[0x300] & RomAnalysis::WRITTEN);
+  EXPECT_FALSE(analysis.modifies_itself());
+}
+
+// a jump table through an unknown register leaves the graph incomplete,
+// and one through a known register is followed
+TEST(RomAnalysisTest, FollowsJumpTablesItCan) {
+  auto known = analyze(*image({0x6004, 0xB200, 0x0000, 0x1206}));
+  EXPECT_TRUE(known.complete);
+  EXPECT_TRUE(known.is_instruction(0x204));
+
+  auto unknown = analyze(*image({0xC003, 0xB200}));
+  EXPECT_FALSE(unknown.complete);
+  EXPECT_TRUE(unknown.modifies_itself());
+}
+
+// the listing decodes the code and lists the rest as bytes
+TEST(RomAnalysisTest, WritesListing) {
+  auto memory = image({0xA206, 0xD011, 0x1204}, {0xF0});
+  RomAnalysis analysis = analyze(*memory);
+
+  std::stringstream out;
+  ASSERT_TRUE(write_listing(out, *memory, analysis, InstructionSet::CHIP8,
+                            0x200, 0x207));
+  EXPECT_EQ(out.str(), "0200  A206       LD I, 0x206\n"
+                       "0202  D011       DRW V0, V1, 1\n"
+                       "\n"
+                       "0204  1204       JP 0x204\n"
+                       "0206             DB 0xF0\n");
+  EXPECT_EQ(disassemble(0xF000, InstructionSet::XO_CHIP, 0x1234),
+            "LD I, 0x1234");
+  EXPECT_EQ(disassemble(0x00FF, InstructionSet::CHIP8), "SYS 0x0FF");
+}
+
+// the cache and the recompiler start with the analyzed code translated and
+// skip invalidating for writes that are proven to miss it
+TEST(RomAnalysisTest, EnginesUseTheProof) {
+  for (auto engine : {Chip8::Engine::DECODE_CACHE, Chip8::Engine::RECOMPILER}) {
+    Chip8 cpu(image({0x6005, 0xA300, 0xF033, 0x7001, 0x1204}));
+    EXPECT_FALSE(cpu.is_code_static());
+    cpu.set_engine(engine);
+    EXPECT_TRUE(cpu.is_code_static());
+
+    Chip8::Snapshot start = cpu.snapshot();
+    cpu.run(100);
+    EXPECT_TRUE(cpu.is_code_static());
+    EXPECT_EQ(cpu.snapshot().memory[0x300], 0);
+    cpu.restore(start);
+    EXPECT_TRUE(cpu.is_code_static());
+
+    Chip8 modifying(image({0x1206, 0xA206, 0xF155, 0x6305, 0x6063, 0x6109,
+                           0x1202}));
+    modifying.set_engine(engine);
+    EXPECT_FALSE(modifying.is_code_static());
+    modifying.run(8);
+    EXPECT_EQ(modifying.get_register(3), 0x09);
+  }
+}
@@ -0,0 +1,132 @@
+/// @file rom_library_test.cpp
+/// @brief Tests for RomFile, profile detection and the RomLibrary index
+/// @author Abhay Manoj
+/// @date Oct 14 2026
+
+#include "core/chip8.hpp"
+#include "core/input_movie.hpp"
+#include "core/rom_file.hpp"
+#include "core/rom_library.hpp"
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <gtest/gtest.h>
+#include <sstream>
+#include <string>
+#include <vector>
+
+class RomLibraryTest : public ::testing::Test {
+protected:
+  std::filesystem::path directory;
+
+  /// @brief creates an empty directory for the test to write roms into
+  void SetUp() override {
+    directory = std::filesystem::temp_directory_path() /
+                ("chip8_rom_library_" +
+                 std::string(::testing::UnitTest::GetInstance()
+                                 ->current_test_info()
+                                 ->name()));
+    std::filesystem::remove_all(directory);
+    std::filesystem::create_directories(directory);
+  }
+
+  void TearDown() override { std::filesystem::remove_all(directory); }
+
+  /// @brief writes a file into the test directory
+  /// @param name the file name
+  /// @param bytes the contents
+  /// @return the path of the file
+  std::string write_file(const std::string &name,
+                         const std::vector<uint8_t> &bytes) {
+    std::filesystem::path path = directory / name;
+    std::ofstream file(path, std::ios::binary);
+    file.write(reinterpret_cast<const char *>(bytes.data()), bytes.size());
+    return path.string();
+  }
+};
+
+// a mapped rom holds exactly the bytes of the file
+TEST_F(RomLibraryTest, RomFileReadsBytes) {
+  std::string path = write_file("a.ch8", {0x12, 0x00, 0xAB});
+  RomFile rom;
+  ASSERT_TRUE(rom.open(path));
+  EXPECT_EQ(rom.get_bytes().size(), 3);
+  EXPECT_EQ(rom.get_bytes()[2], 0xAB);
+
+  RomFile moved = std::move(rom);
+  EXPECT_TRUE(rom.get_bytes().empty());
+  EXPECT_EQ(moved.get_bytes()[0], 0x12);
+}
+
+// missing, empty and oversized files are rejected before anything is read
+TEST_F(RomLibraryTest, RomFileRejectsBadSizes) {
+  RomFile rom;
+  EXPECT_FALSE(rom.open((directory / "missing.ch8").string()));
+  EXPECT_FALSE(rom.open(write_file("empty.ch8", {})));
+  EXPECT_FALSE(rom.open(
+      write_file("large.ch8", std::vector<uint8_t>(RomFile::MAX_SIZE + 1))));
+  EXPECT_TRUE(rom.open(
+      write_file("full.ch8", std::vector<uint8_t>(RomFile::MAX_SIZE))));
+}
+
+// the profile is the newest platform a reachable instruction belongs to,
+// bytes jumped over are data
+TEST_F(RomLibraryTest, DetectsProfile) {
+  const std::vector<uint8_t> chip8 = {0x60, 0x01, 0xD0, 0x15, 0x12, 0x00};
+  const std::vector<uint8_t> super_chip = {0x00, 0xFF, 0xD0, 0x10};
+  const std::vector<uint8_t> xo_chip = {0x00, 0xFF, 0xF0, 0x00, 0x12, 0x34};
+  const std::vector<uint8_t> data = {0x12, 0x04, 0x00, 0xFF, 0x12, 0x04};
+  EXPECT_EQ(detect_profile(chip8), RomProfile::CHIP8);
+  EXPECT_EQ(detect_profile(super_chip), RomProfile::SUPER_CHIP);
+  EXPECT_EQ(detect_profile(xo_chip), RomProfile::XO_CHIP);
+  EXPECT_EQ(detect_profile(data), RomProfile::CHIP8);
+}
+
+// a scan indexes the roms, and a scan from a saved index reads only the
+// files that changed
+TEST_F(RomLibraryTest, IndexSkipsUnchangedFiles) {
+  write_file("a.ch8", {0x12, 0x00});
+  write_file("b.ch8", {0x00, 0xFF, 0x12, 0x00});
+  write_file("notes.txt", {0x00});
+
+  RomLibrary library;
+  ASSERT_TRUE(library.scan(directory.string()));
+  ASSERT_EQ(library.get_entries().size(), 2);
+  EXPECT_EQ(library.get_files_read(), 2);
+
+  const RomEntry *b = library.find((directory / "b.ch8").string());
+  ASSERT_NE(b, nullptr);
+  EXPECT_EQ(b->size, 4);
+  EXPECT_EQ(b->profile, RomProfile::SUPER_CHIP);
+  const std::vector<uint8_t> b_bytes = {0x00, 0xFF, 0x12, 0x00};
+  EXPECT_EQ(b->hash, hash_rom(*Chip8::make_memory_image(b_bytes)));
+
+  std::stringstream index;
+  ASSERT_TRUE(library.write_index(index));
+  RomLibrary cached;
+  ASSERT_TRUE(cached.read_index(index));
+  EXPECT_EQ(cached.get_entries().size(), 2);
+
+  write_file("c.ch8", {0x13, 0x00});
+  ASSERT_TRUE(cached.scan(directory.string()));
+  EXPECT_EQ(cached.get_entries().size(), 3);
+  EXPECT_EQ(cached.get_files_read(), 1);
+}
+
+// a stream that is not an index is rejected
+TEST_F(RomLibraryTest, RejectsBadIndex) {
+  RomLibrary library;
+  std::stringstream stream("not an index");
+  EXPECT_FALSE(library.read_index(stream));
+  EXPECT_FALSE(library.scan((directory / "missing").string()));
+}
+
+// every bundled rom is plain CHIP-8
+TEST_F(RomLibraryTest, BundledRomsAreChip8) {
+  RomLibrary library;
+  ASSERT_TRUE(library.scan(CHIP8_ROM_DIR));
+  ASSERT_FALSE(library.get_entries().empty());
+  for (const RomEntry &entry : library.get_entries()) {
+    EXPECT_EQ(entry.profile, RomProfile::CHIP8) << entry.path;
+  }
+}
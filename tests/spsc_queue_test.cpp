@@ -0,0 +1,53 @@
+/// @file spsc_queue_test.cpp
+/// @brief Tests for the SpscQueue class
+/// @author Abhay Manoj
+/// @date Oct 14 2026
+
+#include "core/spsc_queue.hpp"
+#include <cstdint>
+#include <gtest/gtest.h>
+#include <thread>
+
+// values come out in order, a full queue refuses more
+TEST(SpscQueueTest, KeepsOrderAndCapacity) {
+  SpscQueue<int, 4> queue;
+  for (int i = 0; i < 4; i++) {
+    EXPECT_TRUE(queue.push(i));
+  }
+  EXPECT_FALSE(queue.push(4));
+
+  int value;
+  for (int i = 0; i < 4; i++) {
+    ASSERT_TRUE(queue.pop(value));
+    EXPECT_EQ(value, i);
+  }
+  EXPECT_FALSE(queue.pop(value));
+}
+
+// nothing is lost or reordered between two threads
+TEST(SpscQueueTest, PassesValuesBetweenThreads) {
+  constexpr uint32_t VALUES = 100000;
+  SpscQueue<uint32_t, 64> queue;
+
+  std::thread producer([&] {
+    for (uint32_t i = 0; i < VALUES;) {
+      if (queue.push(i)) {
+        i++;
+      } else {
+        std::this_thread::yield();
+      }
+    }
+  });
+
+  uint32_t expected = 0;
+  while (expected != VALUES) {
+    uint32_t value;
+    if (queue.pop(value)) {
+      ASSERT_EQ(value, expected);
+      expected++;
+    } else {
+      std::this_thread::yield();
+    }
+  }
+  producer.join();
+}
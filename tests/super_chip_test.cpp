@@ -0,0 +1,245 @@
+/// @file super_chip_test.cpp
+/// @brief Tests for the SUPER-CHIP and XO-CHIP instructions
+/// @author Abhay Manoj
+/// @date Oct 14 2026
+
+#include "core/chip8.hpp"
+#include <cstdint>
+#include <gtest/gtest.h>
+#include <initializer_list>
+#include <vector>
+
+using SuperChip8 = BasicChip8<SuperChipQuirks>;
+using XoChip8 = BasicChip8<XoChipQuirks>;
+
+/// @brief builds a machine with instructions from START onwards
+/// @tparam Machine the type of the machine
+/// @param instructions the instructions to load
+/// @param data bytes placed after the instructions
+/// @return the machine
+template <typename Machine>
+static Machine machine(std::initializer_list<uint16_t> instructions,
+                       std::initializer_list<uint8_t> data = {}) {
+  std::vector<uint8_t> program;
+  for (uint16_t instruction : instructions) {
+    program.push_back(instruction >> 8);
+    program.push_back(instruction & 0xFF);
+  }
+  program.insert(program.end(), data.begin(), data.end());
+  return Machine(Machine::make_memory_image(program));
+}
+
+// 00FF and 00FE switch the resolution, rows become two words in hi-res
+TEST(SuperChipTest, SwitchesResolution) {
+  auto cpu = machine<SuperChip8>({0x00FF, 0x00FE});
+
+  cpu.run(1);
+  EXPECT_EQ(cpu.get_display_width(), Chip8::HIRES_WIDTH);
+  EXPECT_EQ(cpu.get_display_height(), Chip8::HIRES_HEIGHT);
+  EXPECT_EQ(cpu.get_display_rows().size(), 128u);
+  EXPECT_EQ(cpu.get_display_buffer().size(), 128u * 64u);
+
+  cpu.run(1);
+  EXPECT_EQ(cpu.get_display_width(), Chip8::WIDTH);
+  EXPECT_EQ(cpu.get_display_height(), Chip8::HEIGHT);
+  EXPECT_EQ(cpu.get_display_rows().size(), 32u);
+}
+
+// the default profile still reads the SUPER-CHIP instructions as 0NNN
+TEST(SuperChipTest, DefaultProfileIgnoresExtensions) {
+  auto cpu = machine<Chip8>({0x00FF});
+  cpu.run(1);
+
+  EXPECT_EQ(cpu.get_PC(), 0x0FF);
+  EXPECT_EQ(cpu.get_display_width(), Chip8::WIDTH);
+}
+
+// a hi-res sprite past x = 63 lands in the second word of its row
+TEST(SuperChipTest, DrawsInHighResolution) {
+  auto cpu = machine<SuperChip8>({0x00FF, 0x6064, 0x613F, 0xA20C, 0xD011,
+                                  0x120A},
+                                 {0xFF});
+  cpu.run(5);
+
+  auto rows = cpu.get_display_rows();
+  EXPECT_EQ(rows[63 * 2], 0ull);
+  EXPECT_EQ(rows[63 * 2 + 1], 0xFFull << 20);
+  EXPECT_EQ(cpu.get_display_buffer()[63 * 128 + 100], 1);
+  EXPECT_EQ(cpu.get_dirty_rows().end, 64);
+}
+
+// DXY0 draws 16 x 16, here across the two words of each hi-res row
+TEST(SuperChipTest, DrawsLargeSprites) {
+  std::vector<uint8_t> sprite(32, 0xFF);
+  std::vector<uint8_t> program = {0x00, 0xFF, 0x60, 0x3C, 0x61, 0x00,
+                                  0xA2, 0x0C, 0xD0, 0x10, 0x12, 0x0A};
+  program.insert(program.end(), sprite.begin(), sprite.end());
+  SuperChip8 cpu(SuperChip8::make_memory_image(program));
+  cpu.run(5);
+
+  auto rows = cpu.get_display_rows();
+  for (int y = 0; y < 16; y++) {
+    EXPECT_EQ(rows[y * 2], 0xFull);
+    EXPECT_EQ(rows[y * 2 + 1], 0xFFF0000000000000ull);
+  }
+  EXPECT_EQ(rows[16 * 2 + 1], 0ull);
+  EXPECT_EQ(cpu.get_register(0xF), 0);
+}
+
+// 00FB and 00FC move pixels 4 at a time across the words of a row
+TEST(SuperChipTest, ScrollsSideways) {
+  auto cpu = machine<SuperChip8>({0x00FF, 0x603E, 0xA20E, 0xD011, 0x00FB,
+                                  0x00FC, 0x00FC},
+                                 {0xFF});
+  cpu.run(4);
+  auto rows = cpu.get_display_rows();
+  EXPECT_EQ(rows[0], 0x3ull);
+  EXPECT_EQ(rows[1], 0xFC00000000000000ull);
+
+  cpu.run(1);
+  rows = cpu.get_display_rows();
+  EXPECT_EQ(rows[0], 0ull);
+  EXPECT_EQ(rows[1], 0xFFull << 54);
+
+  cpu.run(2);
+  rows = cpu.get_display_rows();
+  EXPECT_EQ(rows[0], 0x3Full);
+  EXPECT_EQ(rows[1], 0xC000000000000000ull);
+}
+
+// 00CN moves rows down, by rows of the current resolution
+TEST(SuperChipTest, ScrollsDown) {
+  auto cpu = machine<SuperChip8>({0xA208, 0xD001, 0x00C3, 0x1206}, {0x80});
+  cpu.run(3);
+
+  auto rows = cpu.get_display_rows();
+  EXPECT_EQ(rows[0], 0ull);
+  EXPECT_EQ(rows[3], 0x8000000000000000ull);
+  EXPECT_EQ(cpu.get_dirty_rows().end, Chip8::HEIGHT);
+}
+
+// 00DN is XO-CHIP only and moves rows up
+TEST(SuperChipTest, ScrollsUp) {
+  auto cpu = machine<XoChip8>({0x6105, 0xA20A, 0xD011, 0x00D2, 0x1208},
+                              {0x80});
+  cpu.run(4);
+
+  auto rows = cpu.get_display_rows();
+  EXPECT_EQ(rows[5], 0ull);
+  EXPECT_EQ(rows[3], 0x8000000000000000ull);
+}
+
+// a mode switch clears the display
+TEST(SuperChipTest, ResolutionSwitchClears) {
+  auto cpu = machine<SuperChip8>({0xA206, 0xD001, 0x00FF}, {0x80});
+  cpu.run(3);
+
+  for (uint64_t row : cpu.get_display_rows()) {
+    EXPECT_EQ(row, 0ull);
+  }
+}
+
+// FX30 points I at the 10 byte digits
+TEST(SuperChipTest, LoadsLargeFont) {
+  auto cpu = machine<SuperChip8>({0x6007, 0xF030});
+  cpu.run(2);
+
+  EXPECT_EQ(cpu.get_I(), 0x50 + 7 * 10);
+  EXPECT_NE(cpu.snapshot().memory[0x50], 0);
+}
+
+// FX75 and FX85 keep registers across the program clearing them
+TEST(SuperChipTest, SavesFlags) {
+  auto cpu = machine<SuperChip8>({0x6011, 0x6122, 0x6233, 0xF275, 0x6000,
+                                  0x6100, 0x6200, 0xF185});
+  cpu.run(8);
+
+  EXPECT_EQ(cpu.get_register(0), 0x11);
+  EXPECT_EQ(cpu.get_register(1), 0x22);
+  EXPECT_EQ(cpu.get_register(2), 0);
+}
+
+// 00FD stops the program where it is
+TEST(SuperChipTest, Exits) {
+  auto cpu = machine<SuperChip8>({0x6001, 0x00FD, 0x6002});
+  cpu.run(10);
+
+  EXPECT_EQ(cpu.get_PC(), 0x202);
+  EXPECT_EQ(cpu.get_register(0), 1);
+}
+
+// F000 NNNN loads a 16 bit address and is skipped over as 4 bytes
+TEST(XoChipTest, LoadsLongAddresses) {
+  auto cpu = machine<XoChip8>({0xF000, 0x1234, 0x6000, 0x3000, 0xF000,
+                               0xABCD, 0x6105});
+  cpu.run(1);
+  EXPECT_EQ(cpu.get_I(), 0x1234);
+  EXPECT_EQ(cpu.get_PC(), 0x204);
+
+  cpu.run(2);
+  EXPECT_EQ(cpu.get_PC(), 0x20C);
+  cpu.run(1);
+  EXPECT_EQ(cpu.get_register(1), 5);
+  EXPECT_EQ(cpu.get_I(), 0x1234);
+}
+
+// XO-CHIP machines address 64 KB
+TEST(XoChipTest, Addresses64KB) {
+  auto cpu = machine<XoChip8>({0xF000, 0x8000, 0x6042, 0xF055});
+  cpu.run(3);
+
+  auto snapshot = cpu.snapshot();
+  EXPECT_EQ(snapshot.memory.size(), 0x10000u);
+  EXPECT_EQ(snapshot.memory[0x8000], 0x42);
+  EXPECT_EQ(cpu.get_I(), 0x8001);
+}
+
+// 5XY2 and 5XY3 copy a range of registers, in either order, leaving I
+TEST(XoChipTest, CopiesRegisterRanges) {
+  auto cpu = machine<XoChip8>({0x6011, 0x6122, 0x6233, 0xA300, 0x5202,
+                               0x6000, 0x6100, 0x5013});
+  cpu.run(5);
+  auto memory = cpu.snapshot().memory;
+  EXPECT_EQ(memory[0x300], 0x33);
+  EXPECT_EQ(memory[0x301], 0x22);
+  EXPECT_EQ(memory[0x302], 0x11);
+
+  cpu.run(3);
+  EXPECT_EQ(cpu.get_register(0), 0x33);
+  EXPECT_EQ(cpu.get_register(1), 0x22);
+  EXPECT_EQ(cpu.get_I(), 0x300);
+}
+
+// FN01 picks the planes DXYN draws to, reading one sprite per plane
+TEST(XoChipTest, DrawsToSelectedPlanes) {
+  auto cpu = machine<XoChip8>({0xF201, 0xA20C, 0xD001, 0xF301, 0xD001,
+                               0x120A},
+                              {0x80, 0xC0});
+  cpu.run(3);
+  EXPECT_EQ(cpu.get_display_rows(0)[0], 0ull);
+  EXPECT_EQ(cpu.get_display_rows(1)[0], 0x8000000000000000ull);
+
+  cpu.run(2);
+  EXPECT_EQ(cpu.get_display_rows(0)[0], 0x8000000000000000ull);
+  EXPECT_EQ(cpu.get_display_rows(1)[0], 0x4000000000000000ull);
+  EXPECT_EQ(cpu.get_register(0xF), 1);
+
+  auto buffer = cpu.get_display_buffer();
+  EXPECT_EQ(buffer[0], 1);
+  EXPECT_EQ(buffer[1], 2);
+}
+
+// the engines agree on a loop around a 4 byte instruction
+TEST(XoChipTest, EnginesAgree) {
+  for (auto engine : {Chip8::Engine::INTERPRETER, Chip8::Engine::DECODE_CACHE,
+                      Chip8::Engine::RECOMPILER}) {
+    auto cpu = machine<XoChip8>({0x6000, 0xF000, 0x0300, 0x7001, 0x300A,
+                                 0x1202, 0x120C});
+    cpu.set_engine(engine);
+    cpu.run(100);
+
+    EXPECT_EQ(cpu.get_register(0), 10);
+    EXPECT_EQ(cpu.get_I(), 0x300);
+    EXPECT_EQ(cpu.get_PC(), 0x20C);
+  }
+}
@@ -0,0 +1,113 @@
+/// @file tone_generator_test.cpp
+/// @brief Tests for the ToneGenerator class
+/// @author Abhay Manoj
+/// @date Oct 14 2026
+
+#include "core/chip8.hpp"
+#include "core/tone_generator.hpp"
+#include <array>
+#include <cstdint>
+#include <gtest/gtest.h>
+#include <vector>
+
+// a millisecond per sample and a 4 sample period keep the times readable
+static constexpr uint32_t SAMPLE_RATE = 1000;
+static constexpr uint32_t FREQUENCY = 250;
+static constexpr float VOLUME = 0.5f;
+static constexpr uint64_t MS = 1'000'000;
+
+// nothing plays until the buzzer turns on
+TEST(ToneGeneratorTest, StartsSilent) {
+  ToneGenerator tone(SAMPLE_RATE, FREQUENCY, VOLUME);
+  std::array<float, 16> samples;
+  samples.fill(1.0f);
+  tone.render(samples.data(), samples.size());
+
+  for (float sample : samples) {
+    EXPECT_EQ(sample, 0.0f);
+  }
+}
+
+// the tone covers exactly the samples between the edges
+TEST(ToneGeneratorTest, EdgesLandOnTheirSamples) {
+  ToneGenerator tone(SAMPLE_RATE, FREQUENCY, VOLUME);
+  tone.set_latency(10 * MS);
+  tone.set_machine_time(10 * MS);
+  tone.set_buzzer(3 * MS, true);
+  tone.set_buzzer(6 * MS, false);
+
+  std::array<float, 10> samples;
+  tone.render(samples.data(), samples.size());
+  const std::array<float, 10> expected = {0, 0, 0, -VOLUME, VOLUME, VOLUME,
+                                          0, 0, 0, 0};
+  EXPECT_EQ(samples, expected);
+}
+
+// the phase carries on from one render to the next
+TEST(ToneGeneratorTest, PhaseIsContinuous) {
+  ToneGenerator split(SAMPLE_RATE, FREQUENCY, VOLUME);
+  ToneGenerator whole(SAMPLE_RATE, FREQUENCY, VOLUME);
+  for (ToneGenerator *tone : {&split, &whole}) {
+    tone->set_machine_time(20 * MS);
+    tone->set_buzzer(0, true);
+  }
+
+  std::array<float, 6> first, all;
+  split.render(first.data(), 3);
+  split.render(first.data() + 3, 3);
+  whole.render(all.data(), all.size());
+  EXPECT_EQ(first, all);
+
+  EXPECT_EQ(all[0], VOLUME);
+  EXPECT_EQ(all[2], -VOLUME);
+  EXPECT_EQ(all[4], VOLUME);
+}
+
+// a machine far ahead pulls the audio up to the latency, older edges apply
+// at once
+TEST(ToneGeneratorTest, LatencyIsBounded) {
+  ToneGenerator tone(SAMPLE_RATE, FREQUENCY, VOLUME);
+  tone.set_latency(10 * MS);
+  tone.set_buzzer(500 * MS, true);
+  tone.set_buzzer(900 * MS, false);
+  tone.set_buzzer(995 * MS, true);
+  tone.set_machine_time(1000 * MS);
+
+  std::array<float, 10> samples;
+  tone.render(samples.data(), samples.size());
+  for (int i = 0; i < 5; i++) {
+    EXPECT_EQ(samples[i], 0.0f);
+  }
+  for (int i = 5; i < 10; i++) {
+    EXPECT_NE(samples[i], 0.0f);
+  }
+}
+
+// FX18 and the timer ticks are timed to the instruction on every engine
+TEST(ToneGeneratorTest, MachineTimesBuzzerEdges) {
+  const std::vector<uint8_t> program = {
+      0x60, 0x05, // V0 = 5, runs at 1/600 s
+      0xF0, 0x18, // ST = V0, runs at 2/600 s
+      0x12, 0x04, // halt
+  };
+
+  for (auto engine : {Chip8::Engine::INTERPRETER, Chip8::Engine::DECODE_CACHE,
+                      Chip8::Engine::RECOMPILER}) {
+    Chip8 cpu(Chip8::make_memory_image(program));
+    cpu.set_engine(engine);
+    ToneGenerator tone(SAMPLE_RATE, FREQUENCY, VOLUME);
+    tone.set_latency(1000 * MS);
+    cpu.set_tone_generator(&tone);
+
+    // ST reaches 0 on the fifth tick, at 5/60 s
+    cpu.run_frames(6);
+    tone.set_machine_time(cpu.get_emulated_time().count());
+    std::array<float, 100> samples;
+    tone.render(samples.data(), samples.size());
+
+    for (int i = 0; i < 100; i++) {
+      bool on = i >= 4 && i <= 83; // 3.33 ms to 83.33 ms
+      EXPECT_EQ(samples[i] != 0.0f, on) << "sample " << i;
+    }
+  }
+}
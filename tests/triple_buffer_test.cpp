@@ -0,0 +1,54 @@
+/// @file triple_buffer_test.cpp
+/// @brief Tests for the TripleBuffer class
+/// @author Abhay Manoj
+/// @date Oct 14 2026
+
+#include "core/triple_buffer.hpp"
+#include <array>
+#include <cstdint>
+#include <gtest/gtest.h>
+#include <thread>
+
+// the reader only sees a copy once it is published, and then the newest one
+TEST(TripleBufferTest, ReaderGetsNewestFrame) {
+  TripleBuffer<int> buffer;
+  EXPECT_FALSE(buffer.update());
+
+  buffer.get_back() = 1;
+  buffer.publish();
+  buffer.get_back() = 2;
+  buffer.publish();
+  EXPECT_TRUE(buffer.update());
+  EXPECT_EQ(buffer.get_front(), 2);
+  EXPECT_FALSE(buffer.update());
+  EXPECT_EQ(buffer.get_front(), 2);
+}
+
+// a frame is never torn while the writer runs ahead of the reader
+TEST(TripleBufferTest, FramesArriveWhole) {
+  using Frame = std::array<uint64_t, 64>;
+  constexpr uint64_t FRAMES = 20000;
+  TripleBuffer<Frame> buffer;
+
+  std::thread writer([&] {
+    for (uint64_t i = 1; i <= FRAMES; i++) {
+      buffer.get_back().fill(i);
+      buffer.publish();
+    }
+  });
+
+  uint64_t last = 0;
+  while (last != FRAMES) {
+    if (!buffer.update()) {
+      std::this_thread::yield();
+      continue;
+    }
+    const Frame &frame = buffer.get_front();
+    for (uint64_t word : frame) {
+      ASSERT_EQ(word, frame[0]);
+    }
+    ASSERT_GT(frame[0], last);
+    last = frame[0];
+  }
+  writer.join();
+}
@@ -15,16 +15,101 @@ var Module = {
     if (text) console.log("Emscripten: " + text);
   },
   preRun: [function() {
+    // an upload from a build without the load bridge, see chip8.loadRom
     if (romToLoad === "upload.ch8") {
       const data = sessionStorage.getItem('custom_rom_bytes');
       if (data) {
         const bytes = new Uint8Array(JSON.parse(data));
         FS.writeFile('upload.ch8', bytes);
       }
+      return;
     }
+
+    // ROMs are not embedded in the build, only the one being run is fetched
+    // and main() waits for it
+    addRunDependency('rom');
+    fetch(romToLoad)
+      .then((response) => {
+        if (!response.ok) throw new Error(`${response.status} ${romToLoad}`);
+        return response.arrayBuffer();
+      })
+      .then((buffer) => {
+        const slash = romToLoad.lastIndexOf('/');
+        if (slash > 0) {
+          FS.mkdirTree(romToLoad.slice(0, slash));
+        }
+        FS.writeFile(romToLoad, new Uint8Array(buffer));
+      })
+      .catch((error) => console.error("Could not fetch ROM: " + error))
+      .finally(() => removeRunDependency('rom'));
   }]
 };
 
+/** True once the module is running and exports the named bridge. */
+function exported(name) {
+  return typeof Module[name] === 'function';
+}
+
+/**
+ * Views into the running machine, built over wasm memory on every call since
+ * memory growth replaces the buffer. Nothing is copied until a save state is
+ * taken. Each returns null or false on a build without the bridge.
+ */
+const chip8 = {
+  /** The packed display rows of a plane, one or two 64 bit words per row. */
+  display(plane = 0) {
+    if (!exported('_chip8_display_rows')) return null;
+    const pointer = Module._chip8_display_rows(plane);
+    const words = Module._chip8_display_width() / 64 *
+                  Module._chip8_display_height();
+    return pointer ? new BigUint64Array(HEAPU8.buffer, pointer, words) : null;
+  },
+
+  /** V0 - VF. */
+  registers() {
+    if (!exported('_chip8_registers')) return null;
+    const pointer = Module._chip8_registers();
+    return pointer ? new Uint8Array(HEAPU8.buffer, pointer, 16) : null;
+  },
+
+  /** A copy of the whole machine state. */
+  saveState() {
+    if (!exported('_chip8_snapshot')) return null;
+    const pointer = Module._chip8_snapshot();
+    const size = Module._chip8_snapshot_size();
+    return pointer ? HEAPU8.slice(pointer, pointer + size) : null;
+  },
+
+  /** Restores a state from saveState. */
+  loadState(state) {
+    if (!exported('_chip8_restore_snapshot')) return false;
+    const pointer = Module._chip8_snapshot();
+    if (!pointer || state.length !== Module._chip8_snapshot_size()) {
+      return false;
+    }
+    HEAPU8.set(state, pointer);
+    return Module._chip8_restore_snapshot();
+  },
+
+  /**
+   * Starts a ROM from its bytes, without reloading the page. A build without
+   * the bridge gets the ROM through session storage and a reload instead.
+   */
+  loadRom(bytes) {
+    if (!exported('_chip8_rom_buffer')) {
+      sessionStorage.setItem('custom_rom_bytes', JSON.stringify(Array.from(bytes)));
+      window.location.href = `?rom=upload.ch8`;
+      return true;
+    }
+    const pointer = Module._chip8_rom_buffer(bytes.length);
+    if (!pointer) {
+      return false;
+    }
+    HEAPU8.set(bytes, pointer);
+    return Module._chip8_load_rom();
+  }
+};
+
 document.addEventListener('DOMContentLoaded', () => {
   const romSelector = document.getElementById('rom-selector');
   const resetBtn = document.getElementById('btn-reset');
@@ -38,24 +123,28 @@ document.addEventListener('DOMContentLoaded', () => {
     window.location.href = `?rom=${encodeURIComponent(e.target.value)}`;
   });
 
+  let uploadedRom = null; // restarted by reset instead of the page's ROM
+
   resetBtn?.addEventListener('click', () => {
-    if (romToLoad === "upload.ch8") {
-      window.location.href = window.location.pathname;
+    if (uploadedRom) {
+      chip8.loadRom(uploadedRom);
     } else {
       window.location.reload();
     }
   });
 
-  fileInput?.addEventListener('change', function() {
+  fileInput?.addEventListener('change', async function() {
     const file = this.files[0];
     if (!file) return;
-    const reader = new FileReader();
-    reader.onload = function() {
-      const bytes = Array.from(new Uint8Array(reader.result));
-      sessionStorage.setItem('custom_rom_bytes', JSON.stringify(bytes));
-      window.location.href = `?rom=upload.ch8`;
-    };
-    reader.readAsArrayBuffer(file);
+    const bytes = new Uint8Array(await file.arrayBuffer());
+    if (!chip8.loadRom(bytes)) {
+      console.error("Could not load " + file.name);
+      return;
+    }
+    uploadedRom = bytes;
+    if (panel) panel.style.display = '';
+    descEl.innerHTML = "<strong>CUSTOM ROM LOADED</strong>";
+    keyEl.innerHTML = formatKeyHints("Layout: [1][2][3][4] | [Q][W][E][R] | [A][S][D][F] | [Z][X][C][V]");
   });
 
   colorPicker?.addEventListener('input', (e) => {
@@ -100,10 +189,7 @@ document.addEventListener('DOMContentLoaded', () => {
     return text.replace(/\[(.*?)\]/g, '<span class="key-cap">[$1]</span>');
   };
 
-  if (romToLoad === "upload.ch8") {
-    descEl.innerHTML = "<strong>CUSTOM ROM LOADED</strong>";
-    keyEl.innerHTML = formatKeyHints("Layout: [1][2][3][4] | [Q][W][E][R] | [A][S][D][F] | [Z][X][C][V]");
-  } else if (romInstructions[romToLoad]) {
+  if (romInstructions[romToLoad]) {
     descEl.innerHTML = `<strong>GAME:</strong> ${romInstructions[romToLoad].desc}`;
     keyEl.innerHTML = formatKeyHints(romInstructions[romInstructions[romToLoad] ? romToLoad : ""].keys);
   } else {